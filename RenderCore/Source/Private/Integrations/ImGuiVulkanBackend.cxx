@@ -11,6 +11,7 @@ module;
 #include <array>
 #include <cstdint>
 #include <imgui.h>
+#include <mutex>
 #include <vector>
 #include <vma/vk_mem_alloc.h>
 
@@ -747,7 +748,7 @@ void ImGuiVulkanCreatePipeline()
             .RasterizationState = RasterInfo,
             .ColorBlendAttachment = ColorAttachment,
             .MultisampleState = MsInfo,
-            .VertexBinding = VertexBindingDescription,
+            .VertexBindings = { VertexBindingDescription },
             .VertexAttributes = {
                     VkVertexInputAttributeDescription
                     {
@@ -932,7 +933,11 @@ void ImGuiVulkanRenderWindow(ImGuiViewport *Viewport, void *)
             .pSignalSemaphoreInfos = &SignalSemaphoreInfo
     };
 
-    CheckVulkanResult(vkQueueSubmit2(Queue, 1U, &SubmitInfo, Fence));
+    {
+        std::lock_guard Lock { GetGraphicsQueueMutex() };
+        CheckVulkanResult(vkQueueSubmit2(Queue, 1U, &SubmitInfo, Fence));
+    }
+
     PendingWait = true;
 }
 
@@ -955,8 +960,13 @@ void ImGuiVulkanSwapBuffers(ImGuiViewport *Viewport, void *)
             .pImageIndices = &FrameIndex
     };
 
-    if (VkResult const Result = vkQueuePresentKHR(Queue, &PresentInfo);
-        Result == VK_ERROR_OUT_OF_DATE_KHR || Result == VK_SUBOPTIMAL_KHR)
+    VkResult Result;
+    {
+        std::lock_guard Lock { GetGraphicsQueueMutex() };
+        Result = vkQueuePresentKHR(Queue, &PresentInfo);
+    }
+
+    if (Result == VK_ERROR_OUT_OF_DATE_KHR || Result == VK_SUBOPTIMAL_KHR)
     {
         ImGuiVulkanCreateOrResizeWindow(ViewportData->Window,
                                         static_cast<std::int32_t>(Viewport->Size.x),
@@ -1249,7 +1259,10 @@ void RenderCore::ImGuiVulkanDestroyFrame(ImGuiVulkanFrame &FrameData)
 void RenderCore::ImGuiVulkanDestroyFrameSemaphores(ImGuiVulkanFrameSemaphores &FrameSemaphore)
 {
     auto const &[QueueFamilyIndex, Queue] = GetGraphicsQueue();
-    CheckVulkanResult(vkQueueWaitIdle(Queue));
+    {
+        std::lock_guard Lock { GetGraphicsQueueMutex() };
+        CheckVulkanResult(vkQueueWaitIdle(Queue));
+    }
 
     VkDevice const &LogicalDevice = GetLogicalDevice();
 
@@ -1436,9 +1449,8 @@ bool RenderCore::ImGuiVulkanCreateFontsTexture()
     ImGuiIO const &  ImGuiIO = ImGui::GetIO();
     ImGuiVulkanData *Backend = ImGuiVulkanGetBackendData();
 
-    constexpr VkFormat  ImageFormat               = VK_FORMAT_R8G8B8A8_UNORM;
-    VmaAllocator const &Allocator                 = GetAllocator();
-    auto const &        [QueueFamilyIndex, Queue] = GetGraphicsQueue();
+    constexpr VkFormat ImageFormat      = VK_FORMAT_R8G8B8A8_UNORM;
+    std::uint8_t const QueueFamilyIndex = GetGraphicsQueue().first;
 
     if (Backend->FontImage.IsValid() || Backend->FontDescriptorSet)
     {
@@ -1456,15 +1468,9 @@ bool RenderCore::ImGuiVulkanCreateFontsTexture()
 
     InitializeSingleCommandQueue(CommandPool, CommandBuffers, QueueFamilyIndex);
 
-    std::pair<VkBuffer, VmaAllocation> StagingAllocation;
-    VmaAllocationInfo                  StagingInfo = CreateBuffer(BufferSize,
-                                                                  VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                                                                  "STAGING_TEXTURE",
-                                                                  StagingAllocation.first,
-                                                                  StagingAllocation.second);
-
-    CheckVulkanResult(vmaMapMemory(Allocator, StagingAllocation.second, &StagingInfo.pMappedData));
-    std::memcpy(StagingInfo.pMappedData, ImageData, BufferSize);
+    StagingRegion const Staging = AcquireStagingRegion(BufferSize);
+    std::memcpy(Staging.MappedData, ImageData, BufferSize);
+    FlushStagingRegion(Staging);
 
     ImageAllocation NewAllocation {
             .Extent = { .width = static_cast<std::uint32_t>(ImageWidth), .height = static_cast<std::uint32_t>(ImageHeight) },
@@ -1484,18 +1490,15 @@ bool RenderCore::ImGuiVulkanCreateFontsTexture()
         NewAllocation.Image,
         NewAllocation.Format);
 
-    CopyBufferToImage(CommandBuffers.back(), StagingAllocation.first, NewAllocation.Image, NewAllocation.Extent);
+    CopyBufferToImage(CommandBuffers.back(), Staging.Buffer, NewAllocation.Image, NewAllocation.Extent, Staging.Offset);
 
     RequestImageLayoutTransition<VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL, g_ImageAspect>(CommandBuffers.back(),
         NewAllocation.Image,
         NewAllocation.Format);
 
     CreateImageView(NewAllocation.Image, NewAllocation.Format, g_ImageAspect, NewAllocation.View);
-    vmaUnmapMemory(Allocator, StagingAllocation.second);
-
-    FinishSingleCommandQueue(Queue, CommandPool, CommandBuffers);
 
-    vmaDestroyBuffer(Allocator, StagingAllocation.first, StagingAllocation.second);
+    ReleaseStagingRegion(Staging, SubmitSingleCommandQueue(CommandPool, CommandBuffers));
 
     Backend->FontImage = std::move(NewAllocation);
 
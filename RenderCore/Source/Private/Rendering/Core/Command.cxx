@@ -8,6 +8,7 @@ module;
 #include <algorithm>
 #include <chrono>
 #include <functional>
+#include <mutex>
 #include <ranges>
 #include <thread>
 #include <unordered_map>
@@ -97,11 +98,34 @@ struct CommandResources
     VkCommandBuffer                                   PrimaryCommandBuffer { VK_NULL_HANDLE };
 };
 
+// Upload work in flight, its pool is destroyed once the GPU has passed the ticket of the submission
+struct PendingSubmission
+{
+    UploadTicket                 Ticket {};
+    VkCommandPool                CommandPool { VK_NULL_HANDLE };
+    std::vector<VkCommandBuffer> CommandBuffers {};
+};
+
+// Ownership acquisitions recorded by the first frame that starts after the transfer completed
+struct TransferAcquire
+{
+    UploadTicket                       Ticket {};
+    std::vector<VkImageMemoryBarrier2> Barriers {};
+};
+
 std::uint32_t                              g_ObjectsPerThread { 0U };
 std::uint32_t                              g_NumThreads { 0U };
 ThreadPool::Pool                           g_ThreadPool {};
 std::array<CommandResources, g_ImageCount> g_CommandResources {};
 
+std::uint64_t                           g_GraphicsTimelineValue { 0U };
+std::uint64_t                           g_TransferTimelineValue { 0U };
+std::vector<PendingSubmission>          g_PendingSubmissions {};
+std::mutex                              g_PendingSubmissionsMutex {};
+std::vector<TransferAcquire>            g_TransferAcquires {};
+std::mutex                              g_TransferAcquiresMutex {};
+std::array<std::uint64_t, g_ImageCount> g_TransferWaitValues {};
+
 void RenderCore::SetNumObjectsPerThread(std::uint32_t const NumObjects)
 {
     if (NumObjects > 0U)
@@ -193,6 +217,28 @@ void RenderCore::ReleaseCommandsResources()
         PrimaryCommandPool   = VK_NULL_HANDLE;
         PrimaryCommandBuffer = VK_NULL_HANDLE;
     }
+
+    // The device is already idle at this point, so every upload submission has completed
+    {
+        std::lock_guard Lock { g_PendingSubmissionsMutex };
+
+        for (auto const &[Ticket, CommandPool, CommandBuffers] : g_PendingSubmissions)
+        {
+            vkFreeCommandBuffers(LogicalDevice, CommandPool, static_cast<std::uint32_t>(std::size(CommandBuffers)), std::data(CommandBuffers));
+            vkDestroyCommandPool(LogicalDevice, CommandPool, nullptr);
+        }
+
+        g_PendingSubmissions.clear();
+    }
+
+    {
+        std::lock_guard Lock { g_TransferAcquiresMutex };
+        g_TransferAcquires.clear();
+    }
+
+    g_TransferWaitValues.fill(0U);
+    g_GraphicsTimelineValue = 0U;
+    g_TransferTimelineValue = 0U;
 }
 
 VkCommandPool RenderCore::CreateCommandPool(std::uint8_t const FamilyQueueIndex, VkCommandPoolCreateFlags const Flags)
@@ -334,7 +380,8 @@ std::vector<VkCommandBuffer> RecordSceneCommands(std::uint32_t const    ImageInd
         return {};
     }
 
-    VkPipeline const &      Pipeline       = GetMainPipeline();
+    // Meshlet culling replaces the vertex pipeline whenever the device could build it
+    VkPipeline const &      Pipeline       = GetMeshPipeline() != VK_NULL_HANDLE ? GetMeshPipeline() : GetMainPipeline();
     VkPipelineLayout const &PipelineLayout = GetPipelineLayout();
     Camera const &          Camera         = GetCamera();
 
@@ -372,7 +419,7 @@ std::vector<VkCommandBuffer> RecordSceneCommands(std::uint32_t const    ImageInd
                                              Camera.CanDrawObject(Object))
                                          {
                                              Object->UpdateUniformBuffers();
-                                             Object->DrawObject(CommandBuffer, PipelineLayout, ObjectAccessIndex);
+                                             Object->DrawObject(CommandBuffer, PipelineLayout, Camera.SelectLOD(Object));
                                          }
                                      }
                                  }
@@ -388,6 +435,44 @@ std::vector<VkCommandBuffer> RecordSceneCommands(std::uint32_t const    ImageInd
     return Output;
 }
 
+// Only completed transfers are acquired, so the frame never waits on uploads still running on the transfer queue
+void RecordTransferAcquires(std::uint32_t const ImageIndex, VkCommandBuffer const &CommandBuffer)
+{
+    std::uint64_t &WaitValue = g_TransferWaitValues.at(ImageIndex);
+    WaitValue                = 0U;
+
+    std::vector<VkImageMemoryBarrier2> Barriers {};
+    {
+        std::lock_guard Lock { g_TransferAcquiresMutex };
+
+        std::erase_if(g_TransferAcquires,
+                      [&](TransferAcquire const &AcquireIter)
+                      {
+                          if (!IsUploadComplete(AcquireIter.Ticket))
+                          {
+                              return false;
+                          }
+
+                          WaitValue = std::max(WaitValue, AcquireIter.Ticket.Value);
+                          Barriers.insert(std::end(Barriers), std::begin(AcquireIter.Barriers), std::end(AcquireIter.Barriers));
+                          return true;
+                      });
+    }
+
+    if (std::empty(Barriers))
+    {
+        return;
+    }
+
+    VkDependencyInfo const DependencyInfo {
+            .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+            .imageMemoryBarrierCount = static_cast<std::uint32_t>(std::size(Barriers)),
+            .pImageMemoryBarriers = std::data(Barriers)
+    };
+
+    vkCmdPipelineBarrier2(CommandBuffer, &DependencyInfo);
+}
+
 void RenderCore::RecordCommandBuffers(std::uint32_t const ImageIndex)
 {
     ImageAllocation const &SwapchainAllocation = GetSwapChainImages().at(ImageIndex);
@@ -397,6 +482,8 @@ void RenderCore::RecordCommandBuffers(std::uint32_t const ImageIndex)
     VkCommandBuffer const &CommandBuffer = g_CommandResources.at(ImageIndex).PrimaryCommandBuffer;
     CheckVulkanResult(vkBeginCommandBuffer(CommandBuffer, &g_CommandBufferBeginInfo));
 
+    RecordTransferAcquires(ImageIndex, CommandBuffer);
+
     BeginRendering(CommandBuffer, SwapchainAllocation, DepthAllocation, OffscreenAllocation);
 
     if (std::vector<VkCommandBuffer> const CommandBuffers = RecordSceneCommands(ImageIndex, SwapchainAllocation, DepthAllocation);
@@ -411,11 +498,19 @@ void RenderCore::RecordCommandBuffers(std::uint32_t const ImageIndex)
 
 void RenderCore::SubmitCommandBuffers(std::uint32_t const ImageIndex)
 {
-    VkSemaphoreSubmitInfo const WaitSemaphoreInfo {
-            .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
-            .semaphore = GetImageAvailableSemaphore(ImageIndex),
-            .value = 1U,
-            .stageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT
+    std::array const WaitSemaphoreInfos {
+            VkSemaphoreSubmitInfo {
+                    .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+                    .semaphore = GetImageAvailableSemaphore(ImageIndex),
+                    .value = 1U,
+                    .stageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT
+            },
+            VkSemaphoreSubmitInfo {
+                    .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+                    .semaphore = GetTransferTimelineSemaphore(),
+                    .value = g_TransferWaitValues.at(ImageIndex),
+                    .stageMask = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT
+            }
     };
 
     VkSemaphoreSubmitInfo const SignalSemaphoreInfo {
@@ -430,15 +525,17 @@ void RenderCore::SubmitCommandBuffers(std::uint32_t const ImageIndex)
 
     VkSubmitInfo2 const SubmitInfo {
             .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
-            .waitSemaphoreInfoCount = 1U,
-            .pWaitSemaphoreInfos = &WaitSemaphoreInfo,
+            .waitSemaphoreInfoCount = g_TransferWaitValues.at(ImageIndex) > 0U ? 2U : 1U,
+            .pWaitSemaphoreInfos = std::data(WaitSemaphoreInfos),
             .commandBufferInfoCount = 1U,
             .pCommandBufferInfos = &PrimarySubmission,
             .signalSemaphoreInfoCount = 1U,
             .pSignalSemaphoreInfos = &SignalSemaphoreInfo
     };
 
-    auto const &Queue = GetGraphicsQueue().second;
+    auto const &    Queue = GetGraphicsQueue().second;
+    std::lock_guard Lock { GetGraphicsQueueMutex() };
+
     CheckVulkanResult(vkQueueSubmit2(Queue, 1U, &SubmitInfo, GetFence(ImageIndex)));
     SetFenceWaitStatus(ImageIndex, true);
 }
@@ -470,13 +567,38 @@ void RenderCore::InitializeSingleCommandQueue(VkCommandPool &               Comm
     }
 }
 
-void RenderCore::FinishSingleCommandQueue(VkQueue const &Queue, VkCommandPool const &CommandPool, std::vector<VkCommandBuffer> const &CommandBuffers)
+void ReclaimPendingSubmissions()
 {
-    if (std::empty(CommandBuffers) || CommandPool == VK_NULL_HANDLE)
-    {
-        return;
-    }
+    VkDevice const &LogicalDevice = GetLogicalDevice();
+
+    std::lock_guard Lock { g_PendingSubmissionsMutex };
+
+    std::erase_if(g_PendingSubmissions,
+                  [&LogicalDevice](PendingSubmission const &SubmissionIter)
+                  {
+                      if (!IsUploadComplete(SubmissionIter.Ticket))
+                      {
+                          return false;
+                      }
 
+                      vkFreeCommandBuffers(LogicalDevice,
+                                           SubmissionIter.CommandPool,
+                                           static_cast<std::uint32_t>(std::size(SubmissionIter.CommandBuffers)),
+                                           std::data(SubmissionIter.CommandBuffers));
+
+                      vkDestroyCommandPool(LogicalDevice, SubmissionIter.CommandPool, nullptr);
+                      return true;
+                  });
+}
+
+// Each queue signals its own timeline, the value is taken under the queue lock so the signals stay in submission order
+UploadTicket SubmitUploadCommands(VkQueue const &                     Queue,
+                                  std::mutex &                        QueueMutex,
+                                  VkSemaphore const &                 Timeline,
+                                  std::uint64_t &                     TimelineValue,
+                                  VkCommandPool const &               CommandPool,
+                                  std::vector<VkCommandBuffer> const &CommandBuffers)
+{
     std::vector<VkCommandBufferSubmitInfo> CommandBufferInfos;
     CommandBufferInfos.reserve(std::size(CommandBuffers));
 
@@ -491,17 +613,145 @@ void RenderCore::FinishSingleCommandQueue(VkQueue const &Queue, VkCommandPool co
                                      });
     }
 
-    VkSubmitInfo2 const SubmitInfo {
-            .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
-            .commandBufferInfoCount = static_cast<std::uint32_t>(std::size(CommandBufferInfos)),
-            .pCommandBufferInfos = std::data(CommandBufferInfos)
+    UploadTicket Output { .Semaphore = Timeline };
+    {
+        std::lock_guard Lock { QueueMutex };
+        Output.Value = ++TimelineValue;
+
+        VkSemaphoreSubmitInfo const SignalSemaphoreInfo {
+                .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+                .semaphore = Timeline,
+                .value = Output.Value,
+                .stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT
+        };
+
+        VkSubmitInfo2 const SubmitInfo {
+                .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
+                .commandBufferInfoCount = static_cast<std::uint32_t>(std::size(CommandBufferInfos)),
+                .pCommandBufferInfos = std::data(CommandBufferInfos),
+                .signalSemaphoreInfoCount = 1U,
+                .pSignalSemaphoreInfos = &SignalSemaphoreInfo
+        };
+
+        CheckVulkanResult(vkQueueSubmit2(Queue, 1U, &SubmitInfo, VK_NULL_HANDLE));
+    }
+
+    ReclaimPendingSubmissions();
+
+    std::lock_guard Lock { g_PendingSubmissionsMutex };
+    g_PendingSubmissions.push_back({ .Ticket = Output, .CommandPool = CommandPool, .CommandBuffers = CommandBuffers });
+
+    return Output;
+}
+
+UploadTicket RenderCore::SubmitSingleCommandQueue(VkCommandPool const &CommandPool, std::vector<VkCommandBuffer> const &CommandBuffers)
+{
+    if (std::empty(CommandBuffers) || CommandPool == VK_NULL_HANDLE)
+    {
+        return {};
+    }
+
+    return SubmitUploadCommands(GetGraphicsQueue().second,
+                                GetGraphicsQueueMutex(),
+                                GetGraphicsTimelineSemaphore(),
+                                g_GraphicsTimelineValue,
+                                CommandPool,
+                                CommandBuffers);
+}
+
+void RenderCore::FinishSingleCommandQueue(VkCommandPool const &CommandPool, std::vector<VkCommandBuffer> const &CommandBuffers)
+{
+    WaitUpload(SubmitSingleCommandQueue(CommandPool, CommandBuffers));
+    ReclaimPendingSubmissions();
+}
+
+TransferCommands RenderCore::BeginTransferCommands()
+{
+    TransferCommands             Output {};
+    std::vector<VkCommandBuffer> CommandBuffers { VK_NULL_HANDLE };
+
+    InitializeSingleCommandQueue(Output.CommandPool, CommandBuffers, GetTransferQueue().first);
+    Output.CommandBuffer = CommandBuffers.at(0U);
+
+    return Output;
+}
+
+// The copies must already leave the image in the transfer destination layout, the hand-over moves it to the read only layout
+void RenderCore::ReleaseTransferredImage(TransferCommands &Commands, VkImage const &Image, std::uint32_t const MipLevels)
+{
+    bool const IsDedicated = HasDedicatedTransferQueue();
+
+    VkImageMemoryBarrier2 ReleaseBarrier {
+            .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+            .srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+            .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+            .dstStageMask = IsDedicated ? VK_PIPELINE_STAGE_2_NONE : VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+            .dstAccessMask = IsDedicated ? VK_ACCESS_2_NONE : VK_ACCESS_2_SHADER_READ_BIT,
+            .oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            .newLayout = VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL,
+            .srcQueueFamilyIndex = IsDedicated ? static_cast<std::uint32_t>(GetTransferQueue().first) : VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = IsDedicated ? static_cast<std::uint32_t>(GetGraphicsQueue().first) : VK_QUEUE_FAMILY_IGNORED,
+            .image = Image,
+            .subresourceRange = { .aspectMask = g_ImageAspect, .baseMipLevel = 0U, .levelCount = MipLevels, .baseArrayLayer = 0U, .layerCount = 1U }
     };
 
-    CheckVulkanResult(vkQueueSubmit2(Queue, 1U, &SubmitInfo, VK_NULL_HANDLE));
-    CheckVulkanResult(vkQueueWaitIdle(Queue));
+    VkDependencyInfo const DependencyInfo {
+            .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+            .imageMemoryBarrierCount = 1U,
+            .pImageMemoryBarriers = &ReleaseBarrier
+    };
 
-    VkDevice const &LogicalDevice = GetLogicalDevice();
+    vkCmdPipelineBarrier2(Commands.CommandBuffer, &DependencyInfo);
+
+    if (!IsDedicated)
+    {
+        return;
+    }
+
+    // The acquisition repeats the layout transition and queue families of the release, with the graphics side scopes.
+    // Frames wait on the transfer timeline at the fragment shader stage, so the acquire starts there to chain after that wait.
+    ReleaseBarrier.srcStageMask  = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT;
+    ReleaseBarrier.srcAccessMask = VK_ACCESS_2_NONE;
+    ReleaseBarrier.dstStageMask  = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT;
+    ReleaseBarrier.dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT;
+
+    Commands.AcquireBarriers.push_back(ReleaseBarrier);
+}
+
+UploadTicket RenderCore::SubmitTransferCommands(TransferCommands &&Commands)
+{
+    UploadTicket const Ticket = SubmitUploadCommands(GetTransferQueue().second,
+                                                     GetTransferQueueMutex(),
+                                                     GetTransferTimelineSemaphore(),
+                                                     g_TransferTimelineValue,
+                                                     Commands.CommandPool,
+                                                     { Commands.CommandBuffer });
+
+    if (!std::empty(Commands.AcquireBarriers))
+    {
+        std::lock_guard Lock { g_TransferAcquiresMutex };
+        g_TransferAcquires.push_back({ .Ticket = Ticket, .Barriers = std::move(Commands.AcquireBarriers) });
+    }
+
+    return Ticket;
+}
+
+void RenderCore::DiscardTransferAcquires(VkImage const &Image)
+{
+    std::lock_guard Lock { g_TransferAcquiresMutex };
+
+    for (TransferAcquire &AcquireIter : g_TransferAcquires)
+    {
+        std::erase_if(AcquireIter.Barriers,
+                      [&Image](VkImageMemoryBarrier2 const &BarrierIter)
+                      {
+                          return BarrierIter.image == Image;
+                      });
+    }
 
-    vkFreeCommandBuffers(LogicalDevice, CommandPool, static_cast<std::uint32_t>(std::size(CommandBuffers)), std::data(CommandBuffers));
-    vkDestroyCommandPool(LogicalDevice, CommandPool, nullptr);
+    std::erase_if(g_TransferAcquires,
+                  [](TransferAcquire const &AcquireIter)
+                  {
+                      return std::empty(AcquireIter.Barriers);
+                  });
 }
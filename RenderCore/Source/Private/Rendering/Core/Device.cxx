@@ -6,8 +6,10 @@ module;
 
 #include <algorithm>
 #include <format>
+#include <mutex>
 #include <optional>
 #include <ranges>
+#include <string_view>
 #include <unordered_map>
 #include <GLFW/glfw3.h>
 #include <Volk/volk.h>
@@ -27,7 +29,14 @@ VkPhysicalDevice                 g_PhysicalDevice { VK_NULL_HANDLE };
 VkPhysicalDeviceProperties       g_PhysicalDeviceProperties {};
 VkDevice                         g_Device { VK_NULL_HANDLE };
 std::pair<std::uint8_t, VkQueue> g_GraphicsQueue {};
+std::mutex                       g_GraphicsQueueMutex {};
+std::pair<std::uint8_t, VkQueue> g_TransferQueue {};
+std::mutex                       g_TransferQueueMutex {};
 std::vector<std::uint8_t>        g_UniqueQueueFamilyIndices {};
+bool                             g_IndexTypeUint8Enabled { false };
+bool                             g_MeshShaderEnabled { false };
+bool                             g_TextureCompressionBCEnabled { false };
+bool                             g_TextureCompressionASTCEnabled { false };
 
 bool IsPhysicalDeviceSuitable(VkPhysicalDevice const &Device)
 {
@@ -87,6 +96,40 @@ bool GetQueueFamilyIndices(VkSurfaceKHR const &         VulkanSurface,
     return GraphicsQueueFamilyIndex.has_value() && PresentationQueueFamilyIndex.has_value() && ComputeQueueFamilyIndex.has_value();
 }
 
+// Families exposing only transfer operations are usually backed by the copy engines, which run alongside the graphics work
+std::uint8_t GetTransferQueueFamilyIndex(std::uint8_t const GraphicsQueueFamilyIndex)
+{
+    std::uint32_t QueueFamilyCount = 0U;
+    vkGetPhysicalDeviceQueueFamilyProperties(g_PhysicalDevice, &QueueFamilyCount, nullptr);
+
+    std::vector<VkQueueFamilyProperties> QueueFamilies(QueueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(g_PhysicalDevice, &QueueFamilyCount, std::data(QueueFamilies));
+
+    std::optional<std::uint8_t> Output { std::nullopt };
+
+    for (std::uint32_t Iterator = 0U; Iterator < QueueFamilyCount; ++Iterator)
+    {
+        VkQueueFlags const Flags = QueueFamilies.at(Iterator).queueFlags;
+
+        if (Iterator == GraphicsQueueFamilyIndex || (Flags & VK_QUEUE_GRAPHICS_BIT) != 0U || (Flags & VK_QUEUE_TRANSFER_BIT) == 0U)
+        {
+            continue;
+        }
+
+        if ((Flags & VK_QUEUE_COMPUTE_BIT) == 0U)
+        {
+            return static_cast<std::uint8_t>(Iterator);
+        }
+
+        if (!Output.has_value())
+        {
+            Output.emplace(static_cast<std::uint8_t>(Iterator));
+        }
+    }
+
+    return Output.value_or(GraphicsQueueFamilyIndex);
+}
+
 void PickPhysicalDevice()
 {
     for (VkPhysicalDevice const &Device : GetAvailablePhysicalDevices())
@@ -109,6 +152,9 @@ void CreateLogicalDevice(VkSurfaceKHR const &VulkanSurface)
 
     GetQueueFamilyIndices(VulkanSurface, GraphicsQueueFamilyIndex, PresentationQueueFamilyIndex, ComputeQueueFamilyIndex);
 
+    g_GraphicsQueue.first = GraphicsQueueFamilyIndex.value_or(0U);
+    g_TransferQueue.first = GetTransferQueueFamilyIndex(g_GraphicsQueue.first);
+
     std::vector Layers(std::cbegin(g_RequiredDeviceLayers), std::cend(g_RequiredDeviceLayers));
     std::vector Extensions(std::cbegin(g_RequiredDeviceExtensions), std::cend(g_RequiredDeviceExtensions));
 
@@ -123,6 +169,50 @@ void CreateLogicalDevice(VkSurfaceKHR const &VulkanSurface)
     auto const AvailableExtensions = GetAvailablePhysicalDeviceExtensionsNames();
     GetAvailableResources("device extensions", Extensions, g_OptionalDeviceExtensions, AvailableExtensions);
 
+    VkPhysicalDeviceIndexTypeUint8FeaturesEXT IndexTypeUint8Features {
+            // Optional
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_INDEX_TYPE_UINT8_FEATURES_EXT,
+            .pNext = nullptr
+    };
+
+    if (std::ranges::find_if(Extensions,
+                             [](char const *const ExtensionIter)
+                             {
+                                 return std::string_view { ExtensionIter } == VK_EXT_INDEX_TYPE_UINT8_EXTENSION_NAME;
+                             }) != std::cend(Extensions))
+    {
+        VkPhysicalDeviceFeatures2 SupportedFeatures { .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2, .pNext = &IndexTypeUint8Features };
+        vkGetPhysicalDeviceFeatures2(g_PhysicalDevice, &SupportedFeatures);
+    }
+
+    g_IndexTypeUint8Enabled = IndexTypeUint8Features.indexTypeUint8 == VK_TRUE;
+
+    VkPhysicalDeviceMeshShaderFeaturesEXT MeshShaderFeatures {
+            // Optional
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_FEATURES_EXT,
+            .pNext = nullptr
+    };
+
+    if (std::ranges::find_if(Extensions,
+                             [](char const *const ExtensionIter)
+                             {
+                                 return std::string_view { ExtensionIter } == VK_EXT_MESH_SHADER_EXTENSION_NAME;
+                             }) != std::cend(Extensions))
+    {
+        VkPhysicalDeviceFeatures2 SupportedFeatures { .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2, .pNext = &MeshShaderFeatures };
+        vkGetPhysicalDeviceFeatures2(g_PhysicalDevice, &SupportedFeatures);
+    }
+
+    g_MeshShaderEnabled = MeshShaderFeatures.taskShader == VK_TRUE && MeshShaderFeatures.meshShader == VK_TRUE;
+
+    // Only the stages used by the meshlet pipeline are enabled
+    MeshShaderFeatures = VkPhysicalDeviceMeshShaderFeaturesEXT {
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_FEATURES_EXT,
+            .pNext = g_IndexTypeUint8Enabled ? &IndexTypeUint8Features : nullptr,
+            .taskShader = g_MeshShaderEnabled,
+            .meshShader = g_MeshShaderEnabled
+    };
+
     std::unordered_map<std::uint8_t, std::uint8_t> QueueFamilyIndices { { g_GraphicsQueue.first, 1U } };
 
     g_UniqueQueueFamilyIndices.clear();
@@ -144,18 +234,25 @@ void CreateLogicalDevice(VkSurfaceKHR const &VulkanSurface)
                                   });
     }
 
-    VkPhysicalDeviceMeshShaderFeaturesEXT MeshShaderFeatures {
-            // Required
-            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_FEATURES_EXT,
-            .pNext = nullptr,
-            .taskShader = VK_TRUE,
-            .meshShader = VK_TRUE
-    };
+    // The transfer family never touches the swap chain images, so it stays out of the shared indices
+    if (g_TransferQueue.first != g_GraphicsQueue.first)
+    {
+        QueueCreateInfo.push_back(VkDeviceQueueCreateInfo {
+                                          .sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+                                          .queueFamilyIndex = g_TransferQueue.first,
+                                          .queueCount = 1U,
+                                          .pQueuePriorities = std::data(Priorities)
+                                  });
+    }
 
     VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT PipelineLibraryProperties {
             // Required
             .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT,
-            .pNext = &MeshShaderFeatures,
+            .pNext = g_MeshShaderEnabled
+                         ? static_cast<void *>(&MeshShaderFeatures)
+                         : g_IndexTypeUint8Enabled
+                               ? static_cast<void *>(&IndexTypeUint8Features)
+                               : nullptr,
             .graphicsPipelineLibrary = VK_TRUE,
     };
 
@@ -173,10 +270,17 @@ void CreateLogicalDevice(VkSurfaceKHR const &VulkanSurface)
             .descriptorBuffer = VK_TRUE
     };
 
+    VkPhysicalDeviceTimelineSemaphoreFeatures TimelineSemaphoreFeatures {
+            // Required
+            .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES,
+            .pNext = &DescriptorBufferFeatures,
+            .timelineSemaphore = VK_TRUE
+    };
+
     VkPhysicalDeviceSynchronization2Features Synchronization2Features {
             // Required
             .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES,
-            .pNext = &DescriptorBufferFeatures,
+            .pNext = &TimelineSemaphoreFeatures,
             .synchronization2 = VK_TRUE
     };
 
@@ -187,6 +291,13 @@ void CreateLogicalDevice(VkSurfaceKHR const &VulkanSurface)
             .dynamicRendering = VK_TRUE
     };
 
+    // Block compressed formats are optional, transcoded textures fall back to uncompressed data without them
+    VkPhysicalDeviceFeatures SupportedCoreFeatures {};
+    vkGetPhysicalDeviceFeatures(g_PhysicalDevice, &SupportedCoreFeatures);
+
+    g_TextureCompressionBCEnabled   = SupportedCoreFeatures.textureCompressionBC == VK_TRUE;
+    g_TextureCompressionASTCEnabled = SupportedCoreFeatures.textureCompressionASTC_LDR == VK_TRUE;
+
     VkPhysicalDeviceFeatures2 DeviceFeatures {
             .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
             .pNext = &DynamicRenderingFeatures,
@@ -196,6 +307,8 @@ void CreateLogicalDevice(VkSurfaceKHR const &VulkanSurface)
                     .fillModeNonSolid = true,
                     .wideLines = true,
                     .samplerAnisotropy = VK_TRUE,
+                    .textureCompressionASTC_LDR = g_TextureCompressionASTCEnabled,
+                    .textureCompressionBC = g_TextureCompressionBCEnabled,
                     .pipelineStatisticsQuery = true,
                     .vertexPipelineStoresAndAtomics = true,
                     .fragmentStoresAndAtomics = true,
@@ -219,6 +332,7 @@ void CreateLogicalDevice(VkSurfaceKHR const &VulkanSurface)
     volkLoadDevice(g_Device);
 
     vkGetDeviceQueue(g_Device, g_GraphicsQueue.first, 0U, &g_GraphicsQueue.second);
+    vkGetDeviceQueue(g_Device, g_TransferQueue.first, 0U, &g_TransferQueue.second);
 }
 
 void RenderCore::InitializeDevice(VkSurfaceKHR const &VulkanSurface)
@@ -293,6 +407,61 @@ std::pair<std::uint8_t, VkQueue> &RenderCore::GetGraphicsQueue()
     return g_GraphicsQueue;
 }
 
+std::mutex &RenderCore::GetGraphicsQueueMutex()
+{
+    return g_GraphicsQueueMutex;
+}
+
+std::pair<std::uint8_t, VkQueue> &RenderCore::GetTransferQueue()
+{
+    return g_TransferQueue;
+}
+
+std::mutex &RenderCore::GetTransferQueueMutex()
+{
+    // Without a dedicated family the transfers are submitted to the graphics queue itself
+    return HasDedicatedTransferQueue() ? g_TransferQueueMutex : g_GraphicsQueueMutex;
+}
+
+bool RenderCore::HasDedicatedTransferQueue()
+{
+    return g_TransferQueue.first != g_GraphicsQueue.first;
+}
+
+void RenderCore::WaitDeviceIdle()
+{
+    // Waiting for the device accesses every queue, so a dedicated transfer queue must not be submitted to meanwhile either
+    std::lock_guard  GraphicsLock { g_GraphicsQueueMutex };
+    std::unique_lock TransferLock { g_TransferQueueMutex, std::defer_lock };
+
+    if (HasDedicatedTransferQueue())
+    {
+        TransferLock.lock();
+    }
+
+    CheckVulkanResult(vkDeviceWaitIdle(g_Device));
+}
+
+bool RenderCore::IsIndexTypeUint8Enabled()
+{
+    return g_IndexTypeUint8Enabled;
+}
+
+bool RenderCore::IsMeshShaderEnabled()
+{
+    return g_MeshShaderEnabled;
+}
+
+bool RenderCore::IsTextureCompressionBCEnabled()
+{
+    return g_TextureCompressionBCEnabled;
+}
+
+bool RenderCore::IsTextureCompressionASTCEnabled()
+{
+    return g_TextureCompressionASTCEnabled;
+}
+
 std::vector<std::uint32_t> RenderCore::GetUniqueQueueFamilyIndicesU32()
 {
     std::vector<std::uint32_t> QueueFamilyIndicesU32(std::size(g_UniqueQueueFamilyIndices));
@@ -312,8 +481,14 @@ void RenderCore::ReleaseDeviceResources()
     vkDestroyDevice(g_Device, nullptr);
     g_Device = VK_NULL_HANDLE;
 
-    g_PhysicalDevice       = VK_NULL_HANDLE;
-    g_GraphicsQueue.second = VK_NULL_HANDLE;
+    g_PhysicalDevice        = VK_NULL_HANDLE;
+    g_GraphicsQueue.second  = VK_NULL_HANDLE;
+    g_TransferQueue.second  = VK_NULL_HANDLE;
+    g_IndexTypeUint8Enabled = false;
+    g_MeshShaderEnabled     = false;
+
+    g_TextureCompressionBCEnabled   = false;
+    g_TextureCompressionASTCEnabled = false;
 }
 
 std::vector<VkPhysicalDevice> RenderCore::GetAvailablePhysicalDevices()
@@ -0,0 +1,227 @@
+// Author: Lucas Vilas-Boas
+// Year : 2024
+// Repo : https://github.com/lucoiso/vulkan-renderer
+
+module;
+
+#include <cstring>
+#include <format>
+#include <span>
+#include <string>
+#include <tiny_gltf.h>
+#include <utility>
+#include <vector>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+module RenderCore.Runtime.GLBFile;
+
+import RenderCore.Utils.Helpers;
+
+using namespace RenderCore;
+
+constexpr std::uint32_t g_GLBMagic { 0x46546C67U };
+constexpr std::uint32_t g_GLBVersion { 2U };
+constexpr std::uint32_t g_GLBChunkJSON { 0x4E4F534AU };
+constexpr std::uint32_t g_GLBChunkBIN { 0x004E4942U };
+
+// Smallest valid buffer, standing in for the BIN chunk while the JSON is parsed
+constexpr std::string_view g_GLBStubBufferUri { "data:application/octet-stream;base64,AA==" };
+
+struct GLBHeader
+{
+    std::uint32_t Magic { 0U };
+    std::uint32_t Version { 0U };
+    std::uint32_t Length { 0U };
+};
+
+struct GLBChunkHeader
+{
+    std::uint32_t Length { 0U };
+    std::uint32_t Type { 0U };
+};
+
+void RenderCore::StubCompressionFallbackBuffers(nlohmann::json &Document)
+{
+    auto const BuffersIt = Document.find("buffers");
+    if (BuffersIt == std::end(Document) || !BuffersIt->is_array())
+    {
+        return;
+    }
+
+    for (nlohmann::json &Buffer : *BuffersIt)
+    {
+        if (Buffer.contains("uri") || !Buffer.contains("extensions") || !Buffer["extensions"].contains("EXT_meshopt_compression") ||
+            !Buffer["extensions"]["EXT_meshopt_compression"].value("fallback", false))
+        {
+            continue;
+        }
+
+        Buffer["byteLength"] = 1U;
+        Buffer["uri"]        = g_GLBStubBufferUri;
+    }
+}
+
+bool GLBFile::Open(std::string_view const Path, std::string &Error)
+{
+    try
+    {
+        m_File   = boost::interprocess::file_mapping(std::string { Path }.c_str(), boost::interprocess::read_only);
+        m_Region = boost::interprocess::mapped_region(m_File, boost::interprocess::read_only);
+    }
+    catch (boost::interprocess::interprocess_exception const &Exception)
+    {
+        Error = std::format("Failed to map file: {}", Exception.what());
+        return false;
+    }
+
+    auto const *const   Data = static_cast<unsigned char const *>(m_Region.get_address());
+    std::uint64_t const Size = m_Region.get_size();
+
+    GLBHeader      Header {};
+    GLBChunkHeader JSONChunk {};
+
+    if (Size < sizeof(GLBHeader) + sizeof(GLBChunkHeader))
+    {
+        Error = "File too small to be a binary glTF";
+        return false;
+    }
+
+    std::memcpy(&Header, Data, sizeof(GLBHeader));
+    std::memcpy(&JSONChunk, Data + sizeof(GLBHeader), sizeof(GLBChunkHeader));
+
+    std::uint64_t const JSONOffset = sizeof(GLBHeader) + sizeof(GLBChunkHeader);
+
+    if (Header.Magic != g_GLBMagic || Header.Version != g_GLBVersion || Header.Length > Size || JSONChunk.Type != g_GLBChunkJSON ||
+        JSONOffset + JSONChunk.Length > Header.Length)
+    {
+        Error = "Invalid binary glTF header";
+        return false;
+    }
+
+    m_JSON = std::string_view { reinterpret_cast<char const *>(Data + JSONOffset), JSONChunk.Length };
+
+    // The BIN chunk is optional and follows the JSON chunk, both are padded to 4 bytes
+    std::uint64_t const BinaryOffset = AlignUp(JSONOffset + JSONChunk.Length, 4U);
+
+    if (GLBChunkHeader BinaryChunk {};
+        BinaryOffset + sizeof(GLBChunkHeader) <= Header.Length)
+    {
+        std::memcpy(&BinaryChunk, Data + BinaryOffset, sizeof(GLBChunkHeader));
+
+        if (BinaryChunk.Type == g_GLBChunkBIN && BinaryOffset + sizeof(GLBChunkHeader) + BinaryChunk.Length <= Header.Length)
+        {
+            m_BinaryChunk = std::span { Data + BinaryOffset + sizeof(GLBChunkHeader), BinaryChunk.Length };
+        }
+    }
+
+    return true;
+}
+
+bool GLBFile::LoadModel(tinygltf::TinyGLTF &Loader, tinygltf::Model &Model, std::string &Error, std::string &Warning, std::string const &BaseDirectory)
+{
+    nlohmann::json Document = nlohmann::json::parse(std::begin(m_JSON), std::end(m_JSON), nullptr, false);
+    if (Document.is_discarded() || !Document.is_object())
+    {
+        Error = "Invalid binary glTF JSON chunk";
+        return false;
+    }
+
+    // Fallback buffers have no uri either, they are stubbed first so the BIN chunk search skips them
+    StubCompressionFallbackBuffers(Document);
+
+    // Only a buffer without uri refers to the BIN chunk, the loader gets a one byte stub in its place so nothing is copied
+    std::int32_t  BinaryBuffer { -1 };
+    std::uint64_t BinaryLength { 0U };
+
+    if (auto const BuffersIt = Document.find("buffers");
+        BuffersIt != std::end(Document) && BuffersIt->is_array())
+    {
+        for (std::size_t Iterator = 0U; Iterator < std::size(*BuffersIt); ++Iterator)
+        {
+            nlohmann::json &Buffer = BuffersIt->at(Iterator);
+            if (Buffer.contains("uri"))
+            {
+                continue;
+            }
+
+            BinaryLength = Buffer.value("byteLength", std::uint64_t { 0U });
+            if (BinaryLength > std::size(m_BinaryChunk))
+            {
+                Error = std::format("Buffer byteLength {} exceeds the BIN chunk size {}", BinaryLength, std::size(m_BinaryChunk));
+                return false;
+            }
+
+            BinaryBuffer         = static_cast<std::int32_t>(Iterator);
+            Buffer["byteLength"] = 1U;
+            Buffer["uri"]        = g_GLBStubBufferUri;
+            break;
+        }
+    }
+
+    // Images stored in the BIN chunk are decoded by the loader at parse time, so they are pointed at a one byte view of the stub meanwhile
+    std::vector<std::pair<std::size_t, std::int32_t>> BinaryImages {};
+
+    if (auto const ImagesIt = Document.find("images"), ViewsIt = Document.find("bufferViews");
+        BinaryBuffer >= 0 && ImagesIt != std::end(Document) && ImagesIt->is_array() && ViewsIt != std::end(Document) && ViewsIt->is_array())
+    {
+        auto const StubView = static_cast<std::int32_t>(std::size(*ViewsIt));
+
+        for (std::size_t Iterator = 0U; Iterator < std::size(*ImagesIt); ++Iterator)
+        {
+            nlohmann::json &Image = ImagesIt->at(Iterator);
+
+            std::int32_t const View = Image.value("bufferView", -1);
+            if (View < 0 || View >= StubView || ViewsIt->at(static_cast<std::size_t>(View)).value("buffer", -1) != BinaryBuffer)
+            {
+                continue;
+            }
+
+            BinaryImages.emplace_back(Iterator, View);
+            Image["bufferView"] = StubView;
+        }
+
+        if (!std::empty(BinaryImages))
+        {
+            ViewsIt->push_back({ { "buffer", BinaryBuffer }, { "byteLength", 1U } });
+        }
+    }
+
+    std::string const JSON = Document.dump();
+    if (!Loader.LoadASCIIFromString(&Model, &Error, &Warning, std::data(JSON), static_cast<unsigned int>(std::size(JSON)), BaseDirectory))
+    {
+        return false;
+    }
+
+    if (BinaryBuffer >= 0)
+    {
+        tinygltf::Buffer &Buffer = Model.buffers.at(BinaryBuffer);
+        Buffer.data.clear();
+        Buffer.uri.clear();
+
+        m_BinaryBuffer = BinaryBuffer;
+        m_BinaryLength = BinaryLength;
+    }
+
+    if (!std::empty(BinaryImages))
+    {
+        Model.bufferViews.pop_back();
+
+        for (auto const &[ImageIndex, View] : BinaryImages)
+        {
+            Model.images.at(ImageIndex).bufferView = View;
+        }
+    }
+
+    return true;
+}
+
+std::int32_t GLBFile::GetBinaryBufferIndex() const
+{
+    return m_BinaryBuffer;
+}
+
+std::span<unsigned char const> GLBFile::GetBinaryBuffer() const
+{
+    return m_BinaryChunk.first(m_BinaryLength);
+}
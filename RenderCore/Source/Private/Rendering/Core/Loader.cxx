@@ -0,0 +1,280 @@
+// Author: Lucas Vilas-Boas
+// Year : 2024
+// Repo : https://github.com/lucoiso/vulkan-renderer
+
+module;
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+module RenderCore.Runtime.Loader;
+
+import RenderCore.Runtime.Scene;
+import RenderCore.Runtime.Memory;
+import RenderCore.Runtime.Pipeline;
+import RenderCore.Runtime.Command;
+import RenderCore.Types.Object;
+import RenderCore.Types.ObjectLoadBatch;
+import RenderCore.Utils.Constants;
+import ThreadPool;
+
+using namespace RenderCore;
+
+struct CompletedLoad
+{
+    std::vector<std::shared_ptr<Object>>                Objects {};
+    std::function<void(std::vector<std::uint32_t> &&)> Publish {};
+};
+
+// Files are parsed on every loader thread but built in file order on a single one, so a batch keeps the stages of consecutive files overlapped
+struct BatchLoad
+{
+    std::shared_ptr<ObjectLoadBatch>          Batch {};
+    std::atomic<std::uint32_t>                NextToParse { 0U };
+    std::uint8_t                              BuildThread { 0U };
+    std::mutex                                Mutex {};
+    std::vector<std::shared_ptr<ParsedScene>> ParsedScenes {};
+    std::vector<bool>                         IsParseFinished {};
+    std::uint32_t                             NextToBuild { 0U };
+};
+
+std::uint8_t               g_NumLoaderThreads { 0U };
+std::atomic<std::uint8_t>  g_NextLoaderThread { 0U };
+ThreadPool::Pool           g_LoaderThreadPool {};
+std::vector<CompletedLoad> g_CompletedLoads {};
+std::mutex                 g_CompletedLoadsMutex {};
+std::atomic<std::uint32_t> g_NumBatchTasks { 0U };
+std::atomic<bool>          g_IsReleasingLoader { false };
+
+void RenderCore::InitializeLoaderResources()
+{
+    // Thread indices are 8 bits wide, so the count is clamped before narrowing instead of wrapping on hosts with 256 or more threads
+    g_NumLoaderThreads = static_cast<std::uint8_t>(std::clamp(std::thread::hardware_concurrency(),
+                                                              1U,
+                                                              static_cast<std::uint32_t>(std::numeric_limits<std::uint8_t>::max())));
+    g_LoaderThreadPool.SetupCPUThreads("LoaderThread");
+}
+
+void RenderCore::ReleaseLoaderResources()
+{
+    // Batch tasks enqueue the next ones while they run, so a single wait can return before a batch is drained
+    g_IsReleasingLoader = true;
+
+    do
+    {
+        g_LoaderThreadPool.Wait();
+    }
+    while (g_NumBatchTasks.load() > 0U);
+
+    g_IsReleasingLoader = false;
+
+    std::lock_guard Lock { g_CompletedLoadsMutex };
+
+    // Dropped objects were never published, so only the geometry placed by the loader threads is released
+    for (auto &[Objects, Publish] : g_CompletedLoads)
+    {
+        RetireModels(std::move(Objects));
+        Publish({});
+    }
+    g_CompletedLoads.clear();
+}
+
+std::shared_future<std::vector<std::uint32_t>> RenderCore::EnqueueObjectLoad(std::string_view const ObjectPath)
+{
+    auto Promise = std::make_shared<std::promise<std::vector<std::uint32_t>>>();
+    std::shared_future<std::vector<std::uint32_t>> Output = Promise->get_future().share();
+
+    std::uint8_t const ThreadIndex = g_NextLoaderThread.fetch_add(1U) % g_NumLoaderThreads;
+
+    g_LoaderThreadPool.AddTask([Path = std::string { ObjectPath }, Promise = std::move(Promise)]() mutable
+                               {
+                                   std::vector<std::shared_ptr<Object>> LoadedObjects = LoadScene(Path);
+                                   AllocateGeometry(LoadedObjects);
+
+                                   std::lock_guard Lock { g_CompletedLoadsMutex };
+                                   g_CompletedLoads.push_back({
+                                           .Objects = std::move(LoadedObjects),
+                                           .Publish = [Promise = std::move(Promise)](std::vector<std::uint32_t> &&ObjectIDs)
+                                           {
+                                               Promise->set_value(std::move(ObjectIDs));
+                                           }
+                                   });
+                               },
+                               ThreadIndex);
+
+    return Output;
+}
+
+void AddBatchTask(std::function<void()> &&Task, std::uint8_t const ThreadIndex)
+{
+    g_NumBatchTasks.fetch_add(1U);
+
+    g_LoaderThreadPool.AddTask([Task = std::move(Task)]
+                               {
+                                   Task();
+                                   g_NumBatchTasks.fetch_sub(1U);
+                               },
+                               ThreadIndex);
+}
+
+void EnqueueBatchParse(std::shared_ptr<BatchLoad> const &);
+
+void EnqueueBatchBuild(std::shared_ptr<BatchLoad> const &Load, std::uint32_t const Index, std::shared_ptr<ParsedScene> const &Scene)
+{
+    AddBatchTask([Load, Index, Scene]
+                 {
+                     // Keep the parse window full while this file is decoded and uploaded
+                     EnqueueBatchParse(Load);
+
+                     if (g_IsReleasingLoader.load())
+                     {
+                         Load->Batch->SetFailed(Index, "The loader was released before the model was built");
+                         return;
+                     }
+
+                     std::vector<std::shared_ptr<Object>> LoadedObjects = BuildScene(*Scene);
+                     AllocateGeometry(LoadedObjects);
+
+                     std::lock_guard Lock { g_CompletedLoadsMutex };
+                     g_CompletedLoads.push_back({
+                             .Objects = std::move(LoadedObjects),
+                             .Publish = [Load, Index](std::vector<std::uint32_t> &&ObjectIDs)
+                             {
+                                 Load->Batch->SetLoaded(Index, std::move(ObjectIDs));
+                             }
+                     });
+                 },
+                 Load->BuildThread);
+}
+
+// Parses finish in any order, so each file is only queued on the build thread once every file before it has been parsed or has failed
+void FinishBatchParse(std::shared_ptr<BatchLoad> const &Load, std::uint32_t const Index, std::shared_ptr<ParsedScene> &&Scene)
+{
+    std::lock_guard Lock { Load->Mutex };
+
+    Load->ParsedScenes.at(Index)    = std::move(Scene);
+    Load->IsParseFinished.at(Index) = true;
+
+    for (; Load->NextToBuild < Load->Batch->GetNumFiles() && Load->IsParseFinished.at(Load->NextToBuild); ++Load->NextToBuild)
+    {
+        if (std::shared_ptr<ParsedScene> const ReadyScene = std::move(Load->ParsedScenes.at(Load->NextToBuild));
+            ReadyScene)
+        {
+            EnqueueBatchBuild(Load, Load->NextToBuild, ReadyScene);
+        }
+    }
+}
+
+void EnqueueBatchParse(std::shared_ptr<BatchLoad> const &Load)
+{
+    std::uint32_t Index = Load->NextToParse.fetch_add(1U);
+
+    // Files not started when the loader is released are failed right away, so the batch still completes
+    if (g_IsReleasingLoader.load())
+    {
+        for (; Index < Load->Batch->GetNumFiles(); Index = Load->NextToParse.fetch_add(1U))
+        {
+            Load->Batch->SetFailed(Index, "The loader was released before the model was parsed");
+        }
+
+        return;
+    }
+
+    if (Index >= Load->Batch->GetNumFiles())
+    {
+        return;
+    }
+
+    std::uint8_t ThreadIndex = g_NextLoaderThread.fetch_add(1U) % g_NumLoaderThreads;
+    if (ThreadIndex == Load->BuildThread && g_NumLoaderThreads > 1U)
+    {
+        ThreadIndex = (ThreadIndex + 1U) % g_NumLoaderThreads;
+    }
+
+    AddBatchTask([Load, Index]
+                 {
+                     std::string                  Error {};
+                     std::shared_ptr<ParsedScene> Scene = ParseScene(Load->Batch->GetPath(Index), Error);
+
+                     if (Scene)
+                     {
+                         Load->Batch->SetParsed(Index);
+                     }
+                     else
+                     {
+                         Load->Batch->SetFailed(Index, Error);
+                         EnqueueBatchParse(Load);
+                     }
+
+                     FinishBatchParse(Load, Index, std::move(Scene));
+                 },
+                 ThreadIndex);
+}
+
+std::shared_ptr<ObjectLoadBatch> RenderCore::EnqueueObjectBatchLoad(std::vector<std::string> const &ObjectPaths)
+{
+    auto Load         = std::make_shared<BatchLoad>();
+    Load->Batch       = std::make_shared<ObjectLoadBatch>(ObjectPaths);
+    Load->BuildThread = g_NextLoaderThread.fetch_add(1U) % g_NumLoaderThreads;
+    Load->ParsedScenes.resize(Load->Batch->GetNumFiles());
+    Load->IsParseFinished.resize(Load->Batch->GetNumFiles(), false);
+
+    std::uint32_t const NumInitialParses = std::min(g_LoaderParseAhead, Load->Batch->GetNumFiles());
+    for (std::uint32_t Iterator = 0U; Iterator < NumInitialParses; ++Iterator)
+    {
+        EnqueueBatchParse(Load);
+    }
+
+    return Load->Batch;
+}
+
+bool RenderCore::HasLoadedObjectsToPublish()
+{
+    std::lock_guard Lock { g_CompletedLoadsMutex };
+    return !std::empty(g_CompletedLoads);
+}
+
+void RenderCore::PublishLoadedObjects()
+{
+    std::vector<CompletedLoad> CompletedLoads {};
+    {
+        std::lock_guard Lock { g_CompletedLoadsMutex };
+        CompletedLoads.swap(g_CompletedLoads);
+    }
+
+    std::vector<std::shared_ptr<Object>> ObjectsToInsert {};
+    for (auto const &[Objects, Publish] : CompletedLoads)
+    {
+        ObjectsToInsert.insert(std::end(ObjectsToInsert), std::begin(Objects), std::end(Objects));
+    }
+
+    if (!std::empty(ObjectsToInsert))
+    {
+        // Geometry was written and flushed by the loader threads, so only the slots of the new objects are taken here
+        InsertObjects(ObjectsToInsert);
+
+        GetPipelineDescriptorData().UpdateModelsBuffer(ObjectsToInsert);
+        SetNumObjectsPerThread(GetNumAllocations());
+    }
+
+    for (auto &[Objects, Publish] : CompletedLoads)
+    {
+        std::vector<std::uint32_t> ObjectIDs {};
+        ObjectIDs.reserve(std::size(Objects));
+
+        for (std::shared_ptr<Object> const &ObjectIter : Objects)
+        {
+            ObjectIDs.push_back(ObjectIter->GetID());
+        }
+
+        Publish(std::move(ObjectIDs));
+    }
+}
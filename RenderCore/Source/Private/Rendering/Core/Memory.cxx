@@ -4,7 +4,15 @@
 
 module;
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <deque>
+#include <execution>
+#include <mutex>
 #include <ranges>
+#include <span>
+#include <unordered_map>
 #include <stb_image_write.h>
 #include <Volk/volk.h>
 
@@ -32,22 +40,122 @@ import RenderCore.Runtime.Command;
 import RenderCore.Runtime.Device;
 import RenderCore.Runtime.Scene;
 import RenderCore.Runtime.Instance;
+import RenderCore.Runtime.Synchronization;
 import RenderCore.Types.Object;
 import RenderCore.Types.UniformBufferObject;
 
 using namespace RenderCore;
 
+// Pages are never moved once created, so ranges are written by the loader threads while the frames keep drawing from the other ranges
+struct GeometryHeapPage
+{
+    BufferAllocation Heap {};
+    VmaVirtualBlock  Block { VK_NULL_HANDLE };
+    VkDeviceAddress  Address { 0U };
+};
+
+struct GeometryRange
+{
+    std::shared_ptr<MeshGeometry>     Geometry {};
+    std::shared_ptr<GeometryHeapPage> Page {};
+    VmaVirtualAllocation              Allocation { VK_NULL_HANDLE };
+    VkDeviceSize                      Offset { 0U };
+    VkDeviceSize                      Size { 0U };
+    std::uint32_t                     NumUsers { 0U };
+};
+
+// Complete mip chain of images whose resident levels follow the screen coverage and the heap budget, read from the mapped mesh cache on demand
+struct TextureStreamingSource
+{
+    std::span<unsigned char const> Data {};
+    std::shared_ptr<void const>    DataOwner {};
+    std::vector<VkDeviceSize>  LevelOffsets {};
+    std::vector<VkDeviceSize>  LevelSizes {};
+    VkExtent2D                 Extent {};
+    VkFormat                   Format { VK_FORMAT_UNDEFINED };
+    std::uint32_t              TailLevel { 0U };
+    std::uint32_t              ResidentLevel { 0U };
+};
+
+// New resident levels uploaded on the transfer queue, swapped in once the GPU has passed the ticket of their submission
+struct PendingResidencyChange
+{
+    std::uint32_t   BufferID { 0U };
+    std::uint32_t   Level { 0U };
+    ImageAllocation Allocation {};
+    UploadTicket    Ticket {};
+};
+
+// Ring slice handed to an upload, reclaimed in order once released and the GPU has passed its ticket
+struct StagingRingEntry
+{
+    VkDeviceSize Begin { 0U };
+    UploadTicket Ticket {};
+    bool         IsReleased { false };
+};
+
+// Dedicated staging buffer released by its owner while the GPU may still read from it
+struct DeferredStagingBuffer
+{
+    VkBuffer      Buffer { VK_NULL_HANDLE };
+    VmaAllocation Allocation { VK_NULL_HANDLE };
+    UploadTicket  Ticket {};
+};
+
 VmaPool      g_StagingBufferPool { VK_NULL_HANDLE };
 VmaPool      g_DescriptorBufferPool { VK_NULL_HANDLE };
 VmaPool      g_BufferPool { VK_NULL_HANDLE };
 VmaPool      g_ImagePool { VK_NULL_HANDLE };
 VmaAllocator g_Allocator { VK_NULL_HANDLE };
 
-BufferAllocation g_BufferAllocation {};
+BufferAllocation                   g_StagingRing {};
+VkDeviceSize                       g_StagingRingHead { 0U };
+std::deque<StagingRingEntry>       g_StagingRingEntries {};
+std::vector<DeferredStagingBuffer> g_DeferredStagingBuffers {};
+std::mutex                         g_StagingRingMutex {};
+std::array<std::uint32_t, 2U>      g_StagingQueueFamilyIndices {};
+
+std::vector<std::shared_ptr<GeometryHeapPage>>          g_GeometryHeapPages {};
+std::unordered_map<MeshGeometry const *, GeometryRange> g_GeometryRanges {};
+std::mutex                                              g_GeometryHeapMutex {};
+VertexFormat                                            g_VertexFormat { VertexFormat::Full };
+
+// Objects keep their model slot and instance range while loaded, so adding or removing one never moves the others
+BufferAllocation                                   g_ModelUniformAllocation {};
+VkDeviceSize                                       g_ModelUniformStride { 0U };
+std::uint32_t                                      g_ModelSlotCapacity { 0U };
+std::uint32_t                                      g_NumModelSlots { 0U };
+std::vector<std::uint32_t>                         g_FreeModelSlots {};
+BufferAllocation                                   g_ModelInstanceAllocation {};
+VmaVirtualBlock                                    g_ModelInstanceBlock { VK_NULL_HANDLE };
+std::unordered_map<Object *, VmaVirtualAllocation> g_ModelInstanceRanges {};
+VkDeviceAddress                                    g_ModelInstanceAddress { 0U };
 
 std::atomic<std::uint64_t>                         g_ImageAllocationIDCounter { 0U };
 std::unordered_map<std::uint32_t, ImageAllocation> g_AllocatedImages {};
 std::unordered_map<std::uint32_t, std::uint32_t>   g_ImageAllocationCounter {};
+std::unordered_map<std::uint64_t, std::uint32_t>   g_TextureContentCache {};
+std::unordered_map<std::uint32_t, std::uint64_t>   g_ImageContentHashes {};
+std::mutex                                         g_ImageAllocationMutex {};
+
+std::unordered_map<std::uint32_t, TextureStreamingSource> g_TextureStreamingSources {};
+std::vector<PendingResidencyChange>                       g_PendingResidencyChanges {};
+std::uint32_t                                             g_ImageHeapIndex { 0U };
+
+// Staging memory is read by copies on both the graphics and the transfer queue, so it is shared by their families when they differ
+VkBufferCreateInfo GetStagingBufferCreateInfo(VkDeviceSize const Size, VkBufferUsageFlags const Usage)
+{
+    bool const IsShared = HasDedicatedTransferQueue();
+
+    return VkBufferCreateInfo {
+            .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+            .size = Size,
+            .usage = Usage,
+            .sharingMode = IsShared ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE,
+            .queueFamilyIndexCount = IsShared ? static_cast<std::uint32_t>(std::size(g_StagingQueueFamilyIndices)) : 0U,
+            .pQueueFamilyIndices = IsShared ? std::data(g_StagingQueueFamilyIndices) : nullptr
+    };
+}
 
 void RenderCore::CreateMemoryAllocator()
 {
@@ -57,8 +165,8 @@ void RenderCore::CreateMemoryAllocator()
     VmaVulkanFunctions const VulkanFunctions { .vkGetInstanceProcAddr = vkGetInstanceProcAddr, .vkGetDeviceProcAddr = vkGetDeviceProcAddr };
 
     VmaAllocatorCreateInfo const AllocatorInfo {
-            .flags = VMA_ALLOCATOR_CREATE_EXTERNALLY_SYNCHRONIZED_BIT | VMA_ALLOCATOR_CREATE_KHR_DEDICATED_ALLOCATION_BIT |
-                     VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT | VMA_ALLOCATOR_CREATE_BUFFER_DEVICE_ADDRESS_BIT,
+            .flags = VMA_ALLOCATOR_CREATE_KHR_DEDICATED_ALLOCATION_BIT | VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT |
+                     VMA_ALLOCATOR_CREATE_BUFFER_DEVICE_ADDRESS_BIT,
             .physicalDevice = PhysicalDevice,
             .device = LogicalDevice,
             .preferredLargeHeapBlockSize = 0U /*Default: 256 MiB*/,
@@ -73,6 +181,8 @@ void RenderCore::CreateMemoryAllocator()
 
     CheckVulkanResult(vmaCreateAllocator(&AllocatorInfo, &g_Allocator));
 
+    g_StagingQueueFamilyIndices = { GetGraphicsQueue().first, GetTransferQueue().first };
+
     {
         // Staging Buffer Pool
         constexpr VmaAllocationCreateInfo AllocationCreateInfo { .flags = g_MapMemoryFlag, .usage = g_StagingMemoryUsage };
@@ -91,6 +201,10 @@ void RenderCore::CreateMemoryAllocator()
 
         CheckVulkanResult(vmaCreatePool(g_Allocator, &PoolCreateInfo, &g_StagingBufferPool));
         vmaSetPoolName(g_Allocator, g_StagingBufferPool, "Staging Buffer Pool");
+
+        g_StagingRing.Size = g_StagingRingSize;
+        CreateBuffer(g_StagingRing.Size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, "STAGING_RING", g_StagingRing.Buffer, g_StagingRing.Allocation);
+        CheckVulkanResult(vmaMapMemory(g_Allocator, g_StagingRing.Allocation, &g_StagingRing.MappedData));
     }
 
     {
@@ -158,22 +272,86 @@ void RenderCore::CreateMemoryAllocator()
         std::uint32_t MemoryType;
         CheckVulkanResult(vmaFindMemoryTypeIndexForImageInfo(g_Allocator, &ImageViewCreateInfo, &AllocationCreateInfo, &MemoryType));
 
-        VmaPoolCreateInfo const PoolCreateInfo { .memoryTypeIndex = MemoryType, .flags = VMA_POOL_CREATE_LINEAR_ALGORITHM_BIT, .priority = 1.F };
+        // Streamed textures are released and recreated in any order, so this pool keeps the default allocator to reuse the freed ranges
+        VmaPoolCreateInfo const PoolCreateInfo { .memoryTypeIndex = MemoryType, .priority = 1.F };
 
         CheckVulkanResult(vmaCreatePool(g_Allocator, &PoolCreateInfo, &g_ImagePool));
         vmaSetPoolName(g_Allocator, g_ImagePool, "Image Pool");
+
+        VkPhysicalDeviceMemoryProperties const *MemoryProperties { nullptr };
+        vmaGetMemoryProperties(g_Allocator, &MemoryProperties);
+        g_ImageHeapIndex = MemoryProperties->memoryTypes[MemoryType].heapIndex;
     }
 }
 
-void RenderCore::ReleaseMemoryResources()
+// Buffers sub-allocated through a virtual block, the block is optional
+void DestroyVirtualBuffer(BufferAllocation &Allocation, VmaVirtualBlock &Block)
+{
+    if (Block != VK_NULL_HANDLE)
+    {
+        vmaClearVirtualBlock(Block);
+        vmaDestroyVirtualBlock(Block);
+        Block = VK_NULL_HANDLE;
+    }
+
+    Allocation.DestroyResources(g_Allocator);
+}
+
+// Old buffers are still read by the frames in flight, so they are only destroyed once those have completed
+void RetireBuffer(BufferAllocation const &Allocation, VmaVirtualBlock const Block = VK_NULL_HANDLE)
 {
-    g_BufferAllocation.DestroyResources(g_Allocator);
+    RetireWithFrames([Allocation, Block]() mutable
+    {
+        DestroyVirtualBuffer(Allocation, Block);
+    });
+}
 
+void RenderCore::ReleaseMemoryResources()
+{
+    g_GeometryRanges.clear();
+    for (std::shared_ptr<GeometryHeapPage> const &PageIter : g_GeometryHeapPages)
+    {
+        DestroyVirtualBuffer(PageIter->Heap, PageIter->Block);
+    }
+    g_GeometryHeapPages.clear();
+    g_ModelUniformAllocation.DestroyResources(g_Allocator);
+    g_ModelSlotCapacity = 0U;
+    g_NumModelSlots     = 0U;
+    g_FreeModelSlots.clear();
+    g_ModelInstanceRanges.clear();
+    DestroyVirtualBuffer(g_ModelInstanceAllocation, g_ModelInstanceBlock);
+    g_ModelInstanceAddress = 0U;
+
+    std::lock_guard Lock { g_ImageAllocationMutex };
     for (auto &ImageIter : g_AllocatedImages | std::views::values)
     {
         ImageIter.DestroyResources(g_Allocator);
     }
     g_AllocatedImages.clear();
+    g_ImageAllocationCounter.clear();
+    g_TextureContentCache.clear();
+    g_ImageContentHashes.clear();
+    g_TextureStreamingSources.clear();
+
+    for (PendingResidencyChange &ChangeIter : g_PendingResidencyChanges)
+    {
+        ChangeIter.Allocation.DestroyResources(g_Allocator);
+    }
+    g_PendingResidencyChanges.clear();
+
+    {
+        std::lock_guard StagingLock { g_StagingRingMutex };
+
+        for (auto const &[Buffer, Allocation, Ticket] : g_DeferredStagingBuffers)
+        {
+            vmaDestroyBuffer(g_Allocator, Buffer, Allocation);
+        }
+
+        g_DeferredStagingBuffers.clear();
+        g_StagingRingEntries.clear();
+        g_StagingRingHead = 0U;
+        g_StagingRing.DestroyResources(g_Allocator);
+    }
 
     vmaDestroyPool(g_Allocator, g_StagingBufferPool);
     g_StagingBufferPool = VK_NULL_HANDLE;
@@ -215,7 +393,7 @@ VmaAllocationInfo RenderCore::CreateBuffer(VkDeviceSize const &     Size,
         AllocationCreateInfo.pool = g_DescriptorBufferPool;
         AllocationCreateInfo.flags |= g_MapMemoryFlag;
     }
-    else if (IsStagingBuffer || Usage & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT || Identifier == "IMGUI_RENDER")
+    else if (IsStagingBuffer || Usage & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT || Identifier == "IMGUI_RENDER" || Identifier == "MODEL_INSTANCE_BUFFER")
     {
         AllocationCreateInfo.flags |= g_MapMemoryFlag;
 
@@ -225,7 +403,9 @@ VmaAllocationInfo RenderCore::CreateBuffer(VkDeviceSize const &     Size,
         }
     }
 
-    VkBufferCreateInfo const BufferCreateInfo { .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO, .size = Size, .usage = Usage };
+    VkBufferCreateInfo const BufferCreateInfo = IsStagingBuffer
+                                                    ? GetStagingBufferCreateInfo(Size, Usage)
+                                                    : VkBufferCreateInfo { .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO, .size = Size, .usage = Usage };
 
     VmaAllocator const &Allocator = GetAllocator();
 
@@ -253,6 +433,193 @@ void RenderCore::CreateUniformBuffers(BufferAllocation &BufferAllocation, VkDevi
     vmaMapMemory(Allocator, BufferAllocation.Allocation, &BufferAllocation.MappedData);
 }
 
+// Only regions already released by their owner and passed by the GPU are reclaimed, nothing is waited here
+void ReclaimStagingRegions()
+{
+    std::erase_if(g_DeferredStagingBuffers,
+                  [](DeferredStagingBuffer const &BufferIter)
+                  {
+                      if (!IsUploadComplete(BufferIter.Ticket))
+                      {
+                          return false;
+                      }
+
+                      vmaDestroyBuffer(g_Allocator, BufferIter.Buffer, BufferIter.Allocation);
+                      return true;
+                  });
+
+    while (!std::empty(g_StagingRingEntries) && g_StagingRingEntries.front().IsReleased && IsUploadComplete(g_StagingRingEntries.front().Ticket))
+    {
+        g_StagingRingEntries.pop_front();
+    }
+
+    if (std::empty(g_StagingRingEntries))
+    {
+        g_StagingRingHead = 0U;
+    }
+}
+
+bool AllocateStagingRange(VkDeviceSize const Size, VkDeviceSize &Offset)
+{
+    if (std::empty(g_StagingRingEntries))
+    {
+        if (Size > g_StagingRing.Size)
+        {
+            return false;
+        }
+
+        Offset = 0U;
+    }
+    else
+    {
+        // Live data spans from the oldest entry to the head, wrapping around the end of the ring when the head is behind it
+        VkDeviceSize const Tail = g_StagingRingEntries.front().Begin;
+
+        if (g_StagingRingHead > Tail && g_StagingRingHead + Size <= g_StagingRing.Size)
+        {
+            Offset = g_StagingRingHead;
+        }
+        else if (g_StagingRingHead > Tail && Size <= Tail)
+        {
+            Offset = 0U;
+        }
+        else if (g_StagingRingHead < Tail && g_StagingRingHead + Size <= Tail)
+        {
+            Offset = g_StagingRingHead;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    g_StagingRingEntries.push_back({ .Begin = Offset });
+    g_StagingRingHead = Offset + Size;
+
+    return true;
+}
+
+bool AcquireStagingRingRegion(VkDeviceSize const Size, StagingRegion &Region)
+{
+    VkDeviceSize Offset { 0U };
+
+    ReclaimStagingRegions();
+
+    if (!AllocateStagingRange(AlignUp(Size, g_TextureStagingAlignment), Offset))
+    {
+        return false;
+    }
+
+    Region = StagingRegion {
+            .Buffer = g_StagingRing.Buffer,
+            .Offset = Offset,
+            .Size = Size,
+            .MappedData = static_cast<unsigned char *>(g_StagingRing.MappedData) + Offset
+    };
+
+    return true;
+}
+
+StagingRegion RenderCore::AcquireStagingRegion(VkDeviceSize const Size)
+{
+    std::vector<UploadTicket> ReleasedTickets {};
+
+    {
+        std::lock_guard Lock { g_StagingRingMutex };
+
+        if (StagingRegion Output {};
+            AcquireStagingRingRegion(Size, Output))
+        {
+            return Output;
+        }
+
+        for (StagingRingEntry const &EntryIter : g_StagingRingEntries)
+        {
+            if (!EntryIter.IsReleased)
+            {
+                break;
+            }
+
+            ReleasedTickets.push_back(EntryIter.Ticket);
+        }
+    }
+
+    // Released slices at the front of the ring only wait for their transfers, which is done unlocked so other threads can keep releasing
+    if (!std::empty(ReleasedTickets))
+    {
+        for (UploadTicket const &TicketIter : ReleasedTickets)
+        {
+            WaitUpload(TicketIter);
+        }
+
+        std::lock_guard Lock { g_StagingRingMutex };
+
+        if (StagingRegion Output {};
+            AcquireStagingRingRegion(Size, Output))
+        {
+            return Output;
+        }
+    }
+
+    // Payloads larger than the ring, or arriving while unreleased uploads still hold it, get their own allocation instead of waiting on their owners
+    StagingRegion Output { .Size = Size };
+
+    VkBufferCreateInfo const BufferCreateInfo = GetStagingBufferCreateInfo(Size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+
+    constexpr VmaAllocationCreateInfo AllocationCreateInfo {
+            .flags = VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT | g_MapMemoryFlag,
+            .usage = g_StagingMemoryUsage
+    };
+
+    VmaAllocationInfo AllocationInfo;
+    CheckVulkanResult(vmaCreateBuffer(g_Allocator, &BufferCreateInfo, &AllocationCreateInfo, &Output.Buffer, &Output.DedicatedAllocation, &AllocationInfo));
+    vmaSetAllocationName(g_Allocator, Output.DedicatedAllocation, "Buffer: STAGING_DEDICATED");
+
+    Output.MappedData = static_cast<unsigned char *>(AllocationInfo.pMappedData);
+
+    return Output;
+}
+
+void RenderCore::FlushStagingRegion(StagingRegion const &Region)
+{
+    if (Region.DedicatedAllocation != VK_NULL_HANDLE)
+    {
+        CheckVulkanResult(vmaFlushAllocation(g_Allocator, Region.DedicatedAllocation, 0U, Region.Size));
+    }
+    else if (Region.Buffer != VK_NULL_HANDLE)
+    {
+        CheckVulkanResult(vmaFlushAllocation(g_Allocator, g_StagingRing.Allocation, Region.Offset, Region.Size));
+    }
+}
+
+// Nothing is waited here, the region is reclaimed by later acquisitions once the GPU has passed the ticket of the upload reading it
+void RenderCore::ReleaseStagingRegion(StagingRegion const &Region, UploadTicket const &Ticket)
+{
+    if (Region.Buffer == VK_NULL_HANDLE)
+    {
+        return;
+    }
+
+    std::lock_guard Lock { g_StagingRingMutex };
+
+    if (Region.DedicatedAllocation != VK_NULL_HANDLE)
+    {
+        g_DeferredStagingBuffers.push_back({ .Buffer = Region.Buffer, .Allocation = Region.DedicatedAllocation, .Ticket = Ticket });
+    }
+    else if (auto const Entry = std::ranges::find_if(g_StagingRingEntries,
+                                                     [&Region](StagingRingEntry const &EntryIter)
+                                                     {
+                                                         return !EntryIter.IsReleased && EntryIter.Begin == Region.Offset;
+                                                     });
+             Entry != std::end(g_StagingRingEntries))
+    {
+        Entry->IsReleased = true;
+        Entry->Ticket     = Ticket;
+    }
+
+    ReclaimStagingRegions();
+}
+
 void RenderCore::CreateImage(VkFormat const &        ImageFormat,
                              VkExtent2D const &      Extent,
                              VkImageTiling const &   Tiling,
@@ -260,14 +627,15 @@ void RenderCore::CreateImage(VkFormat const &        ImageFormat,
                              VmaMemoryUsage const    MemoryUsage,
                              std::string_view const  Identifier,
                              VkImage &               Image,
-                             VmaAllocation &         Allocation)
+                             VmaAllocation &         Allocation,
+                             std::uint32_t const     MipLevels)
 {
     VkImageCreateInfo const ImageViewCreateInfo {
             .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
             .imageType = VK_IMAGE_TYPE_2D,
             .format = ImageFormat,
             .extent = { .width = Extent.width, .height = Extent.height, .depth = 1U },
-            .mipLevels = 1U,
+            .mipLevels = MipLevels,
             .arrayLayers = 1U,
             .samples = g_MSAASamples,
             .tiling = Tiling,
@@ -286,14 +654,18 @@ void RenderCore::CreateImage(VkFormat const &        ImageFormat,
     vmaSetAllocationName(Allocator, Allocation, std::data(std::format("Image: {}", Identifier)));
 }
 
-void RenderCore::CreateImageView(VkImage const &Image, VkFormat const &Format, VkImageAspectFlags const &AspectFlags, VkImageView &ImageView)
+void RenderCore::CreateImageView(VkImage const &           Image,
+                                 VkFormat const &          Format,
+                                 VkImageAspectFlags const &AspectFlags,
+                                 VkImageView &             ImageView,
+                                 std::uint32_t const       MipLevels)
 {
     VkImageViewCreateInfo const ImageViewCreateInfo {
             .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
             .image = Image,
             .viewType = VK_IMAGE_VIEW_TYPE_2D,
             .format = Format,
-            .subresourceRange = { .aspectMask = AspectFlags, .baseMipLevel = 0U, .levelCount = 1U, .baseArrayLayer = 0U, .layerCount = 1U }
+            .subresourceRange = { .aspectMask = AspectFlags, .baseMipLevel = 0U, .levelCount = MipLevels, .baseArrayLayer = 0U, .layerCount = 1U }
     };
 
     VkDevice const &LogicalDevice = GetLogicalDevice();
@@ -302,16 +674,21 @@ void RenderCore::CreateImageView(VkImage const &Image, VkFormat const &Format, V
 
 void RenderCore::CreateTextureImageView(ImageAllocation &Allocation, VkFormat const ImageFormat)
 {
-    CreateImageView(Allocation.Image, ImageFormat, g_ImageAspect, Allocation.View);
+    CreateImageView(Allocation.Image, ImageFormat, g_ImageAspect, Allocation.View, Allocation.MipLevels);
 }
 
-void RenderCore::CopyBufferToImage(VkCommandBuffer const &CommandBuffer, VkBuffer const &Source, VkImage const &Destination, VkExtent2D const &Extent)
+void RenderCore::CopyBufferToImage(VkCommandBuffer const &CommandBuffer,
+                                   VkBuffer const &       Source,
+                                   VkImage const &        Destination,
+                                   VkExtent2D const &     Extent,
+                                   VkDeviceSize const     SourceOffset,
+                                   std::uint32_t const    MipLevel)
 {
     VkBufferImageCopy const BufferImageCopy {
-            .bufferOffset = 0U,
+            .bufferOffset = SourceOffset,
             .bufferRowLength = 0U,
             .bufferImageHeight = 0U,
-            .imageSubresource = { .aspectMask = g_ImageAspect, .mipLevel = 0U, .baseArrayLayer = 0U, .layerCount = 1U },
+            .imageSubresource = { .aspectMask = g_ImageAspect, .mipLevel = MipLevel, .baseArrayLayer = 0U, .layerCount = 1U },
             .imageOffset = { .x = 0U, .y = 0U, .z = 0U },
             .imageExtent = { .width = Extent.width, .height = Extent.height, .depth = 1U }
     };
@@ -319,196 +696,1281 @@ void RenderCore::CopyBufferToImage(VkCommandBuffer const &CommandBuffer, VkBuffe
     vkCmdCopyBufferToImage(CommandBuffer, Source, Destination, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1U, &BufferImageCopy);
 }
 
-std::tuple<std::uint32_t, VkBuffer, VmaAllocation> RenderCore::AllocateTexture(VkCommandBuffer const &CommandBuffer,
-                                                                               unsigned char const *  Data,
-                                                                               std::uint32_t const    Width,
-                                                                               std::uint32_t const    Height,
-                                                                               VkFormat const         ImageFormat,
-                                                                               VkDeviceSize const     AllocationSize)
+std::uint32_t RenderCore::GetTextureMipLevels(VkFormat const Format, VkExtent2D const &Extent)
 {
-    if (std::empty(g_AllocatedImages))
+    // The chain is built with linear blits, formats that cannot be blitted and filtered keep a single level
+    VkFormatProperties FormatProperties {};
+    vkGetPhysicalDeviceFormatProperties(GetPhysicalDevice(), Format, &FormatProperties);
+
+    constexpr VkFormatFeatureFlags RequiredFeatures = VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT |
+                                                      VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+
+    if ((FormatProperties.optimalTilingFeatures & RequiredFeatures) != RequiredFeatures)
     {
-        g_ImageAllocationIDCounter.fetch_sub(g_ImageAllocationIDCounter.load());
+        return 1U;
     }
 
-    std::pair<VkBuffer, VmaAllocation> Output;
-    VmaAllocationInfo StagingInfo = CreateBuffer(AllocationSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, "STAGING_TEXTURE", Output.first, Output.second);
+    return static_cast<std::uint32_t>(std::floor(std::log2(std::max(Extent.width, Extent.height)))) + 1U;
+}
 
-    VmaAllocator const &Allocator = GetAllocator();
+void RenderCore::GenerateMipmaps(VkCommandBuffer const &CommandBuffer, ImageAllocation const &Allocation)
+{
+    VkImageMemoryBarrier2 ImageBarrier {
+            .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .image = Allocation.Image,
+            .subresourceRange = { .aspectMask = g_ImageAspect, .baseMipLevel = 0U, .levelCount = 1U, .baseArrayLayer = 0U, .layerCount = 1U }
+    };
 
-    CheckVulkanResult(vmaMapMemory(Allocator, Output.second, &StagingInfo.pMappedData));
-    std::memcpy(StagingInfo.pMappedData, Data, AllocationSize);
+    VkDependencyInfo const DependencyInfo {
+            .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+            .dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT,
+            .imageMemoryBarrierCount = 1U,
+            .pImageMemoryBarriers = &ImageBarrier
+    };
 
-    ImageAllocation NewAllocation { .Extent = { .width = Width, .height = Height }, .Format = ImageFormat };
+    auto const TransitionLevel = [&](std::uint32_t const Level, VkImageLayout const OldLayout, VkImageLayout const NewLayout)
+    {
+        bool const ToSource = NewLayout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
 
-    CreateImage(ImageFormat,
-                NewAllocation.Extent,
-                g_ImageTiling,
-                VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
-                g_TextureMemoryUsage,
-                "TEXTURE",
-                NewAllocation.Image,
-                NewAllocation.Allocation);
+        ImageBarrier.subresourceRange.baseMipLevel = Level;
+        ImageBarrier.oldLayout                     = OldLayout;
+        ImageBarrier.newLayout                     = NewLayout;
+        ImageBarrier.srcStageMask                  = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+        ImageBarrier.srcAccessMask                 = OldLayout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL ? VK_ACCESS_2_TRANSFER_READ_BIT : VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        ImageBarrier.dstStageMask                  = ToSource ? VK_PIPELINE_STAGE_2_TRANSFER_BIT : VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT;
+        ImageBarrier.dstAccessMask                 = ToSource ? VK_ACCESS_2_TRANSFER_READ_BIT : VK_ACCESS_2_SHADER_READ_BIT;
 
-    RequestImageLayoutTransition<g_UndefinedLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, g_ImageAspect>(CommandBuffer,
-        NewAllocation.Image,
-        NewAllocation.Format);
+        vkCmdPipelineBarrier2(CommandBuffer, &DependencyInfo);
+    };
 
-    CopyBufferToImage(CommandBuffer, Output.first, NewAllocation.Image, NewAllocation.Extent);
+    auto MipWidth  = static_cast<std::int32_t>(Allocation.Extent.width);
+    auto MipHeight = static_cast<std::int32_t>(Allocation.Extent.height);
 
-    RequestImageLayoutTransition<VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL, g_ImageAspect>(CommandBuffer,
-        NewAllocation.Image,
-        NewAllocation.Format);
+    // Each level is downsampled from the previous one, which is released to the shaders as soon as it was read
+    for (std::uint32_t LevelIter = 1U; LevelIter < Allocation.MipLevels; ++LevelIter)
+    {
+        TransitionLevel(LevelIter - 1U, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
 
-    CreateImageView(NewAllocation.Image, NewAllocation.Format, g_ImageAspect, NewAllocation.View);
-    vmaUnmapMemory(Allocator, Output.second);
+        std::int32_t const NextWidth  = std::max(MipWidth / 2, 1);
+        std::int32_t const NextHeight = std::max(MipHeight / 2, 1);
 
-    std::uint32_t const BufferID = g_ImageAllocationIDCounter.fetch_add(1U);
-    g_AllocatedImages.emplace(BufferID, std::move(NewAllocation));
+        VkImageBlit const Blit {
+                .srcSubresource = { .aspectMask = g_ImageAspect, .mipLevel = LevelIter - 1U, .baseArrayLayer = 0U, .layerCount = 1U },
+                .srcOffsets = { { 0, 0, 0 }, { MipWidth, MipHeight, 1 } },
+                .dstSubresource = { .aspectMask = g_ImageAspect, .mipLevel = LevelIter, .baseArrayLayer = 0U, .layerCount = 1U },
+                .dstOffsets = { { 0, 0, 0 }, { NextWidth, NextHeight, 1 } }
+        };
 
-    if (g_ImageAllocationCounter.contains(BufferID))
-    {
-        g_ImageAllocationCounter.at(BufferID) += 1U;
+        vkCmdBlitImage(CommandBuffer,
+                       Allocation.Image,
+                       VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                       Allocation.Image,
+                       VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                       1U,
+                       &Blit,
+                       VK_FILTER_LINEAR);
+
+        TransitionLevel(LevelIter - 1U, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL);
+
+        MipWidth  = NextWidth;
+        MipHeight = NextHeight;
     }
-    else
+
+    TransitionLevel(Allocation.MipLevels - 1U, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL);
+}
+
+std::pair<std::uint32_t, StagingRegion> RenderCore::AllocateTexture(VkCommandBuffer const &CommandBuffer,
+                                                                    unsigned char const *  Data,
+                                                                    std::uint32_t const    Width,
+                                                                    std::uint32_t const    Height,
+                                                                    VkFormat const         ImageFormat,
+                                                                    VkDeviceSize const     AllocationSize)
+{
+    StagingRegion const Staging = AcquireStagingRegion(AllocationSize);
+    std::memcpy(Staging.MappedData, Data, AllocationSize);
+
+    std::uint32_t const BufferID = AllocateTextures(CommandBuffer, Staging, { { .Width = Width, .Height = Height, .Format = ImageFormat } }).front();
+
+    return { BufferID, Staging };
+}
+
+VkExtent2D GetLevelExtent(VkExtent2D const &Extent, std::uint32_t const Level)
+{
+    return VkExtent2D { .width = std::max(Extent.width >> Level, 1U), .height = std::max(Extent.height >> Level, 1U) };
+}
+
+bool HasBoxFilterableTexels(VkFormat const Format)
+{
+    switch (Format)
     {
-        g_ImageAllocationCounter.emplace(BufferID, 1U);
+        case VK_FORMAT_R8G8B8A8_UNORM:
+        case VK_FORMAT_R8G8B8A8_SRGB:
+        case VK_FORMAT_B8G8R8A8_UNORM:
+        case VK_FORMAT_B8G8R8A8_SRGB:
+            return true;
+        default:
+            return false;
     }
+}
+
+bool IsSRGBFormat(VkFormat const Format)
+{
+    return Format == VK_FORMAT_R8G8B8A8_SRGB || Format == VK_FORMAT_B8G8R8A8_SRGB;
+}
 
-    return { BufferID, Output.first, Output.second };
+float DecodeSRGB(std::uint8_t const Value)
+{
+    float const Normalized = static_cast<float>(Value) / 255.F;
+    return Normalized <= 0.04045F ? Normalized / 12.92F : std::pow((Normalized + 0.055F) / 1.055F, 2.4F);
+}
+
+std::uint8_t EncodeSRGB(float const Value)
+{
+    float const Clamped = std::clamp(Value, 0.F, 1.F);
+    float const Encoded = Clamped <= 0.0031308F ? Clamped * 12.92F : 1.055F * std::pow(Clamped, 1.F / 2.4F) - 0.055F;
+    return static_cast<std::uint8_t>(Encoded * 255.F + 0.5F);
 }
 
-void RenderCore::AllocateModelsBuffers(std::vector<std::shared_ptr<Object>> const &Objects)
+// Box filtered stand-in for the levels blitted on the GPU, baked in the mesh cache so streamed levels are read back from the file
+// Color channels of sRGB formats are averaged in linear space, as the blit does, while alpha is always stored linear
+bool RenderCore::BuildTextureLevels(VkFormat const               Format,
+                                    VkExtent2D const &           Extent,
+                                    std::vector<unsigned char> & Levels,
+                                    std::vector<VkDeviceSize> &  LevelOffsets)
 {
-    if (g_BufferAllocation.IsValid())
+    constexpr std::uint32_t TexelSize = 4U;
+
+    std::uint32_t const NumLevels = GetTextureMipLevels(Format, Extent);
+    VkDeviceSize const  BaseSize  = static_cast<VkDeviceSize>(Extent.width) * Extent.height * TexelSize;
+
+    if (!HasBoxFilterableTexels(Format) || NumLevels <= 1U || std::size(Levels) < BaseSize)
+    {
+        return false;
+    }
+
+    bool const              IsSRGB = IsSRGBFormat(Format);
+    std::array<float, 256U> LinearValues {};
+
+    for (std::uint32_t ValueIter = 0U; ValueIter < std::size(LinearValues); ++ValueIter)
     {
-        g_BufferAllocation.DestroyResources(g_Allocator);
+        LinearValues.at(ValueIter) = DecodeSRGB(static_cast<std::uint8_t>(ValueIter));
     }
 
-    std::vector<Vertex>        Vertices;
-    std::vector<std::uint32_t> Indices;
+    Levels.resize(BaseSize);
+    LevelOffsets.assign(1U, 0U);
 
-    for (auto const &ObjectIter : Objects)
+    for (std::uint32_t LevelIter = 1U; LevelIter < NumLevels; ++LevelIter)
     {
-        auto const &Mesh = ObjectIter->GetMesh();
+        VkExtent2D const PreviousExtent = GetLevelExtent(Extent, LevelIter - 1U);
+        VkExtent2D const CurrentExtent  = GetLevelExtent(Extent, LevelIter);
 
-        Mesh->SetVertexOffset(std::size(Vertices) * sizeof(Vertex));
-        Mesh->SetIndexOffset(std::size(Indices) * sizeof(std::uint32_t));
+        VkDeviceSize const PreviousOffset = LevelOffsets.back();
+        VkDeviceSize const CurrentOffset  = std::size(Levels);
+        VkDeviceSize const CurrentSize    = static_cast<VkDeviceSize>(CurrentExtent.width) * CurrentExtent.height * TexelSize;
 
-        Vertices.insert(std::end(Vertices), std::begin(Mesh->GetVertices()), std::end(Mesh->GetVertices()));
-        Indices.insert(std::end(Indices), std::begin(Mesh->GetIndices()), std::end(Mesh->GetIndices()));
+        Levels.resize(CurrentOffset + CurrentSize);
 
-        ObjectIter->MarkAsRenderDirty();
+        unsigned char const *const PreviousData = std::data(Levels) + PreviousOffset;
+        unsigned char *const       CurrentData  = std::data(Levels) + CurrentOffset;
+
+        for (std::uint32_t RowIter = 0U; RowIter < CurrentExtent.height; ++RowIter)
+        {
+            std::uint32_t const Top    = std::min(RowIter * 2U, PreviousExtent.height - 1U) * PreviousExtent.width;
+            std::uint32_t const Bottom = std::min(RowIter * 2U + 1U, PreviousExtent.height - 1U) * PreviousExtent.width;
+
+            for (std::uint32_t ColumnIter = 0U; ColumnIter < CurrentExtent.width; ++ColumnIter)
+            {
+                std::uint32_t const Left  = std::min(ColumnIter * 2U, PreviousExtent.width - 1U);
+                std::uint32_t const Right = std::min(ColumnIter * 2U + 1U, PreviousExtent.width - 1U);
+
+                for (std::uint32_t ChannelIter = 0U; ChannelIter < TexelSize; ++ChannelIter)
+                {
+                    std::array const Samples {
+                            PreviousData[(Top + Left) * TexelSize + ChannelIter],
+                            PreviousData[(Top + Right) * TexelSize + ChannelIter],
+                            PreviousData[(Bottom + Left) * TexelSize + ChannelIter],
+                            PreviousData[(Bottom + Right) * TexelSize + ChannelIter]
+                    };
+
+                    unsigned char &Destination = CurrentData[(RowIter * CurrentExtent.width + ColumnIter) * TexelSize + ChannelIter];
+
+                    if (IsSRGB && ChannelIter < 3U)
+                    {
+                        Destination = EncodeSRGB((LinearValues.at(Samples.at(0U)) + LinearValues.at(Samples.at(1U)) + LinearValues.at(Samples.at(2U)) +
+                                                  LinearValues.at(Samples.at(3U))) * 0.25F);
+                    }
+                    else
+                    {
+                        std::uint32_t const Sum = Samples.at(0U) + Samples.at(1U) + Samples.at(2U) + Samples.at(3U);
+                        Destination             = static_cast<unsigned char>((Sum + 2U) / 4U);
+                    }
+                }
+            }
+        }
+
+        LevelOffsets.push_back(CurrentOffset);
     }
 
-    VkDeviceSize const VertexBufferSize = std::size(Vertices) * sizeof(Vertex);
-    VkDeviceSize const IndexBufferSize  = std::size(Indices) * sizeof(std::uint32_t);
-    VkDeviceSize       UniformOffset    = VertexBufferSize + IndexBufferSize;
+    return true;
+}
 
-    if (VkDeviceSize const MinAlignment = GetPhysicalDeviceProperties().limits.minUniformBufferOffsetAlignment;
-        MinAlignment > 0U)
+// Leaves the source empty when the texture cannot be streamed, such as single level images or chains without stored levels to read back
+void BuildStreamingSource(TextureUploadRegion const &Region, ImageAllocation const &Allocation, TextureStreamingSource &Source)
+{
+    if (std::empty(Region.Data) || std::size(Region.LevelOffsets) != Allocation.MipLevels || Allocation.MipLevels <= 1U)
     {
-        UniformOffset = UniformOffset + MinAlignment - 1U & ~(MinAlignment - 1U);
+        return;
     }
 
-    VmaAllocator const &Allocator  = GetAllocator();
-    VkDeviceSize const  BufferSize = UniformOffset + sizeof(ModelUniformData) * std::size(Objects);
+    Source.Extent       = Allocation.Extent;
+    Source.Format       = Allocation.Format;
+    Source.Data         = Region.Data;
+    Source.DataOwner    = Region.DataOwner;
+    Source.LevelOffsets = Region.LevelOffsets;
+    Source.LevelSizes.resize(std::size(Source.LevelOffsets));
+
+    // Container levels are not necessarily stored in order, each one ends where the next stored level begins
+    for (std::size_t LevelIter = 0U; LevelIter < std::size(Source.LevelOffsets); ++LevelIter)
+    {
+        VkDeviceSize const Offset = Source.LevelOffsets.at(LevelIter);
+        VkDeviceSize       End    = std::size(Source.Data);
 
-    CreateBuffer(BufferSize, g_ModelBufferUsage, "MODEL_UNIFIED_BUFFER", g_BufferAllocation.Buffer, g_BufferAllocation.Allocation);
+        for (VkDeviceSize const OtherOffset : Source.LevelOffsets)
+        {
+            if (OtherOffset > Offset)
+            {
+                End = std::min(End, OtherOffset);
+            }
+        }
 
-    CheckVulkanResult(vmaMapMemory(Allocator, g_BufferAllocation.Allocation, &g_BufferAllocation.MappedData));
-    std::memcpy(g_BufferAllocation.MappedData, std::data(Vertices), VertexBufferSize);
-    std::memcpy(static_cast<char *>(g_BufferAllocation.MappedData) + VertexBufferSize, std::data(Indices), IndexBufferSize);
+        Source.LevelSizes.at(LevelIter) = End - Offset;
+    }
 
-    CheckVulkanResult(vmaFlushAllocation(Allocator, g_BufferAllocation.Allocation, VertexBufferSize, IndexBufferSize));
-    vmaUnmapMemory(Allocator, g_BufferAllocation.Allocation);
+    auto const NumLevels = static_cast<std::uint32_t>(std::size(Source.LevelOffsets));
 
-    for (auto const &ObjectIter : Objects)
+    while (Source.TailLevel + 1U < NumLevels)
     {
-        auto const &Mesh = ObjectIter->GetMesh();
+        VkExtent2D const TailExtent = GetLevelExtent(Source.Extent, Source.TailLevel);
 
-        Mesh->SetIndexOffset(Mesh->GetIndexOffset() + VertexBufferSize);
+        if (std::max(TailExtent.width, TailExtent.height) <= g_TextureStreamingTailSize)
+        {
+            break;
+        }
 
-        ObjectIter->SetUniformOffset(UniformOffset + sizeof(ModelUniformData) * std::distance(std::data(Objects), &ObjectIter));
-        ObjectIter->SetupUniformDescriptor();
+        ++Source.TailLevel;
     }
 }
 
-VkBuffer const &RenderCore::GetAllocationBuffer()
+// Staged size of the levels from the given one to the end of the chain, each level aligned as it is laid out for the upload
+VkDeviceSize GetResidentSize(TextureStreamingSource const &Source, std::uint32_t const Level)
 {
-    return g_BufferAllocation.Buffer;
-}
+    VkDeviceSize Size { 0U };
 
-void *RenderCore::GetAllocationMappedData()
-{
-    return g_BufferAllocation.MappedData;
+    for (std::size_t LevelIter = Level; LevelIter < std::size(Source.LevelSizes); ++LevelIter)
+    {
+        Size += AlignUp(Source.LevelSizes.at(LevelIter), g_TextureStagingAlignment);
+    }
+
+    return Size;
 }
 
-VkDescriptorBufferInfo RenderCore::GetAllocationBufferDescriptor(std::uint32_t const Offset, std::uint32_t const Range)
+std::uint32_t GetRequestedLevel(TextureStreamingSource const &Source, float const Coverage)
 {
-    return VkDescriptorBufferInfo { .buffer = GetAllocationBuffer(), .offset = Offset, .range = Range };
+    if (Coverage <= 0.F)
+    {
+        return Source.TailLevel;
+    }
+
+    // Textures are assumed to span their mesh once, so one texel per covered pixel is enough
+    auto const Size  = static_cast<float>(std::max(Source.Extent.width, Source.Extent.height));
+    auto const Level = static_cast<std::uint32_t>(std::max(std::floor(std::log2(Size / Coverage)), 0.F));
+
+    return std::min(Level, Source.TailLevel);
 }
 
-VkDescriptorImageInfo RenderCore::GetAllocationImageDescriptor(std::uint32_t const Index)
+VkResult CreateTextureImage(ImageAllocation &Allocation, VmaAllocationCreateFlags const Flags)
 {
-    return VkDescriptorImageInfo {
-            .sampler = GetSampler(),
-            .imageView = g_AllocatedImages.at(Index).View,
-            .imageLayout = VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL
+    VkImageCreateInfo const ImageCreateInfo {
+            .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+            .imageType = VK_IMAGE_TYPE_2D,
+            .format = Allocation.Format,
+            .extent = { .width = Allocation.Extent.width, .height = Allocation.Extent.height, .depth = 1U },
+            .mipLevels = Allocation.MipLevels,
+            .arrayLayers = 1U,
+            .samples = g_MSAASamples,
+            .tiling = g_ImageTiling,
+            .usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+            .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+            .initialLayout = g_UndefinedLayout
     };
+
+    VmaAllocationCreateInfo const AllocationCreateInfo { .flags = Flags, .usage = g_TextureMemoryUsage, .pool = g_ImagePool, .priority = 1.F };
+
+    VkResult const Result = vmaCreateImage(g_Allocator, &ImageCreateInfo, &AllocationCreateInfo, &Allocation.Image, &Allocation.Allocation, nullptr);
+
+    if (Result == VK_SUCCESS)
+    {
+        vmaSetAllocationName(g_Allocator, Allocation.Allocation, "Image: TEXTURE");
+    }
+
+    return Result;
 }
 
-void RenderCore::SaveImageToFile(VkImage const &Image, std::string_view const Path, VkExtent2D const &Extent)
+std::vector<std::uint32_t> RenderCore::AllocateTextures(VkCommandBuffer const &           CommandBuffer,
+                                                        StagingRegion const &             Staging,
+                                                        std::vector<TextureUploadRegion> &&Regions)
 {
-    VkBuffer            Buffer;
-    VmaAllocation       Allocation;
-    VkSubresourceLayout Layout;
+    FlushStagingRegion(Staging);
 
-    constexpr std::uint8_t Components { 4U };
+    std::vector<ImageAllocation>        NewAllocations(std::size(Regions));
+    std::vector<TextureStreamingSource> NewSources(std::size(Regions));
+    std::vector<VkImageMemoryBarrier2>  ImageBarriers {};
 
-    auto const &[FamilyIndex, Queue] = GetGraphicsQueue();
+    ImageBarriers.reserve(std::size(Regions));
 
-    VkCommandPool                CommandPool { VK_NULL_HANDLE };
-    std::vector<VkCommandBuffer> CommandBuffer { VK_NULL_HANDLE };
-    InitializeSingleCommandQueue(CommandPool, CommandBuffer, FamilyIndex);
+    for (std::size_t Iterator = 0U; Iterator < std::size(Regions); ++Iterator)
     {
-        VkImageSubresource SubResource { .aspectMask = g_ImageAspect, .mipLevel = 0, .arrayLayer = 0 };
+        TextureUploadRegion const &RegionIter    = Regions.at(Iterator);
+        ImageAllocation &          NewAllocation = NewAllocations.at(Iterator);
 
-        VkDevice const &LogicalDevice = GetLogicalDevice();
-        vkGetImageSubresourceLayout(LogicalDevice, Image, &SubResource, &Layout);
+        NewAllocation.Extent    = { .width = RegionIter.Width, .height = RegionIter.Height };
+        NewAllocation.Format    = RegionIter.Format;
+        NewAllocation.MipLevels = std::empty(RegionIter.LevelOffsets)
+                                      ? GetTextureMipLevels(NewAllocation.Format, NewAllocation.Extent)
+                                      : static_cast<std::uint32_t>(std::size(RegionIter.LevelOffsets));
 
-        VkBufferCreateInfo BufferInfo {
-                .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
-                .size = Layout.size,
-                .usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-                .sharingMode = VK_SHARING_MODE_EXCLUSIVE
-        };
+        BuildStreamingSource(RegionIter, NewAllocation, NewSources.at(Iterator));
+    }
 
-        VmaAllocationCreateInfo AllocationInfo { .usage = VMA_MEMORY_USAGE_CPU_ONLY };
+    for (std::size_t Iterator = 0U; Iterator < std::size(Regions); ++Iterator)
+    {
+        ImageAllocation &       NewAllocation = NewAllocations.at(Iterator);
+        TextureStreamingSource &NewSource     = NewSources.at(Iterator);
+        bool const              IsStreamed    = !std::empty(NewSource.Data);
 
-        vmaCreateBuffer(g_Allocator, &BufferInfo, &AllocationInfo, &Buffer, &Allocation, nullptr);
+        // Streamed textures that do not fit in the budget start without resident levels and are brought in by the residency updates
+        VkResult const Result = CreateTextureImage(NewAllocation, IsStreamed ? VMA_ALLOCATION_CREATE_WITHIN_BUDGET_BIT : 0U);
 
-        VkBufferImageCopy Region {
-                .bufferOffset = 0U,
-                .bufferRowLength = 0U,
-                .bufferImageHeight = 0U,
-                .imageSubresource = { .aspectMask = g_ImageAspect, .mipLevel = 0U, .baseArrayLayer = 0U, .layerCount = 1U },
-                .imageOffset = { 0U, 0U, 0U },
-                .imageExtent = { .width = Extent.width, .height = Extent.height, .depth = 1U }
-        };
+        if (IsStreamed && Result == VK_ERROR_OUT_OF_DEVICE_MEMORY)
+        {
+            NewSource.ResidentLevel = static_cast<std::uint32_t>(std::size(NewSource.LevelOffsets));
+            continue;
+        }
 
-        VkImageMemoryBarrier2 PreCopyBarrier {
-                .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
-                .pNext = nullptr,
-                .srcStageMask = VK_PIPELINE_STAGE_2_NONE,
-                .srcAccessMask = VK_ACCESS_2_NONE,
-                .dstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT,
-                .dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT,
-                .oldLayout = g_UndefinedLayout,
-                .newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-                .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-                .image = Image,
+        CheckVulkanResult(Result);
+
+        ImageBarriers.push_back(MountImageBarrier<g_UndefinedLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, g_ImageAspect>(NewAllocation.Image,
+                                                                                                                          NewAllocation.Format));
+    }
+
+    VkDependencyInfo const DependencyInfo {
+            .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+            .dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT,
+            .imageMemoryBarrierCount = static_cast<std::uint32_t>(std::size(ImageBarriers)),
+            .pImageMemoryBarriers = std::data(ImageBarriers)
+    };
+
+    if (!std::empty(ImageBarriers))
+    {
+        vkCmdPipelineBarrier2(CommandBuffer, &DependencyInfo);
+    }
+
+    for (std::size_t Iterator = 0U; Iterator < std::size(Regions); ++Iterator)
+    {
+        ImageAllocation const &    NewAllocation = NewAllocations.at(Iterator);
+        TextureUploadRegion const &RegionIter    = Regions.at(Iterator);
+
+        if (!NewAllocation.IsValid())
+        {
+            continue;
+        }
+
+        if (std::empty(RegionIter.LevelOffsets))
+        {
+            CopyBufferToImage(CommandBuffer, Staging.Buffer, NewAllocation.Image, NewAllocation.Extent, Staging.Offset + RegionIter.StagingOffset);
+            GenerateMipmaps(CommandBuffer, NewAllocation);
+            continue;
+        }
+
+        // Pre-built chains, such as block compressed data, are copied level by level and never blitted
+        for (std::uint32_t LevelIter = 0U; LevelIter < NewAllocation.MipLevels; ++LevelIter)
+        {
+            CopyBufferToImage(CommandBuffer,
+                              Staging.Buffer,
+                              NewAllocation.Image,
+                              GetLevelExtent(NewAllocation.Extent, LevelIter),
+                              Staging.Offset + RegionIter.StagingOffset + RegionIter.LevelOffsets.at(LevelIter),
+                              LevelIter);
+        }
+
+        RequestImageLayoutTransition<VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL, g_ImageAspect>(CommandBuffer,
+            NewAllocation.Image,
+            NewAllocation.Format);
+    }
+
+    std::vector<std::uint32_t> BufferIDs {};
+    BufferIDs.reserve(std::size(NewAllocations));
+
+    std::lock_guard Lock { g_ImageAllocationMutex };
+
+    if (std::empty(g_AllocatedImages))
+    {
+        g_ImageAllocationIDCounter.fetch_sub(g_ImageAllocationIDCounter.load());
+    }
+
+    for (std::size_t Iterator = 0U; Iterator < std::size(NewAllocations); ++Iterator)
+    {
+        ImageAllocation &NewAllocation = NewAllocations.at(Iterator);
+
+        if (NewAllocation.IsValid())
+        {
+            CreateImageView(NewAllocation.Image, NewAllocation.Format, g_ImageAspect, NewAllocation.View, NewAllocation.MipLevels);
+        }
+
+        std::uint32_t const BufferID = g_ImageAllocationIDCounter.fetch_add(1U);
+        g_AllocatedImages.emplace(BufferID, std::move(NewAllocation));
+        g_ImageAllocationCounter.emplace(BufferID, 1U);
+        BufferIDs.push_back(BufferID);
+
+        if (TextureStreamingSource &NewSource = NewSources.at(Iterator);
+            !std::empty(NewSource.Data))
+        {
+            g_TextureStreamingSources.emplace(BufferID, std::move(NewSource));
+        }
+    }
+
+    return BufferIDs;
+}
+
+void RenderCore::AttachTextureSources(std::vector<std::uint32_t> const &BufferIDs, std::vector<TextureUploadRegion> const &Regions)
+{
+    std::lock_guard Lock { g_ImageAllocationMutex };
+
+    for (std::size_t Iterator = 0U; Iterator < std::size(BufferIDs); ++Iterator)
+    {
+        std::uint32_t const        BufferID   = BufferIDs.at(Iterator);
+        TextureUploadRegion const &RegionIter = Regions.at(Iterator);
+
+        // Images shared with an earlier load already stream from its own source, and a mismatched region cannot describe this image
+        auto const Allocated = g_AllocatedImages.find(BufferID);
+        if (Allocated == std::end(g_AllocatedImages) || !Allocated->second.IsValid() || g_TextureStreamingSources.contains(BufferID) ||
+            Allocated->second.Extent.width != RegionIter.Width || Allocated->second.Extent.height != RegionIter.Height ||
+            Allocated->second.Format != RegionIter.Format)
+        {
+            continue;
+        }
+
+        TextureStreamingSource NewSource {};
+        BuildStreamingSource(RegionIter, Allocated->second, NewSource);
+
+        if (!std::empty(NewSource.Data))
+        {
+            g_TextureStreamingSources.emplace(BufferID, std::move(NewSource));
+        }
+    }
+}
+
+void RenderCore::UpdateTextureResidency(std::unordered_map<std::uint32_t, float> const &ScreenCoverage)
+{
+    struct ResidencyChange
+    {
+        std::uint32_t                                  BufferID { 0U };
+        std::uint32_t                                  Level { 0U };
+        ImageAllocation                                Allocation {};
+        std::vector<VkDeviceSize>                      StagingOffsets {};
+        decltype(g_TextureStreamingSources)::node_type Source {};
+    };
+
+    std::vector<ResidencyChange> Changes {};
+    VkDeviceSize                 StagingSize { 0U };
+
+    {
+        std::lock_guard Lock { g_ImageAllocationMutex };
+
+        if (std::empty(g_TextureStreamingSources))
+        {
+            return;
+        }
+
+        std::array<VmaBudget, VK_MAX_MEMORY_HEAPS> Budgets {};
+        vmaGetHeapBudgets(g_Allocator, std::data(Budgets));
+
+        VmaBudget const &  ImageBudget = Budgets.at(g_ImageHeapIndex);
+        VkDeviceSize const Target      = static_cast<VkDeviceSize>(static_cast<double>(ImageBudget.budget) * g_TextureStreamingBudgetRatio);
+        VkDeviceSize       Usage       = ImageBudget.usage;
+
+        struct ResidencyCandidate
+        {
+            std::uint32_t                 BufferID { 0U };
+            TextureStreamingSource const *Source { nullptr };
+            std::uint32_t                 RequestedLevel { 0U };
+            float                         Coverage { 0.F };
+        };
+
+        std::vector<ResidencyCandidate> Candidates {};
+        Candidates.reserve(std::size(g_TextureStreamingSources));
+
+        for (auto const &[BufferID, Source] : g_TextureStreamingSources)
+        {
+            // Textures with levels still in flight on the transfer queue are evaluated again once they are published
+            if (std::ranges::find(g_PendingResidencyChanges, BufferID, &PendingResidencyChange::BufferID) != std::end(g_PendingResidencyChanges))
+            {
+                continue;
+            }
+
+            auto const  Match    = ScreenCoverage.find(BufferID);
+            float const Coverage = Match != std::end(ScreenCoverage) ? Match->second : 0.F;
+
+            Candidates.push_back({ .BufferID = BufferID, .Source = &Source, .RequestedLevel = GetRequestedLevel(Source, Coverage), .Coverage = Coverage });
+        }
+
+        if (Usage > Target)
+        {
+            // The least covered textures give up their upper levels first, dropping straight to what is requested or one level at a time
+            std::ranges::sort(Candidates,
+                              [](ResidencyCandidate const &Lhs, ResidencyCandidate const &Rhs)
+                              {
+                                  return Lhs.Coverage < Rhs.Coverage;
+                              });
+
+            for (ResidencyCandidate const &CandidateIter : Candidates)
+            {
+                if (Usage <= Target || std::size(Changes) >= g_TextureStreamingMaxUpdates)
+                {
+                    break;
+                }
+
+                TextureStreamingSource const &Source = *CandidateIter.Source;
+
+                if (Source.ResidentLevel >= Source.TailLevel)
+                {
+                    continue;
+                }
+
+                std::uint32_t const Level = std::max(CandidateIter.RequestedLevel, Source.ResidentLevel + 1U);
+
+                Usage -= std::min(Usage, GetResidentSize(Source, Source.ResidentLevel) - GetResidentSize(Source, Level));
+                Changes.push_back({ .BufferID = CandidateIter.BufferID, .Level = Level });
+            }
+        }
+        else
+        {
+            // Missing tails are always uploaded, the upper levels only as far as they fit in the budget
+            std::ranges::sort(Candidates,
+                              [](ResidencyCandidate const &Lhs, ResidencyCandidate const &Rhs)
+                              {
+                                  return Lhs.Coverage > Rhs.Coverage;
+                              });
+
+            for (ResidencyCandidate const &CandidateIter : Candidates)
+            {
+                if (std::size(Changes) >= g_TextureStreamingMaxUpdates)
+                {
+                    break;
+                }
+
+                TextureStreamingSource const &Source = *CandidateIter.Source;
+
+                if (Source.ResidentLevel <= CandidateIter.RequestedLevel)
+                {
+                    continue;
+                }
+
+                VkDeviceSize const ResidentSize = GetResidentSize(Source, Source.ResidentLevel);
+                std::uint32_t      Level        = CandidateIter.RequestedLevel;
+
+                while (Level < Source.TailLevel && Usage + GetResidentSize(Source, Level) - ResidentSize > Target)
+                {
+                    ++Level;
+                }
+
+                if (Level >= Source.ResidentLevel)
+                {
+                    continue;
+                }
+
+                Usage += GetResidentSize(Source, Level) - ResidentSize;
+                Changes.push_back({ .BufferID = CandidateIter.BufferID, .Level = Level });
+            }
+        }
+
+        // Growing images must still fit in the budget when they are created, shrinking ones replace a larger image anyway
+        std::erase_if(Changes,
+                      [](ResidencyChange &ChangeIter)
+                      {
+                          TextureStreamingSource const &Source = g_TextureStreamingSources.at(ChangeIter.BufferID);
+
+                          ChangeIter.Allocation.Extent    = GetLevelExtent(Source.Extent, ChangeIter.Level);
+                          ChangeIter.Allocation.Format    = Source.Format;
+                          ChangeIter.Allocation.MipLevels = static_cast<std::uint32_t>(std::size(Source.LevelOffsets)) - ChangeIter.Level;
+
+                          bool const     IsGrowing = ChangeIter.Level < Source.ResidentLevel;
+                          VkResult const Result    = CreateTextureImage(ChangeIter.Allocation, IsGrowing ? VMA_ALLOCATION_CREATE_WITHIN_BUDGET_BIT : 0U);
+
+                          if (IsGrowing && Result == VK_ERROR_OUT_OF_DEVICE_MEMORY)
+                          {
+                              return true;
+                          }
+
+                          CheckVulkanResult(Result);
+                          return false;
+                      });
+
+        if (std::empty(Changes))
+        {
+            return;
+        }
+
+        // Sources are taken out of the map while their levels are staged without the lock, so a texture released meanwhile cannot free them
+        for (ResidencyChange &ChangeIter : Changes)
+        {
+            ChangeIter.Source = g_TextureStreamingSources.extract(ChangeIter.BufferID);
+
+            TextureStreamingSource const &Source = ChangeIter.Source.mapped();
+
+            for (std::size_t LevelIter = ChangeIter.Level; LevelIter < std::size(Source.LevelSizes); ++LevelIter)
+            {
+                ChangeIter.StagingOffsets.push_back(StagingSize);
+                StagingSize += AlignUp(Source.LevelSizes.at(LevelIter), g_TextureStagingAlignment);
+            }
+        }
+    }
+
+    StagingRegion const Staging = AcquireStagingRegion(StagingSize);
+
+    for (ResidencyChange const &ChangeIter : Changes)
+    {
+        TextureStreamingSource const &Source = ChangeIter.Source.mapped();
+
+        for (std::size_t Iterator = 0U; Iterator < std::size(ChangeIter.StagingOffsets); ++Iterator)
+        {
+            std::size_t const LevelIter = ChangeIter.Level + Iterator;
+
+            std::memcpy(Staging.MappedData + ChangeIter.StagingOffsets.at(Iterator),
+                        std::data(Source.Data) + Source.LevelOffsets.at(LevelIter),
+                        Source.LevelSizes.at(LevelIter));
+        }
+    }
+
+    FlushStagingRegion(Staging);
+
+    TransferCommands Commands = BeginTransferCommands();
+
+    for (ResidencyChange &ChangeIter : Changes)
+    {
+        ImageAllocation &Allocation = ChangeIter.Allocation;
+
+        RequestImageLayoutTransition<g_UndefinedLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, g_ImageAspect>(Commands.CommandBuffer,
+                                                                                                             Allocation.Image,
+                                                                                                             Allocation.Format);
+
+        for (std::uint32_t LevelIter = 0U; LevelIter < Allocation.MipLevels; ++LevelIter)
+        {
+            CopyBufferToImage(Commands.CommandBuffer,
+                              Staging.Buffer,
+                              Allocation.Image,
+                              GetLevelExtent(Allocation.Extent, LevelIter),
+                              Staging.Offset + ChangeIter.StagingOffsets.at(LevelIter),
+                              LevelIter);
+        }
+
+        ReleaseTransferredImage(Commands, Allocation.Image, Allocation.MipLevels);
+        CreateImageView(Allocation.Image, Allocation.Format, g_ImageAspect, Allocation.View, Allocation.MipLevels);
+    }
+
+    // The copies overlap with the frames being rendered, the staging slice is reclaimed by the ring once the transfer completes
+    UploadTicket const Ticket = SubmitTransferCommands(std::move(Commands));
+    ReleaseStagingRegion(Staging, Ticket);
+
+    std::lock_guard Lock { g_ImageAllocationMutex };
+
+    for (ResidencyChange &ChangeIter : Changes)
+    {
+        // A texture released while its levels were staged loses its source here, and its new image is destroyed once the change is published
+        if (g_AllocatedImages.contains(ChangeIter.BufferID))
+        {
+            g_TextureStreamingSources.insert(std::move(ChangeIter.Source));
+        }
+
+        g_PendingResidencyChanges.push_back({
+                .BufferID = ChangeIter.BufferID,
+                .Level = ChangeIter.Level,
+                .Allocation = std::move(ChangeIter.Allocation),
+                .Ticket = Ticket
+        });
+    }
+}
+
+bool RenderCore::PublishTextureResidency()
+{
+    std::vector<PendingResidencyChange> Completed {};
+
+    {
+        std::lock_guard Lock { g_ImageAllocationMutex };
+
+        for (auto Iterator = std::begin(g_PendingResidencyChanges); Iterator != std::end(g_PendingResidencyChanges);)
+        {
+            if (IsUploadComplete(Iterator->Ticket))
+            {
+                Completed.push_back(std::move(*Iterator));
+                Iterator = g_PendingResidencyChanges.erase(Iterator);
+            }
+            else
+            {
+                ++Iterator;
+            }
+        }
+    }
+
+    if (std::empty(Completed))
+    {
+        return false;
+    }
+
+    // Frames in flight may still sample the images being replaced
+    ResetFenceStatus();
+
+    std::lock_guard Lock { g_ImageAllocationMutex };
+
+    for (PendingResidencyChange &ChangeIter : Completed)
+    {
+        auto const Allocated = g_AllocatedImages.find(ChangeIter.BufferID);
+        auto const Source    = g_TextureStreamingSources.find(ChangeIter.BufferID);
+
+        // The texture may have been released while its new levels were uploaded
+        if (Allocated == std::end(g_AllocatedImages) || Source == std::end(g_TextureStreamingSources))
+        {
+            DiscardTransferAcquires(ChangeIter.Allocation.Image);
+            ChangeIter.Allocation.DestroyResources(g_Allocator);
+            continue;
+        }
+
+        DiscardTransferAcquires(Allocated->second.Image);
+        Allocated->second.DestroyResources(g_Allocator);
+        Allocated->second            = ChangeIter.Allocation;
+        Source->second.ResidentLevel = ChangeIter.Level;
+    }
+
+    return true;
+}
+
+bool RenderCore::AcquireCachedTexture(std::uint64_t const ContentHash, VkExtent2D const &Extent, VkFormat const Format, std::uint32_t &BufferID)
+{
+    std::lock_guard Lock { g_ImageAllocationMutex };
+
+    auto const Match = g_TextureContentCache.find(ContentHash);
+    if (Match == std::end(g_TextureContentCache))
+    {
+        return false;
+    }
+
+    // The hash alone is not trusted, a colliding image with another size or format is uploaded on its own
+    if (ImageAllocation const &Allocation = g_AllocatedImages.at(Match->second);
+        Allocation.Extent.width != Extent.width || Allocation.Extent.height != Extent.height || Allocation.Format != Format)
+    {
+        return false;
+    }
+
+    BufferID = Match->second;
+    g_ImageAllocationCounter.at(BufferID) += 1U;
+
+    return true;
+}
+
+void RenderCore::RegisterTextureContent(std::uint32_t const BufferID, std::uint64_t const ContentHash)
+{
+    std::lock_guard Lock { g_ImageAllocationMutex };
+
+    // Concurrent loads may upload the same content, only the first image becomes shareable and the other one lives on its own
+    if (g_TextureContentCache.try_emplace(ContentHash, BufferID).second)
+    {
+        g_ImageContentHashes.emplace(BufferID, ContentHash);
+    }
+}
+
+void RenderCore::RetainTexture(std::uint32_t const BufferID)
+{
+    std::lock_guard Lock { g_ImageAllocationMutex };
+    g_ImageAllocationCounter.at(BufferID) += 1U;
+}
+
+template <typename IndexType>
+void WritePackedIndices(unsigned char *const Destination, std::vector<std::uint32_t> const &Indices)
+{
+    std::ranges::transform(Indices,
+                           reinterpret_cast<IndexType *>(Destination),
+                           [](std::uint32_t const Index)
+                           {
+                               return static_cast<IndexType>(Index);
+                           });
+}
+
+// Each range holds the vertices followed by the indices, aligned to their own width, and then the meshlet data when it was built
+MeshGeometryLayout RenderCore::GetGeometryLayout(VkIndexType const   IndexType,
+                                                 std::uint32_t const NumVertices,
+                                                 std::uint32_t const NumIndices,
+                                                 std::uint32_t const NumMeshlets,
+                                                 std::uint32_t const NumMeshletVertices,
+                                                 std::uint32_t const NumMeshletTriangles)
+{
+    VkDeviceSize const IndexSize = GetIndexTypeSize(IndexType);
+
+    MeshGeometryLayout Layout {
+            .IndexType = IndexType,
+            .NumVertices = NumVertices,
+            .NumIndices = NumIndices,
+            .NumMeshlets = NumMeshlets,
+            .NumMeshletVertices = NumMeshletVertices,
+            .NumMeshletTriangles = NumMeshletTriangles
+    };
+
+    Layout.IndexStart           = AlignUp(static_cast<VkDeviceSize>(NumVertices) * GetVertexStride(), IndexSize);
+    Layout.MeshletStart         = AlignUp(Layout.IndexStart + NumIndices * IndexSize, g_GeometryHeapAlignment);
+    Layout.MeshletVertexStart   = Layout.MeshletStart + static_cast<VkDeviceSize>(NumMeshlets) * sizeof(Meshlet);
+    Layout.MeshletTriangleStart = Layout.MeshletVertexStart + static_cast<VkDeviceSize>(NumMeshletVertices) * sizeof(std::uint32_t);
+    Layout.Size = std::max(Layout.MeshletTriangleStart + static_cast<VkDeviceSize>(NumMeshletTriangles) * sizeof(std::uint32_t), g_GeometryHeapAlignment);
+
+    return Layout;
+}
+
+MeshGeometryLayout RenderCore::GetGeometryLayout(MeshGeometry const &Geometry)
+{
+    if (!std::empty(Geometry.CachedImage))
+    {
+        return Geometry.CachedLayout;
+    }
+
+    return GetGeometryLayout(Geometry.IndexType,
+                             static_cast<std::uint32_t>(std::size(Geometry.Vertices)),
+                             static_cast<std::uint32_t>(std::size(Geometry.Indices)),
+                             static_cast<std::uint32_t>(std::size(Geometry.Meshlets)),
+                             static_cast<std::uint32_t>(std::size(Geometry.MeshletVertices)),
+                             static_cast<std::uint32_t>(std::size(Geometry.MeshletTriangles)));
+}
+
+void RenderCore::WriteGeometryImage(MeshGeometry const &Geometry, unsigned char *const Destination)
+{
+    MeshGeometryLayout const Layout = GetGeometryLayout(Geometry);
+
+    // Images read from the mesh cache already hold the packed data of this session and go to the heap in a single copy
+    if (!std::empty(Geometry.CachedImage))
+    {
+        std::memcpy(Destination, std::data(Geometry.CachedImage), Layout.Size);
+        return;
+    }
+
+    if (g_VertexFormat == VertexFormat::Packed)
+    {
+        std::ranges::transform(Geometry.Vertices, reinterpret_cast<PackedVertex *>(Destination), &PackVertex);
+    }
+    else
+    {
+        std::memcpy(Destination, std::data(Geometry.Vertices), std::size(Geometry.Vertices) * sizeof(Vertex));
+    }
+
+    switch (Geometry.IndexType)
+    {
+        case VK_INDEX_TYPE_UINT8_EXT:
+            WritePackedIndices<std::uint8_t>(Destination + Layout.IndexStart, Geometry.Indices);
+            break;
+        case VK_INDEX_TYPE_UINT16:
+            WritePackedIndices<std::uint16_t>(Destination + Layout.IndexStart, Geometry.Indices);
+            break;
+        default:
+            WritePackedIndices<std::uint32_t>(Destination + Layout.IndexStart, Geometry.Indices);
+            break;
+    }
+
+    if (!std::empty(Geometry.Meshlets))
+    {
+        std::memcpy(Destination + Layout.MeshletStart, std::data(Geometry.Meshlets), std::size(Geometry.Meshlets) * sizeof(Meshlet));
+        std::memcpy(Destination + Layout.MeshletVertexStart,
+                    std::data(Geometry.MeshletVertices),
+                    std::size(Geometry.MeshletVertices) * sizeof(std::uint32_t));
+        std::memcpy(Destination + Layout.MeshletTriangleStart,
+                    std::data(Geometry.MeshletTriangles),
+                    std::size(Geometry.MeshletTriangles) * sizeof(std::uint32_t));
+    }
+}
+
+void WriteGeometry(MeshGeometry &Geometry, GeometryHeapPage const &Page, VkDeviceSize const Offset)
+{
+    MeshGeometryLayout const Layout = GetGeometryLayout(Geometry);
+    WriteGeometryImage(Geometry, static_cast<unsigned char *>(Page.Heap.MappedData) + Offset);
+
+    Geometry.HeapBuffer            = Page.Heap.Buffer;
+    Geometry.HeapAddress           = Page.Address;
+    Geometry.VertexOffset          = Offset;
+    Geometry.IndexOffset           = Offset + Layout.IndexStart;
+    Geometry.MeshletOffset         = Offset + Layout.MeshletStart;
+    Geometry.MeshletVertexOffset   = Offset + Layout.MeshletVertexStart;
+    Geometry.MeshletTriangleOffset = Offset + Layout.MeshletTriangleStart;
+
+    // The heap now holds the only copy needed, so the cache mapping is no longer kept alive by this geometry
+    Geometry.CachedImage = {};
+    Geometry.CachedImageOwner.reset();
+}
+
+std::shared_ptr<GeometryHeapPage> CreateGeometryHeapPage(VkDeviceSize const Size)
+{
+    auto Page       = std::make_shared<GeometryHeapPage>();
+    Page->Heap.Size = Size;
+    CreateBuffer(Size, g_ModelBufferUsage, "MODEL_GEOMETRY_HEAP", Page->Heap.Buffer, Page->Heap.Allocation);
+    CheckVulkanResult(vmaMapMemory(g_Allocator, Page->Heap.Allocation, &Page->Heap.MappedData));
+
+    VkBufferDeviceAddressInfo const BufferDeviceAddressInfo {
+            .sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO,
+            .buffer = Page->Heap.Buffer
+    };
+
+    Page->Address = vkGetBufferDeviceAddress(GetLogicalDevice(), &BufferDeviceAddressInfo);
+
+    VmaVirtualBlockCreateInfo const BlockCreateInfo { .size = Size };
+    CheckVulkanResult(vmaCreateVirtualBlock(&BlockCreateInfo, &Page->Block));
+
+    return Page;
+}
+
+// Must be called with the heap mutex held, a new page twice as large as the last one is added when no page has room for the range
+void ReserveGeometryRange(GeometryRange &Range)
+{
+    VmaVirtualAllocationCreateInfo const AllocationCreateInfo { .size = Range.Size, .alignment = g_GeometryHeapAlignment };
+
+    for (std::shared_ptr<GeometryHeapPage> const &PageIter : g_GeometryHeapPages)
+    {
+        if (vmaVirtualAllocate(PageIter->Block, &AllocationCreateInfo, &Range.Allocation, &Range.Offset) == VK_SUCCESS)
+        {
+            Range.Page = PageIter;
+            return;
+        }
+    }
+
+    VkDeviceSize const LastPageSize = std::empty(g_GeometryHeapPages) ? 0U : g_GeometryHeapPages.back()->Heap.Size;
+
+    Range.Page = CreateGeometryHeapPage(std::max({ g_GeometryHeapInitialSize, LastPageSize * 2U, Range.Size }));
+    CheckVulkanResult(vmaVirtualAllocate(Range.Page->Block, &AllocationCreateInfo, &Range.Allocation, &Range.Offset));
+
+    g_GeometryHeapPages.push_back(Range.Page);
+}
+
+// Must be called with the heap mutex held, once no frame can read the range anymore
+void ReleaseGeometryRange(GeometryRange const &Range)
+{
+    vmaVirtualFree(Range.Page->Block, Range.Allocation);
+
+    // The first page is kept around for the next loads, the ones added later are dropped as soon as they are empty
+    if (Range.Page != g_GeometryHeapPages.front() && vmaIsVirtualBlockEmpty(Range.Page->Block))
+    {
+        std::erase(g_GeometryHeapPages, Range.Page);
+        DestroyVirtualBuffer(Range.Page->Heap, Range.Page->Block);
+    }
+}
+
+void RenderCore::AllocateGeometry(std::vector<std::shared_ptr<Object>> const &Objects)
+{
+    std::vector<GeometryRange> NewRanges {};
+
+    {
+        std::lock_guard Lock { g_GeometryHeapMutex };
+
+        // Meshes instanced by several nodes share their geometry, which is placed only once
+        for (std::shared_ptr<Object> const &ObjectIter : Objects)
+        {
+            std::shared_ptr<MeshGeometry> const &Geometry = ObjectIter->GetMesh()->GetGeometry();
+
+            if (auto const Existing = g_GeometryRanges.find(Geometry.get());
+                Existing != std::end(g_GeometryRanges))
+            {
+                ++Existing->second.NumUsers;
+                continue;
+            }
+
+            GeometryRange Range { .Geometry = Geometry, .Size = GetGeometryLayout(*Geometry).Size, .NumUsers = 1U };
+            ReserveGeometryRange(Range);
+
+            NewRanges.push_back(Range);
+            g_GeometryRanges.emplace(Geometry.get(), std::move(Range));
+        }
+    }
+
+    // Reserved ranges keep their page alive and in place, so they are written and flushed without holding the lock
+    for (GeometryRange const &RangeIter : NewRanges)
+    {
+        WriteGeometry(*RangeIter.Geometry, *RangeIter.Page, RangeIter.Offset);
+        CheckVulkanResult(vmaFlushAllocation(g_Allocator, RangeIter.Page->Heap.Allocation, RangeIter.Offset, RangeIter.Size));
+    }
+}
+
+// Every object is set up against the old buffer, so they are pointed to the new one and write their data again on the next update
+void GrowModelUniformBuffer(std::uint32_t const NumSlots)
+{
+    if (g_ModelUniformStride == 0U)
+    {
+        g_ModelUniformStride = sizeof(ModelUniformData);
+
+        if (VkDeviceSize const MinAlignment = GetPhysicalDeviceProperties().limits.minUniformBufferOffsetAlignment;
+            MinAlignment > 0U)
+        {
+            g_ModelUniformStride = AlignUp(g_ModelUniformStride, MinAlignment);
+        }
+    }
+
+    RetireBuffer(g_ModelUniformAllocation);
+    g_ModelUniformAllocation = {};
+
+    g_ModelSlotCapacity = std::max({ g_ModelSlotCapacity * 2U, NumSlots, g_ModelSlotInitialCapacity });
+    CreateUniformBuffers(g_ModelUniformAllocation, g_ModelUniformStride * g_ModelSlotCapacity, "MODEL_UNIFORM_BUFFER");
+
+    for (std::shared_ptr<Object> const &ObjectIter : GetObjects())
+    {
+        ObjectIter->SetupUniformDescriptor();
+        ObjectIter->MarkAsRenderDirty();
+    }
+}
+
+VkResult AllocateInstanceRange(std::uint32_t const NumInstances, VmaVirtualAllocation &Allocation, VkDeviceSize &Offset)
+{
+    VmaVirtualAllocationCreateInfo const AllocationCreateInfo {
+            .size = NumInstances * sizeof(ModelInstanceData),
+            .alignment = sizeof(ModelInstanceData)
+    };
+
+    return vmaVirtualAllocate(g_ModelInstanceBlock, &AllocationCreateInfo, &Allocation, &Offset);
+}
+
+// Instance data is rewritten from the transforms kept on the CPU, so the ranges are only placed again in the new buffer
+void GrowModelInstanceBuffer(VkDeviceSize const Size)
+{
+    RetireBuffer(g_ModelInstanceAllocation, g_ModelInstanceBlock);
+    g_ModelInstanceAllocation = {};
+    g_ModelInstanceBlock      = VK_NULL_HANDLE;
+
+    constexpr VkBufferUsageFlags InstanceUsage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+
+    g_ModelInstanceAllocation.Size = Size;
+    CreateBuffer(g_ModelInstanceAllocation.Size,
+                 InstanceUsage,
+                 "MODEL_INSTANCE_BUFFER",
+                 g_ModelInstanceAllocation.Buffer,
+                 g_ModelInstanceAllocation.Allocation);
+    CheckVulkanResult(vmaMapMemory(g_Allocator, g_ModelInstanceAllocation.Allocation, &g_ModelInstanceAllocation.MappedData));
+
+    VkBufferDeviceAddressInfo const InstanceAddressInfo {
+            .sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO,
+            .buffer = g_ModelInstanceAllocation.Buffer
+    };
+
+    g_ModelInstanceAddress = vkGetBufferDeviceAddress(GetLogicalDevice(), &InstanceAddressInfo);
+
+    VmaVirtualBlockCreateInfo const BlockCreateInfo { .size = Size };
+    CheckVulkanResult(vmaCreateVirtualBlock(&BlockCreateInfo, &g_ModelInstanceBlock));
+
+    for (auto &[ObjectIter, AllocationIter] : g_ModelInstanceRanges)
+    {
+        std::uint32_t const InstanceCapacity = std::max(ObjectIter->GetNumInstances(), 1U);
+        VkDeviceSize        Offset { 0U };
+
+        CheckVulkanResult(AllocateInstanceRange(InstanceCapacity, AllocationIter, Offset));
+        ObjectIter->SetInstanceRange(static_cast<std::uint32_t>(Offset / sizeof(ModelInstanceData)), InstanceCapacity);
+        ObjectIter->SetupUniformDescriptor();
+        ObjectIter->MarkAsRenderDirty();
+    }
+}
+
+// Geometry was already placed by the loader, so publishing objects only takes a model slot and an instance range for each of them
+void RenderCore::AllocateModels(std::vector<std::shared_ptr<Object>> const &Objects)
+{
+    if (std::uint32_t const NumUsedSlots = g_NumModelSlots - static_cast<std::uint32_t>(std::size(g_FreeModelSlots));
+        NumUsedSlots + std::size(Objects) > g_ModelSlotCapacity)
+    {
+        GrowModelUniformBuffer(NumUsedSlots + static_cast<std::uint32_t>(std::size(Objects)));
+    }
+
+    for (std::shared_ptr<Object> const &ObjectIter : Objects)
+    {
+        std::uint32_t Slot { g_NumModelSlots };
+
+        if (std::empty(g_FreeModelSlots))
+        {
+            ++g_NumModelSlots;
+        }
+        else
+        {
+            Slot = g_FreeModelSlots.back();
+            g_FreeModelSlots.pop_back();
+        }
+
+        std::uint32_t const  InstanceCapacity = std::max(ObjectIter->GetNumInstances(), 1U);
+        VmaVirtualAllocation InstanceAllocation { VK_NULL_HANDLE };
+        VkDeviceSize         InstanceOffset { 0U };
+
+        if (g_ModelInstanceBlock == VK_NULL_HANDLE || AllocateInstanceRange(InstanceCapacity, InstanceAllocation, InstanceOffset) != VK_SUCCESS)
+        {
+            VkDeviceSize const RequiredSize = InstanceCapacity * sizeof(ModelInstanceData);
+            GrowModelInstanceBuffer(std::max({ g_ModelInstanceAllocation.Size * 2U,
+                                               g_ModelInstanceAllocation.Size + RequiredSize * 2U,
+                                               g_ModelSlotInitialCapacity * sizeof(ModelInstanceData) }));
+            CheckVulkanResult(AllocateInstanceRange(InstanceCapacity, InstanceAllocation, InstanceOffset));
+        }
+
+        g_ModelInstanceRanges.emplace(ObjectIter.get(), InstanceAllocation);
+
+        ObjectIter->SetModelSlot(Slot);
+        ObjectIter->SetUniformOffset(static_cast<std::uint32_t>(g_ModelUniformStride * Slot));
+        ObjectIter->SetInstanceRange(static_cast<std::uint32_t>(InstanceOffset / sizeof(ModelInstanceData)), InstanceCapacity);
+        ObjectIter->SetupUniformDescriptor();
+        ObjectIter->MarkAsRenderDirty();
+    }
+}
+
+void RenderCore::RetireModels(std::vector<std::shared_ptr<Object>> &&Objects)
+{
+    // The objects are kept alive with their meshes and textures until no frame in flight can read their slots or geometry anymore
+    RetireWithFrames([Objects = std::move(Objects)]
+    {
+        for (std::shared_ptr<Object> const &ObjectIter : Objects)
+        {
+            if (auto const Instance = g_ModelInstanceRanges.find(ObjectIter.get());
+                Instance != std::end(g_ModelInstanceRanges))
+            {
+                vmaVirtualFree(g_ModelInstanceBlock, Instance->second);
+                g_ModelInstanceRanges.erase(Instance);
+                g_FreeModelSlots.push_back(ObjectIter->GetModelSlot());
+            }
+
+            std::lock_guard Lock { g_GeometryHeapMutex };
+
+            if (auto const Range = g_GeometryRanges.find(ObjectIter->GetMesh()->GetGeometry().get());
+                Range != std::end(g_GeometryRanges) && --Range->second.NumUsers == 0U)
+            {
+                ReleaseGeometryRange(Range->second);
+                g_GeometryRanges.erase(Range);
+            }
+        }
+    });
+}
+
+std::uint32_t RenderCore::GetModelSlotCapacity()
+{
+    return g_ModelSlotCapacity;
+}
+
+VertexFormat RenderCore::GetVertexFormat()
+{
+    return g_VertexFormat;
+}
+
+void RenderCore::SetVertexFormat(VertexFormat const Format)
+{
+    g_VertexFormat = Format;
+}
+
+std::uint32_t RenderCore::GetVertexStride()
+{
+    return g_VertexFormat == VertexFormat::Packed ? sizeof(PackedVertex) : sizeof(Vertex);
+}
+
+bool RenderCore::IsMeshShadingEnabled()
+{
+    // The meshlet shaders read the full vertex layout directly through buffer references
+    return IsMeshShaderEnabled() && g_VertexFormat == VertexFormat::Full;
+}
+
+VkBuffer const &RenderCore::GetModelUniformBuffer()
+{
+    return g_ModelUniformAllocation.Buffer;
+}
+
+void *RenderCore::GetModelUniformMappedData()
+{
+    return g_ModelUniformAllocation.MappedData;
+}
+
+VkDescriptorBufferInfo RenderCore::GetModelUniformDescriptor(std::uint32_t const Offset, std::uint32_t const Range)
+{
+    return VkDescriptorBufferInfo { .buffer = GetModelUniformBuffer(), .offset = Offset, .range = Range };
+}
+
+VkBuffer const &RenderCore::GetModelInstanceBuffer()
+{
+    return g_ModelInstanceAllocation.Buffer;
+}
+
+void *RenderCore::GetModelInstanceMappedData()
+{
+    return g_ModelInstanceAllocation.MappedData;
+}
+
+VkDeviceAddress RenderCore::GetModelInstanceBufferAddress()
+{
+    return g_ModelInstanceAddress;
+}
+
+VkDescriptorImageInfo RenderCore::GetAllocationImageDescriptor(std::uint32_t const Index)
+{
+    std::lock_guard Lock { g_ImageAllocationMutex };
+
+    // Streamed textures without any resident level sample the empty texture until the next residency update
+    VkImageView const &View = g_AllocatedImages.at(Index).View;
+
+    return VkDescriptorImageInfo {
+            .sampler = GetSampler(),
+            .imageView = View != VK_NULL_HANDLE ? View : g_AllocatedImages.at(0U).View,
+            .imageLayout = VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL
+    };
+}
+
+void RenderCore::SaveImageToFile(VkImage const &Image, std::string_view const Path, VkExtent2D const &Extent)
+{
+    VkBuffer            Buffer;
+    VmaAllocation       Allocation;
+    VkSubresourceLayout Layout;
+
+    constexpr std::uint8_t Components { 4U };
+
+    VkCommandPool                CommandPool { VK_NULL_HANDLE };
+    std::vector<VkCommandBuffer> CommandBuffer { VK_NULL_HANDLE };
+    InitializeSingleCommandQueue(CommandPool, CommandBuffer, GetGraphicsQueue().first);
+    {
+        VkImageSubresource SubResource { .aspectMask = g_ImageAspect, .mipLevel = 0, .arrayLayer = 0 };
+
+        VkDevice const &LogicalDevice = GetLogicalDevice();
+        vkGetImageSubresourceLayout(LogicalDevice, Image, &SubResource, &Layout);
+
+        VkBufferCreateInfo BufferInfo {
+                .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+                .size = Layout.size,
+                .usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                .sharingMode = VK_SHARING_MODE_EXCLUSIVE
+        };
+
+        VmaAllocationCreateInfo AllocationInfo { .usage = VMA_MEMORY_USAGE_CPU_ONLY };
+
+        vmaCreateBuffer(g_Allocator, &BufferInfo, &AllocationInfo, &Buffer, &Allocation, nullptr);
+
+        VkBufferImageCopy Region {
+                .bufferOffset = 0U,
+                .bufferRowLength = 0U,
+                .bufferImageHeight = 0U,
+                .imageSubresource = { .aspectMask = g_ImageAspect, .mipLevel = 0U, .baseArrayLayer = 0U, .layerCount = 1U },
+                .imageOffset = { 0U, 0U, 0U },
+                .imageExtent = { .width = Extent.width, .height = Extent.height, .depth = 1U }
+        };
+
+        VkImageMemoryBarrier2 PreCopyBarrier {
+                .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+                .pNext = nullptr,
+                .srcStageMask = VK_PIPELINE_STAGE_2_NONE,
+                .srcAccessMask = VK_ACCESS_2_NONE,
+                .dstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT,
+                .dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT,
+                .oldLayout = g_UndefinedLayout,
+                .newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                .image = Image,
                 .subresourceRange = { .aspectMask = g_ImageAspect, .baseMipLevel = 0U, .levelCount = 1U, .baseArrayLayer = 0U, .layerCount = 1U }
         };
 
@@ -539,7 +2001,7 @@ void RenderCore::SaveImageToFile(VkImage const &Image, std::string_view const Pa
         DependencyInfo.pImageMemoryBarriers = &PostCopyBarrier;
         vkCmdPipelineBarrier2(CommandBuffer.back(), &DependencyInfo);
     }
-    FinishSingleCommandQueue(Queue, CommandPool, CommandBuffer);
+    FinishSingleCommandQueue(CommandPool, CommandBuffer);
 
     void *ImageData;
     vmaMapMemory(g_Allocator, Allocation, &ImageData);
@@ -555,13 +2017,33 @@ void RenderCore::SaveImageToFile(VkImage const &Image, std::string_view const Pa
 void TextureDeleter::operator()(Texture const *const Texture) const
 {
     std::uint32_t const BufferIndex = Texture->GetBufferIndex();
+    delete Texture;
+
+    std::lock_guard Lock { g_ImageAllocationMutex };
+
+    // Images released by ReleaseMemoryResources are already gone when the last textures expire
+    if (!g_ImageAllocationCounter.contains(BufferIndex))
+    {
+        return;
+    }
+
     g_ImageAllocationCounter.at(BufferIndex) -= 1U;
 
     if (g_ImageAllocationCounter.at(BufferIndex) == 0U)
     {
+        DiscardTransferAcquires(g_AllocatedImages.at(BufferIndex).Image);
         g_AllocatedImages.at(BufferIndex).DestroyResources(g_Allocator);
         g_AllocatedImages.erase(BufferIndex);
         g_ImageAllocationCounter.erase(BufferIndex);
+
+        g_TextureStreamingSources.erase(BufferIndex);
+
+        if (auto const Hash = g_ImageContentHashes.find(BufferIndex);
+            Hash != std::end(g_ImageContentHashes))
+        {
+            g_TextureContentCache.erase(Hash->second);
+            g_ImageContentHashes.erase(Hash);
+        }
     }
 }
 
@@ -0,0 +1,826 @@
+// Author: Lucas Vilas-Boas
+// Year : 2024
+// Repo : https://github.com/lucoiso/vulkan-renderer
+
+module;
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <random>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/log/trivial.hpp>
+#include <glm/ext.hpp>
+
+module RenderCore.Runtime.MeshCache;
+
+import RenderCore.Runtime.Memory;
+import RenderCore.Runtime.Device;
+import RenderCore.Factories.Mesh;
+import RenderCore.Utils.Helpers;
+
+using namespace RenderCore;
+
+constexpr std::array<char, 4U> g_MeshCacheMagic { 'R', 'C', 'M', 'C' };
+constexpr std::uint64_t        g_MeshCacheAlignment { 16U };
+
+// Arrays are mapped straight from the file, so the cache is only valid on little-endian hosts and for element types without padding
+static_assert(std::endian::native == std::endian::little);
+static_assert(sizeof(MeshLOD) == 4U * sizeof(std::uint32_t) + sizeof(float));
+
+// Records are written field by field with fixed widths, never as raw structs, so their layout does not depend on the compiler padding
+struct MeshCacheHeader
+{
+    std::array<char, 4U> Magic {};
+    std::uint32_t        Version { 0U };
+    std::uint64_t        SourceSize { 0U };
+    std::int64_t         SourceTimestamp { 0 };
+    std::uint8_t         IsMeshOptimized { 0U };
+    std::uint8_t         VertexLayout { 0U };
+    std::uint8_t         IsMeshShading { 0U };
+    std::uint8_t         IsIndexTypeUint8 { 0U };
+    std::uint32_t        NumTextures { 0U };
+    std::uint32_t        NumGeometries { 0U };
+    std::uint32_t        NumMeshes { 0U };
+    std::uint32_t        NumDependencies { 0U };
+};
+
+// Stamp of an external file referenced by the source, its URI is relative to the source directory
+struct DependencyRecord
+{
+    std::uint32_t UriSize { 0U };
+    std::uint64_t Size { 0U };
+    std::int64_t  Timestamp { 0 };
+};
+
+struct TextureRecord
+{
+    std::uint32_t Width { 0U };
+    std::uint32_t Height { 0U };
+    std::uint32_t Format { 0U };
+    std::uint32_t NumLevels { 0U };
+    std::uint32_t NameSize { 0U };
+    std::uint32_t UriSize { 0U };
+    std::uint64_t DataSize { 0U };
+    std::uint64_t ContentHash { 0U };
+};
+
+struct GeometryRecord
+{
+    std::uint32_t IndexType { 0U };
+    std::uint32_t NumVertices { 0U };
+    std::uint32_t NumIndices { 0U };
+    std::uint32_t NumMeshlets { 0U };
+    std::uint32_t NumMeshletVertices { 0U };
+    std::uint32_t NumMeshletTriangles { 0U };
+    std::uint32_t NumLODs { 0U };
+};
+    std::uint32_t NumIndices { 0U };
+    std::uint32_t NumLODs { 0U };
+};
+
+struct MeshRecord
+{
+    std::uint32_t                                                            NameSize { 0U };
+    std::uint32_t                                                            GeometryIndex { 0U };
+    std::uint32_t                                                            NumInstances { 0U };
+    std::array<std::int32_t, static_cast<std::uint8_t>(TextureType::Count)> TextureIndices {};
+    glm::vec3                                                                Position {};
+    glm::vec3                                                                Scale {};
+    glm::vec3                                                                Rotation {};
+    Bounds                                                                   MeshBounds {};
+    MaterialData                                                             Material {};
+};
+
+// Serialized sizes of the records above, used to reject counts the file cannot hold
+constexpr std::uint64_t g_TextureRecordSize { 6U * sizeof(std::uint32_t) + 2U * sizeof(std::uint64_t) };
+constexpr std::uint64_t g_GeometryRecordSize { 7U * sizeof(std::uint32_t) };
+constexpr std::uint64_t g_MeshRecordSize { 3U * sizeof(std::uint32_t) + static_cast<std::uint8_t>(TextureType::Count) * sizeof(std::int32_t) +
+                                           (5U * 3U + 4U + 3U + 5U) * sizeof(float) + 2U * sizeof(std::uint8_t) };
+constexpr std::uint64_t g_InstanceRecordSize { 9U * sizeof(float) };
+constexpr std::uint64_t g_DependencyRecordSize { sizeof(std::uint32_t) + sizeof(std::uint64_t) + sizeof(std::int64_t) };
+
+constexpr std::uint64_t AlignCacheOffset(std::uint64_t const Offset)
+{
+    return AlignUp(Offset, g_MeshCacheAlignment);
+}
+
+bool GetSourceStamp(std::filesystem::path const &Path, std::uint64_t &Size, std::int64_t &Timestamp)
+{
+    std::error_code Error {};
+
+    Size = std::filesystem::file_size(Path, Error);
+    if (Error)
+    {
+        return false;
+    }
+
+    Timestamp = std::filesystem::last_write_time(Path, Error).time_since_epoch().count();
+    return !Error;
+}
+
+class MeshCacheReader
+{
+    unsigned char const *m_Data { nullptr };
+    std::uint64_t        m_Size { 0U };
+    std::uint64_t        m_Offset { 0U };
+
+public:
+    MeshCacheReader(void const *const Data, std::uint64_t const Size)
+        : m_Data(static_cast<unsigned char const *>(Data))
+      , m_Size(Size)
+    {
+    }
+
+    template <typename Type>
+        requires std::is_arithmetic_v<Type>
+    [[nodiscard]] bool Read(Type &Output)
+    {
+        if (m_Offset + sizeof(Type) > m_Size)
+        {
+            return false;
+        }
+
+        std::memcpy(&Output, m_Data + m_Offset, sizeof(Type));
+        m_Offset += sizeof(Type);
+        return true;
+    }
+
+    template <glm::length_t Length, glm::qualifier Qualifier>
+    [[nodiscard]] bool Read(glm::vec<Length, float, Qualifier> &Output)
+    {
+        for (glm::length_t ComponentIter = 0; ComponentIter < Length; ++ComponentIter)
+        {
+            if (!Read(Output[ComponentIter]))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    [[nodiscard]] bool ReadString(std::uint32_t const Size, std::string &Output)
+    {
+        if (m_Offset + Size > m_Size)
+        {
+            return false;
+        }
+
+        Output.assign(reinterpret_cast<char const *>(m_Data + m_Offset), Size);
+        m_Offset += Size;
+        return true;
+    }
+
+    [[nodiscard]] std::uint64_t GetRemainingSize() const
+    {
+        return m_Size - m_Offset;
+    }
+
+    template <typename Type>
+    [[nodiscard]] bool ReadArray(std::uint64_t const Count, Type const *&Output)
+    {
+        m_Offset = AlignCacheOffset(m_Offset);
+
+        // Divides instead of multiplying so corrupt counts cannot overflow past the check
+        if (m_Offset > m_Size || Count > (m_Size - m_Offset) / sizeof(Type))
+        {
+            return false;
+        }
+
+        Output = reinterpret_cast<Type const *>(m_Data + m_Offset);
+        m_Offset += Count * sizeof(Type);
+        return true;
+    }
+};
+
+class MeshCacheWriter
+{
+    std::ofstream m_Stream;
+    std::uint64_t m_Offset { 0U };
+
+public:
+    explicit MeshCacheWriter(std::filesystem::path const &Path)
+        : m_Stream(Path, std::ios::binary | std::ios::trunc)
+    {
+    }
+
+    [[nodiscard]] bool IsValid() const
+    {
+        return m_Stream.good();
+    }
+
+    template <typename Type>
+        requires std::is_arithmetic_v<Type>
+    void Write(Type const Value)
+    {
+        WriteBytes(&Value, sizeof(Type));
+    }
+
+    template <glm::length_t Length, glm::qualifier Qualifier>
+    void Write(glm::vec<Length, float, Qualifier> const &Value)
+    {
+        for (glm::length_t ComponentIter = 0; ComponentIter < Length; ++ComponentIter)
+        {
+            Write(Value[ComponentIter]);
+        }
+    }
+
+    void WriteBytes(void const *const Data, std::uint64_t const Size)
+    {
+        m_Stream.write(static_cast<char const *>(Data), static_cast<std::streamsize>(Size));
+        m_Offset += Size;
+    }
+
+    void WriteArray(void const *const Data, std::uint64_t const Size)
+    {
+        constexpr std::array<char, g_MeshCacheAlignment> Padding {};
+
+        std::uint64_t const AlignedOffset = AlignCacheOffset(m_Offset);
+        WriteBytes(std::data(Padding), AlignedOffset - m_Offset);
+        WriteBytes(Data, Size);
+    }
+};
+
+void WriteRecord(MeshCacheWriter &Writer, MeshCacheHeader const &Header)
+{
+    Writer.WriteBytes(std::data(Header.Magic), std::size(Header.Magic));
+    Writer.Write(Header.Version);
+    Writer.Write(Header.SourceSize);
+    Writer.Write(Header.SourceTimestamp);
+    Writer.Write(Header.IsMeshOptimized);
+    Writer.Write(Header.VertexLayout);
+    Writer.Write(Header.IsMeshShading);
+    Writer.Write(Header.IsIndexTypeUint8);
+    Writer.Write(Header.NumTextures);
+    Writer.Write(Header.NumGeometries);
+    Writer.Write(Header.NumMeshes);
+    Writer.Write(Header.NumDependencies);
+}
+
+bool ReadRecord(MeshCacheReader &Reader, MeshCacheHeader &Header)
+{
+    return std::ranges::all_of(Header.Magic,
+                               [&Reader](char &CharacterIter)
+                               {
+                                   return Reader.Read(CharacterIter);
+                               }) &&
+           Reader.Read(Header.Version) && Reader.Read(Header.SourceSize) && Reader.Read(Header.SourceTimestamp) &&
+           Reader.Read(Header.IsMeshOptimized) && Reader.Read(Header.VertexLayout) && Reader.Read(Header.IsMeshShading) &&
+           Reader.Read(Header.IsIndexTypeUint8) && Reader.Read(Header.NumTextures) &&
+           Reader.Read(Header.NumGeometries) && Reader.Read(Header.NumMeshes) && Reader.Read(Header.NumDependencies);
+}
+
+void WriteRecord(MeshCacheWriter &Writer, DependencyRecord const &Record)
+{
+    Writer.Write(Record.UriSize);
+    Writer.Write(Record.Size);
+    Writer.Write(Record.Timestamp);
+}
+
+bool ReadRecord(MeshCacheReader &Reader, DependencyRecord &Record)
+{
+    return Reader.Read(Record.UriSize) && Reader.Read(Record.Size) && Reader.Read(Record.Timestamp);
+}
+
+void WriteRecord(MeshCacheWriter &Writer, TextureRecord const &Record)
+{
+    Writer.Write(Record.Width);
+    Writer.Write(Record.Height);
+    Writer.Write(Record.Format);
+    Writer.Write(Record.NumLevels);
+    Writer.Write(Record.NameSize);
+    Writer.Write(Record.UriSize);
+    Writer.Write(Record.DataSize);
+    Writer.Write(Record.ContentHash);
+}
+
+bool ReadRecord(MeshCacheReader &Reader, TextureRecord &Record)
+{
+    return Reader.Read(Record.Width) && Reader.Read(Record.Height) && Reader.Read(Record.Format) && Reader.Read(Record.NumLevels) &&
+           Reader.Read(Record.NameSize) && Reader.Read(Record.UriSize) && Reader.Read(Record.DataSize) && Reader.Read(Record.ContentHash);
+}
+
+void WriteRecord(MeshCacheWriter &Writer, GeometryRecord const &Record)
+{
+    Writer.Write(Record.IndexType);
+    Writer.Write(Record.NumVertices);
+    Writer.Write(Record.NumIndices);
+    Writer.Write(Record.NumMeshlets);
+    Writer.Write(Record.NumMeshletVertices);
+    Writer.Write(Record.NumMeshletTriangles);
+    Writer.Write(Record.NumLODs);
+}
+
+bool ReadRecord(MeshCacheReader &Reader, GeometryRecord &Record)
+{
+    return Reader.Read(Record.IndexType) && Reader.Read(Record.NumVertices) && Reader.Read(Record.NumIndices) && Reader.Read(Record.NumMeshlets) &&
+           Reader.Read(Record.NumMeshletVertices) && Reader.Read(Record.NumMeshletTriangles) && Reader.Read(Record.NumLODs);
+}
+
+void WriteRecord(MeshCacheWriter &Writer, MeshRecord const &Record)
+{
+    Writer.Write(Record.NameSize);
+    Writer.Write(Record.GeometryIndex);
+    Writer.Write(Record.NumInstances);
+
+    for (std::int32_t const TextureIndex : Record.TextureIndices)
+    {
+        Writer.Write(TextureIndex);
+    }
+
+    Writer.Write(Record.Position);
+    Writer.Write(Record.Scale);
+    Writer.Write(Record.Rotation);
+    Writer.Write(Record.MeshBounds.Min);
+    Writer.Write(Record.MeshBounds.Max);
+
+    Writer.Write(Record.Material.BaseColorFactor);
+    Writer.Write(Record.Material.EmissiveFactor);
+    Writer.Write(Record.Material.MetallicFactor);
+    Writer.Write(Record.Material.RoughnessFactor);
+    Writer.Write(Record.Material.AlphaCutoff);
+    Writer.Write(Record.Material.NormalScale);
+    Writer.Write(Record.Material.OcclusionStrength);
+    Writer.Write(static_cast<std::uint8_t>(Record.Material.AlphaMode));
+    Writer.Write(static_cast<std::uint8_t>(Record.Material.DoubleSided));
+}
+
+bool ReadRecord(MeshCacheReader &Reader, MeshRecord &Record)
+{
+    std::uint8_t AlphaModeValue { 0U };
+    std::uint8_t DoubleSidedValue { 0U };
+
+    bool const Result = Reader.Read(Record.NameSize) && Reader.Read(Record.GeometryIndex) && Reader.Read(Record.NumInstances) &&
+                        std::ranges::all_of(Record.TextureIndices,
+                                            [&Reader](std::int32_t &TextureIndex)
+                                            {
+                                                return Reader.Read(TextureIndex);
+                                            }) &&
+                        Reader.Read(Record.Position) && Reader.Read(Record.Scale) && Reader.Read(Record.Rotation) &&
+                        Reader.Read(Record.MeshBounds.Min) && Reader.Read(Record.MeshBounds.Max) && Reader.Read(Record.Material.BaseColorFactor) &&
+                        Reader.Read(Record.Material.EmissiveFactor) && Reader.Read(Record.Material.MetallicFactor) &&
+                        Reader.Read(Record.Material.RoughnessFactor) && Reader.Read(Record.Material.AlphaCutoff) &&
+                        Reader.Read(Record.Material.NormalScale) && Reader.Read(Record.Material.OcclusionStrength) && Reader.Read(AlphaModeValue) &&
+                        Reader.Read(DoubleSidedValue);
+
+    if (!Result || AlphaModeValue > static_cast<std::uint8_t>(AlphaMode::ALPHA_BLEND))
+    {
+        return false;
+    }
+
+    Record.Material.AlphaMode   = static_cast<AlphaMode>(AlphaModeValue);
+    Record.Material.DoubleSided = DoubleSidedValue != 0U;
+
+    return true;
+}
+
+// Levels may be stored in any order, but sorted by offset each one must hold its expected size before the next one or the end of the payload begins
+bool AreTextureLevelsValid(TextureRecord const &Record, VkDeviceSize const *const LevelOffsets)
+{
+    std::vector<std::pair<VkDeviceSize, VkDeviceSize>> Levels {};
+    Levels.reserve(Record.NumLevels);
+
+    for (std::uint32_t LevelIter = 0U; LevelIter < Record.NumLevels; ++LevelIter)
+    {
+        VkDeviceSize const LevelSize = GetImageLevelSize(static_cast<VkFormat>(Record.Format),
+                                                         std::max(Record.Width >> LevelIter, 1U),
+                                                         std::max(Record.Height >> LevelIter, 1U));
+        if (LevelSize == 0U)
+        {
+            return false;
+        }
+
+        Levels.emplace_back(LevelOffsets[LevelIter], LevelSize);
+    }
+
+    std::ranges::sort(Levels);
+
+    for (std::size_t LevelIter = 0U; LevelIter < std::size(Levels); ++LevelIter)
+    {
+        auto const &[Offset, Size] = Levels.at(LevelIter);
+        VkDeviceSize const End     = LevelIter + 1U < std::size(Levels) ? Levels.at(LevelIter + 1U).first : Record.DataSize;
+
+        if (Offset >= End || Size > End - Offset)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <typename IndexType>
+bool AreIndicesValid(unsigned char const *const Data, std::uint32_t const NumIndices, std::uint32_t const NumVertices)
+{
+    for (std::uint32_t IndexIter = 0U; IndexIter < NumIndices; ++IndexIter)
+    {
+        IndexType Index {};
+        std::memcpy(&Index, Data + IndexIter * sizeof(IndexType), sizeof(IndexType));
+
+        if (Index >= NumVertices)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// The image goes to the GPU untouched, so every index, LOD and meshlet range it holds is checked against the counts of its record
+bool IsGeometryValid(CachedGeometry const &Geometry)
+{
+    MeshGeometryLayout const & Layout = Geometry.Layout;
+    unsigned char const *const Image  = Geometry.Image;
+
+    bool const AreIndexRangesValid = [&]
+    {
+        switch (Layout.IndexType)
+        {
+            case VK_INDEX_TYPE_UINT8_EXT:
+                return AreIndicesValid<std::uint8_t>(Image + Layout.IndexStart, Layout.NumIndices, Layout.NumVertices);
+            case VK_INDEX_TYPE_UINT16:
+                return AreIndicesValid<std::uint16_t>(Image + Layout.IndexStart, Layout.NumIndices, Layout.NumVertices);
+            default:
+                return AreIndicesValid<std::uint32_t>(Image + Layout.IndexStart, Layout.NumIndices, Layout.NumVertices);
+        }
+    }();
+
+    if (!AreIndexRangesValid || !AreIndicesValid<std::uint32_t>(Image + Layout.MeshletVertexStart, Layout.NumMeshletVertices, Layout.NumVertices))
+    {
+        return false;
+    }
+
+    if (!std::all_of(Geometry.LODs,
+                     Geometry.LODs + Geometry.NumLODs,
+                     [&Layout](MeshLOD const &LODIter)
+                     {
+                         return static_cast<std::uint64_t>(LODIter.FirstIndex) + LODIter.NumIndices <= Layout.NumIndices &&
+                                static_cast<std::uint64_t>(LODIter.FirstMeshlet) + LODIter.NumMeshlets <= Layout.NumMeshlets;
+                     }))
+    {
+        return false;
+    }
+
+    for (std::uint32_t MeshletIter = 0U; MeshletIter < Layout.NumMeshlets; ++MeshletIter)
+    {
+        Meshlet Cluster {};
+        std::memcpy(&Cluster, Image + Layout.MeshletStart + MeshletIter * sizeof(Meshlet), sizeof(Meshlet));
+
+        if (static_cast<std::uint64_t>(Cluster.VertexOffset) + Cluster.VertexCount > Layout.NumMeshletVertices ||
+            static_cast<std::uint64_t>(Cluster.TriangleOffset) + Cluster.TriangleCount > Layout.NumMeshletTriangles)
+        {
+            return false;
+        }
+
+        for (std::uint32_t TriangleIter = 0U; TriangleIter < Cluster.TriangleCount; ++TriangleIter)
+        {
+            std::uint32_t Triangle { 0U };
+            std::memcpy(&Triangle,
+                        Image + Layout.MeshletTriangleStart + (Cluster.TriangleOffset + TriangleIter) * sizeof(std::uint32_t),
+                        sizeof(std::uint32_t));
+
+            if ((Triangle & 0xFFU) >= Cluster.VertexCount || (Triangle >> 8U & 0xFFU) >= Cluster.VertexCount ||
+                (Triangle >> 16U & 0xFFU) >= Cluster.VertexCount)
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool MeshCache::Open(std::string_view const SourcePath)
+{
+    std::string const CachePath = GetMeshCachePath(SourcePath);
+
+    std::uint64_t SourceSize { 0U };
+    std::int64_t  SourceTimestamp { 0 };
+
+    if (!std::filesystem::exists(CachePath) || !GetSourceStamp(SourcePath, SourceSize, SourceTimestamp))
+    {
+        return false;
+    }
+
+    try
+    {
+        m_File   = boost::interprocess::file_mapping(std::data(CachePath), boost::interprocess::read_only);
+        m_Region = boost::interprocess::mapped_region(m_File, boost::interprocess::read_only);
+    }
+    catch (boost::interprocess::interprocess_exception const &Exception)
+    {
+        BOOST_LOG_TRIVIAL(warning) << "[" << __func__ << "]: Failed to map mesh cache '" << CachePath << "': " << Exception.what();
+        return false;
+    }
+
+    MeshCacheReader Reader { m_Region.get_address(), m_Region.get_size() };
+
+    MeshCacheHeader Header {};
+
+    // Caches baked with other mesh settings hold geometry this session would not produce, so they are rebuilt instead
+    if (!ReadRecord(Reader, Header) || Header.Magic != g_MeshCacheMagic || Header.Version != g_MeshCacheVersion || Header.SourceSize != SourceSize ||
+        Header.SourceTimestamp != SourceTimestamp || Header.IsMeshOptimized != static_cast<std::uint8_t>(IsMeshOptimizationEnabled()) ||
+        Header.VertexLayout != static_cast<std::uint8_t>(GetVertexFormat()) || Header.IsMeshShading != static_cast<std::uint8_t>(IsMeshShadingEnabled()) ||
+        Header.IsIndexTypeUint8 != static_cast<std::uint8_t>(IsIndexTypeUint8Enabled()))
+    {
+        return false;
+    }
+
+    // Every entry starts with its fixed size record, so counts the file cannot hold are rejected before anything is allocated
+    if (Header.NumDependencies * g_DependencyRecordSize + Header.NumTextures * g_TextureRecordSize + Header.NumGeometries * g_GeometryRecordSize +
+        Header.NumMeshes * g_MeshRecordSize > Reader.GetRemainingSize())
+    {
+        return false;
+    }
+
+    // Buffers and images stored next to the source change without touching it, so each one is stamped like the source itself
+    std::filesystem::path const SourceDirectory = std::filesystem::path { SourcePath }.parent_path();
+    for (std::uint32_t DependencyIter = 0U; DependencyIter < Header.NumDependencies; ++DependencyIter)
+    {
+        DependencyRecord Record {};
+        std::string      Uri {};
+
+        std::uint64_t DependencySize { 0U };
+        std::int64_t  DependencyTimestamp { 0 };
+
+        if (!ReadRecord(Reader, Record) || !Reader.ReadString(Record.UriSize, Uri) ||
+            !GetSourceStamp(SourceDirectory / Uri, DependencySize, DependencyTimestamp) || Record.Size != DependencySize ||
+            Record.Timestamp != DependencyTimestamp)
+        {
+            return false;
+        }
+    }
+
+    m_Textures.resize(Header.NumTextures);
+    m_Geometries.resize(Header.NumGeometries);
+    m_Meshes.resize(Header.NumMeshes);
+
+    for (CachedTexture &TextureIter : m_Textures)
+    {
+        TextureRecord Record {};
+
+        if (!ReadRecord(Reader, Record) || !Reader.ReadString(Record.NameSize, TextureIter.Name) || !Reader.ReadString(Record.UriSize, TextureIter.Uri) ||
+            !Reader.ReadArray(Record.DataSize, TextureIter.Data) || !Reader.ReadArray(Record.NumLevels, TextureIter.LevelOffsets))
+        {
+            return false;
+        }
+
+        if (!AreTextureLevelsValid(Record, TextureIter.LevelOffsets))
+        {
+            return false;
+        }
+
+        TextureIter.Width       = Record.Width;
+        TextureIter.Height      = Record.Height;
+        TextureIter.Format      = static_cast<VkFormat>(Record.Format);
+        TextureIter.DataSize    = Record.DataSize;
+        TextureIter.NumLevels   = Record.NumLevels;
+        TextureIter.ContentHash = Record.ContentHash;
+    }
+
+    for (CachedGeometry &GeometryIter : m_Geometries)
+    {
+        GeometryRecord Record {};
+
+        if (!ReadRecord(Reader, Record) || Record.NumLODs == 0U ||
+            (Record.IndexType != VK_INDEX_TYPE_UINT8_EXT && Record.IndexType != VK_INDEX_TYPE_UINT16 && Record.IndexType != VK_INDEX_TYPE_UINT32))
+        {
+            return false;
+        }
+
+        GeometryIter.Layout = GetGeometryLayout(static_cast<VkIndexType>(Record.IndexType),
+                                                Record.NumVertices,
+                                                Record.NumIndices,
+                                                Record.NumMeshlets,
+                                                Record.NumMeshletVertices,
+                                                Record.NumMeshletTriangles);
+
+        if (!Reader.ReadArray(GeometryIter.Layout.Size, GeometryIter.Image) || !Reader.ReadArray(Record.NumLODs, GeometryIter.LODs))
+        {
+            return false;
+        }
+
+        GeometryIter.NumLODs = Record.NumLODs;
+
+        if (!IsGeometryValid(GeometryIter))
+        {
+            return false;
+        }
+    }
+
+    for (CachedMesh &MeshIter : m_Meshes)
+    {
+        MeshRecord Record {};
+
+        if (!ReadRecord(Reader, Record) || !Reader.ReadString(Record.NameSize, MeshIter.Name) || Record.GeometryIndex >= Header.NumGeometries ||
+            Record.NumInstances > Reader.GetRemainingSize() / g_InstanceRecordSize)
+        {
+            return false;
+        }
+
+        MeshIter.InstanceTransforms.resize(Record.NumInstances);
+        for (Transform &InstanceIter : MeshIter.InstanceTransforms)
+        {
+            glm::vec3 Position {};
+            glm::vec3 Scale {};
+            glm::vec3 Rotation {};
+
+            if (!Reader.Read(Position) || !Reader.Read(Scale) || !Reader.Read(Rotation))
+            {
+                return false;
+            }
+
+            InstanceIter.SetPosition(Position);
+            InstanceIter.SetScale(Scale);
+            InstanceIter.SetRotation(Rotation);
+        }
+
+        MeshIter.MeshTransform.SetPosition(Record.Position);
+        MeshIter.MeshTransform.SetScale(Record.Scale);
+        MeshIter.MeshTransform.SetRotation(Record.Rotation);
+
+        MeshIter.MeshBounds     = Record.MeshBounds;
+        MeshIter.Material       = Record.Material;
+        MeshIter.TextureIndices = Record.TextureIndices;
+        MeshIter.GeometryIndex  = Record.GeometryIndex;
+    }
+
+    return true;
+}
+
+std::vector<CachedTexture> const &MeshCache::GetTextures() const
+{
+    return m_Textures;
+}
+
+std::vector<CachedGeometry> const &MeshCache::GetGeometries() const
+{
+    return m_Geometries;
+}
+
+std::vector<CachedMesh> const &MeshCache::GetMeshes() const
+{
+    return m_Meshes;
+}
+
+std::string RenderCore::GetMeshCachePath(std::string_view const SourcePath)
+{
+    return std::string { SourcePath } + std::string { g_MeshCacheExtension };
+}
+
+bool RenderCore::WriteMeshCache(std::string_view const           SourcePath,
+                                std::vector<CachedTexture> const & Textures,
+                                std::vector<CachedGeometry> const &Geometries,
+                                std::vector<CachedMesh> const &    Meshes,
+                                std::vector<std::string> const &   Dependencies)
+{
+    MeshCacheHeader Header {
+            .Magic = g_MeshCacheMagic,
+            .Version = g_MeshCacheVersion,
+            .IsMeshOptimized = static_cast<std::uint8_t>(IsMeshOptimizationEnabled()),
+            .VertexLayout = static_cast<std::uint8_t>(GetVertexFormat()),
+            .IsMeshShading = static_cast<std::uint8_t>(IsMeshShadingEnabled()),
+            .IsIndexTypeUint8 = static_cast<std::uint8_t>(IsIndexTypeUint8Enabled()),
+            .NumTextures = static_cast<std::uint32_t>(std::size(Textures)),
+            .NumGeometries = static_cast<std::uint32_t>(std::size(Geometries)),
+            .NumMeshes = static_cast<std::uint32_t>(std::size(Meshes)),
+            .NumDependencies = static_cast<std::uint32_t>(std::size(Dependencies))
+    };
+
+    if (!GetSourceStamp(SourcePath, Header.SourceSize, Header.SourceTimestamp))
+    {
+        return false;
+    }
+
+    std::filesystem::path const   SourceDirectory = std::filesystem::path { SourcePath }.parent_path();
+    std::vector<DependencyRecord> DependencyRecords(std::size(Dependencies));
+
+    for (std::size_t DependencyIter = 0U; DependencyIter < std::size(Dependencies); ++DependencyIter)
+    {
+        DependencyRecord &Record = DependencyRecords.at(DependencyIter);
+        Record.UriSize           = static_cast<std::uint32_t>(std::size(Dependencies.at(DependencyIter)));
+
+        if (!GetSourceStamp(SourceDirectory / Dependencies.at(DependencyIter), Record.Size, Record.Timestamp))
+        {
+            return false;
+        }
+    }
+
+    std::filesystem::path const CachePath { GetMeshCachePath(SourcePath) };
+
+    // Loads of the same model may bake concurrently from several threads or processes, each one writes its own file and the last rename wins
+    std::filesystem::path TemporaryPath { CachePath };
+    TemporaryPath += std::format(".{:08x}{:016x}.tmp", std::random_device {}(), std::hash<std::thread::id> {}(std::this_thread::get_id()));
+
+    bool IsWritten { false };
+
+    {
+        MeshCacheWriter Writer { TemporaryPath };
+        if (!Writer.IsValid())
+        {
+            BOOST_LOG_TRIVIAL(warning) << "[" << __func__ << "]: Failed to create mesh cache '" << CachePath.string() << "'";
+            return false;
+        }
+
+        WriteRecord(Writer, Header);
+
+        for (std::size_t DependencyIter = 0U; DependencyIter < std::size(Dependencies); ++DependencyIter)
+        {
+            WriteRecord(Writer, DependencyRecords.at(DependencyIter));
+            Writer.WriteBytes(std::data(Dependencies.at(DependencyIter)), std::size(Dependencies.at(DependencyIter)));
+        }
+
+        for (CachedTexture const &TextureIter : Textures)
+        {
+            TextureRecord const Record {
+                    .Width = TextureIter.Width,
+                    .Height = TextureIter.Height,
+                    .Format = static_cast<std::uint32_t>(TextureIter.Format),
+                    .NumLevels = TextureIter.NumLevels,
+                    .NameSize = static_cast<std::uint32_t>(std::size(TextureIter.Name)),
+                    .UriSize = static_cast<std::uint32_t>(std::size(TextureIter.Uri)),
+                    .DataSize = TextureIter.DataSize,
+                    .ContentHash = TextureIter.ContentHash
+            };
+
+            WriteRecord(Writer, Record);
+
+            Writer.WriteBytes(std::data(TextureIter.Name), std::size(TextureIter.Name));
+            Writer.WriteBytes(std::data(TextureIter.Uri), std::size(TextureIter.Uri));
+            Writer.WriteArray(TextureIter.Data, TextureIter.DataSize);
+            Writer.WriteArray(TextureIter.LevelOffsets, TextureIter.NumLevels * sizeof(VkDeviceSize));
+        }
+
+        for (CachedGeometry const &GeometryIter : Geometries)
+        {
+            MeshGeometryLayout const &Layout = GeometryIter.Layout;
+
+            GeometryRecord const Record {
+                    .IndexType = static_cast<std::uint32_t>(Layout.IndexType),
+                    .NumVertices = Layout.NumVertices,
+                    .NumIndices = Layout.NumIndices,
+                    .NumMeshlets = Layout.NumMeshlets,
+                    .NumMeshletVertices = Layout.NumMeshletVertices,
+                    .NumMeshletTriangles = Layout.NumMeshletTriangles,
+                    .NumLODs = GeometryIter.NumLODs
+            };
+
+            WriteRecord(Writer, Record);
+
+            Writer.WriteArray(GeometryIter.Image, Layout.Size);
+            Writer.WriteArray(GeometryIter.LODs, GeometryIter.NumLODs * sizeof(MeshLOD));
+        }
+
+        for (CachedMesh const &MeshIter : Meshes)
+        {
+            MeshRecord const Record {
+                    .NameSize = static_cast<std::uint32_t>(std::size(MeshIter.Name)),
+                    .GeometryIndex = MeshIter.GeometryIndex,
+                    .NumInstances = static_cast<std::uint32_t>(std::size(MeshIter.InstanceTransforms)),
+                    .TextureIndices = MeshIter.TextureIndices,
+                    .Position = MeshIter.MeshTransform.GetPosition(),
+                    .Scale = MeshIter.MeshTransform.GetScale(),
+                    .Rotation = MeshIter.MeshTransform.GetRotation(),
+                    .MeshBounds = MeshIter.MeshBounds,
+                    .Material = MeshIter.Material
+            };
+
+            WriteRecord(Writer, Record);
+
+            Writer.WriteBytes(std::data(MeshIter.Name), std::size(MeshIter.Name));
+
+            for (Transform const &InstanceIter : MeshIter.InstanceTransforms)
+            {
+                Writer.Write(InstanceIter.GetPosition());
+                Writer.Write(InstanceIter.GetScale());
+                Writer.Write(InstanceIter.GetRotation());
+            }
+        }
+
+        IsWritten = Writer.IsValid();
+    }
+
+    std::error_code Error {};
+    if (IsWritten)
+    {
+        std::filesystem::rename(TemporaryPath, CachePath, Error);
+    }
+
+    if (!IsWritten || Error)
+    {
+        std::filesystem::remove(TemporaryPath, Error);
+        return false;
+    }
+
+    return true;
+}
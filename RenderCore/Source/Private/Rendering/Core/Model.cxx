@@ -4,9 +4,18 @@
 
 module;
 
+#include <algorithm>
 #include <filesystem>
 #include <glm/ext.hpp>
+#include <format>
+#include <limits>
+#include <map>
+#include <meshoptimizer.h>
+#include <span>
+#include <string>
 #include <tiny_gltf.h>
+#include <type_traits>
+#include <vector>
 #include <vma/vk_mem_alloc.h>
 
 module RenderCore.Runtime.Model;
@@ -27,124 +36,440 @@ void RenderCore::InsertIndiceInContainer(std::vector<std::uint32_t> &Indices, ti
     }
 }
 
-float const *RenderCore::GetPrimitiveData(std::string_view const &   ID,
-                                          tinygltf::Model const &    Model,
-                                          tinygltf::Primitive const &Primitive,
-                                          std::uint32_t *            NumComponents = nullptr)
+template <typename ComponentType, bool Normalized>
+constexpr float ConvertComponent(ComponentType const Value)
 {
-    if (Primitive.attributes.contains(std::data(ID)))
+    if constexpr (std::is_floating_point_v<ComponentType> || !Normalized)
     {
-        tinygltf::Accessor const &  Accessor   = Model.accessors.at(Primitive.attributes.at(std::data(ID)));
-        tinygltf::BufferView const &BufferView = Model.bufferViews.at(Accessor.bufferView);
-        tinygltf::Buffer const &    Buffer     = Model.buffers.at(BufferView.buffer);
+        return static_cast<float>(Value);
+    }
+    else if constexpr (std::is_signed_v<ComponentType>)
+    {
+        // glTF signed normalization: max(c / (2^(n-1) - 1), -1)
+        return std::max(static_cast<float>(Value) / static_cast<float>(std::numeric_limits<ComponentType>::max()), -1.F);
+    }
+    else
+    {
+        return static_cast<float>(Value) / static_cast<float>(std::numeric_limits<ComponentType>::max());
+    }
+}
+
+template <typename ComponentType, bool Normalized, glm::length_t Length, typename Element, typename Visitor>
+void ConvertAttributeData(AccessorView const &            View,
+                          std::vector<Element> &          Elements,
+                          glm::vec<Length, float> Element::*Member,
+                          glm::vec<Length, float> const & Fill,
+                          Visitor &&                      OnVertex)
+{
+    std::uint32_t const  NumComponents = std::min(View.NumComponents, static_cast<std::uint32_t>(Length));
+    std::uint32_t const  Count         = std::min(View.Count, static_cast<std::uint32_t>(std::size(Elements)));
+    Element *const       Output        = std::data(Elements);
+    unsigned char const *Source        = View.Data;
+
+    for (std::uint32_t Iterator = 0U; Iterator < Count; ++Iterator, Source += View.Stride)
+    {
+        auto const *const       Components = reinterpret_cast<ComponentType const *>(Source);
+        glm::vec<Length, float> Value      = Fill;
 
-        if (NumComponents)
+        for (glm::length_t ComponentIt = 0; ComponentIt < Length; ++ComponentIt)
         {
-            switch (Accessor.type)
+            if (static_cast<std::uint32_t>(ComponentIt) < NumComponents)
             {
-                case TINYGLTF_TYPE_SCALAR:
-                    *NumComponents = 1U;
-                    break;
-                case TINYGLTF_TYPE_VEC2:
-                    *NumComponents = 2U;
-                    break;
-                case TINYGLTF_TYPE_VEC3:
-                    *NumComponents = 3U;
-                    break;
-                case TINYGLTF_TYPE_VEC4:
-                    *NumComponents = 4U;
-                    break;
-                default:
-                    break;
+                Value[ComponentIt] = ConvertComponent<ComponentType, Normalized>(Components[ComponentIt]);
             }
         }
 
-        return reinterpret_cast<float const *>(std::data(Buffer.data) + BufferView.byteOffset + Accessor.byteOffset);
+        Output[Iterator].*Member = Value;
+        OnVertex(Value);
     }
+}
 
-    return nullptr;
+template <typename ComponentType, glm::length_t Length, typename Element, typename Visitor>
+void ConvertAttributeComponents(AccessorView const &            View,
+                                std::vector<Element> &          Elements,
+                                glm::vec<Length, float> Element::*Member,
+                                glm::vec<Length, float> const & Fill,
+                                Visitor &&                      OnVertex)
+{
+    if (View.Normalized)
+    {
+        ConvertAttributeData<ComponentType, true>(View, Elements, Member, Fill, std::forward<Visitor>(OnVertex));
+    }
+    else
+    {
+        ConvertAttributeData<ComponentType, false>(View, Elements, Member, Fill, std::forward<Visitor>(OnVertex));
+    }
 }
 
-void RenderCore::SetVertexAttributes(std::shared_ptr<Mesh> const &Mesh, tinygltf::Model const &Model, tinygltf::Primitive const &Primitive)
+struct NoVertexVisitor
+{
+    void operator()(auto const &) const
+    {
+    }
+};
+
+template <glm::length_t Length, typename Element, typename Visitor = NoVertexVisitor>
+void ConvertAttribute(AccessorView const &            View,
+                      std::vector<Element> &          Elements,
+                      glm::vec<Length, float> Element::*Member,
+                      glm::vec<Length, float> const & Fill,
+                      Visitor &&                      OnVertex = {})
 {
-    std::vector<Vertex> Vertices;
+    // Resolve the component type once so each conversion loop is branch-free and can be vectorized by the compiler
+    switch (View.ComponentType)
     {
-        tinygltf::Accessor const &PositionAccessor = Model.accessors.at(Primitive.attributes.at("POSITION"));
-        Vertices.resize(PositionAccessor.count);
+        case TINYGLTF_COMPONENT_TYPE_FLOAT:
+            ConvertAttributeData<float, false>(View, Elements, Member, Fill, std::forward<Visitor>(OnVertex));
+            break;
+        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+            ConvertAttributeComponents<std::uint8_t>(View, Elements, Member, Fill, std::forward<Visitor>(OnVertex));
+            break;
+        case TINYGLTF_COMPONENT_TYPE_BYTE:
+            ConvertAttributeComponents<std::int8_t>(View, Elements, Member, Fill, std::forward<Visitor>(OnVertex));
+            break;
+        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
+            ConvertAttributeComponents<std::uint16_t>(View, Elements, Member, Fill, std::forward<Visitor>(OnVertex));
+            break;
+        case TINYGLTF_COMPONENT_TYPE_SHORT:
+            ConvertAttributeComponents<std::int16_t>(View, Elements, Member, Fill, std::forward<Visitor>(OnVertex));
+            break;
+        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
+            ConvertAttributeComponents<std::uint32_t>(View, Elements, Member, Fill, std::forward<Visitor>(OnVertex));
+            break;
+        default:
+            break;
     }
+}
+
+ModelBuffers RenderCore::GetModelBuffers(tinygltf::Model const &Model)
+{
+    ModelBuffers Output {};
+    Output.reserve(std::size(Model.buffers));
 
-    const float * PositionData = GetPrimitiveData("POSITION", Model, Primitive);
-    const float * NormalData   = GetPrimitiveData("NORMAL", Model, Primitive);
-    const float * TexCoordData = GetPrimitiveData("TEXCOORD_0", Model, Primitive);
-    std::uint32_t NumColorComponents {};
-    const float * ColorData   = GetPrimitiveData("COLOR_0", Model, Primitive, &NumColorComponents);
-    const float * JointData   = GetPrimitiveData("JOINTS_0", Model, Primitive);
-    const float * WeightData  = GetPrimitiveData("WEIGHTS_0", Model, Primitive);
-    const float * TangentData = GetPrimitiveData("TANGENT", Model, Primitive);
+    for (tinygltf::Buffer const &BufferIter : Model.buffers)
+    {
+        Output.emplace_back(BufferIter.data);
+    }
 
-    bool const HasSkin = JointData && WeightData;
+    return Output;
+}
 
-    for (std::uint32_t Iterator = 0U; Iterator < static_cast<std::uint32_t>(std::size(Vertices)); ++Iterator)
+// The decoders assert on these preconditions instead of failing, so files breaking the extension rules are rejected before reaching them
+bool IsValidMeshoptStream(std::string_view const Mode, std::string_view const Filter, std::size_t const Count, std::size_t const Stride)
+{
+    if (Mode == "ATTRIBUTES")
+    {
+        if (Stride == 0U || Stride % 4U != 0U || Stride > 256U)
+        {
+            return false;
+        }
+    }
+    else if (Mode == "TRIANGLES")
+    {
+        if ((Stride != 2U && Stride != 4U) || Count % 3U != 0U)
+        {
+            return false;
+        }
+    }
+    else if (Mode == "INDICES")
     {
-        if (PositionData)
+        if (Stride != 2U && Stride != 4U)
         {
-            Vertices.at(Iterator).Position = glm::make_vec3(&PositionData[Iterator * 3]);
+            return false;
         }
+    }
+    else
+    {
+        return false;
+    }
 
-        if (NormalData)
+    if (Filter == "NONE")
+    {
+        return true;
+    }
+
+    // Filters only apply to attribute streams
+    if (Mode != "ATTRIBUTES")
+    {
+        return false;
+    }
+
+    if (Filter == "OCTAHEDRAL")
+    {
+        return Stride == 4U || Stride == 8U;
+    }
+
+    if (Filter == "QUATERNION")
+    {
+        return Stride == 8U;
+    }
+
+    if (Filter == "EXPONENTIAL")
+    {
+        return Stride % 4U == 0U;
+    }
+
+    return false;
+}
+
+bool RenderCore::DecodeCompressedBufferViews(tinygltf::Model const &                 Model,
+                                             ModelBuffers &                          Buffers,
+                                             std::vector<std::vector<unsigned char>> &DecodedBuffers,
+                                             std::string &                           Error)
+{
+    // Compressed views decode into their own buffer, which is only allocated when the file carries a fallback stub instead of the raw data
+    std::map<std::int32_t, std::size_t> RequiredSizes {};
+
+    for (tinygltf::BufferView const &ViewIter : Model.bufferViews)
+    {
+        if (ViewIter.extensions.contains("EXT_meshopt_compression"))
         {
-            Vertices.at(Iterator).Normal = glm::make_vec3(&NormalData[Iterator * 3]);
+            std::size_t &RequiredSize = RequiredSizes[ViewIter.buffer];
+            RequiredSize              = std::max(RequiredSize, ViewIter.byteOffset + ViewIter.byteLength);
         }
+    }
+
+    std::erase_if(RequiredSizes,
+                  [&Buffers](auto const &Iterator)
+                  {
+                      return Iterator.first < 0 || Iterator.first >= static_cast<std::int32_t>(std::size(Buffers)) ||
+                             std::size(Buffers.at(Iterator.first)) >= Iterator.second;
+                  });
 
-        if (TexCoordData)
+    if (std::empty(RequiredSizes))
+    {
+        return true;
+    }
+
+    std::map<std::int32_t, unsigned char *> Destinations {};
+
+    DecodedBuffers.reserve(std::size(DecodedBuffers) + std::size(RequiredSizes));
+    for (auto const &[BufferIndex, RequiredSize] : RequiredSizes)
+    {
+        std::vector<unsigned char> &Decoded = DecodedBuffers.emplace_back(RequiredSize);
+        Buffers.at(BufferIndex)             = Decoded;
+        Destinations.emplace(BufferIndex, std::data(Decoded));
+    }
+
+    for (tinygltf::BufferView const &ViewIter : Model.bufferViews)
+    {
+        auto const ExtensionIt = ViewIter.extensions.find("EXT_meshopt_compression");
+        if (ExtensionIt == std::end(ViewIter.extensions) || !Destinations.contains(ViewIter.buffer))
         {
-            Vertices.at(Iterator).TextureCoordinate = glm::make_vec2(&TexCoordData[Iterator * 2]);
+            continue;
         }
 
-        if (ColorData)
+        tinygltf::Value const &Extension = ExtensionIt->second;
+
+        std::int32_t const     SourceBuffer = Extension.Get("buffer").GetNumberAsInt();
+        auto const             SourceOffset = static_cast<std::size_t>(Extension.Get("byteOffset").GetNumberAsInt());
+        auto const             SourceLength = static_cast<std::size_t>(Extension.Get("byteLength").GetNumberAsInt());
+        auto const             Stride       = static_cast<std::size_t>(Extension.Get("byteStride").GetNumberAsInt());
+        auto const             Count        = static_cast<std::size_t>(Extension.Get("count").GetNumberAsInt());
+        tinygltf::Value const &ModeValue    = Extension.Get("mode");
+        tinygltf::Value const &FilterValue  = Extension.Get("filter");
+        std::string const      Mode         = ModeValue.IsString() ? ModeValue.Get<std::string>() : std::string {};
+        std::string const      Filter       = !Extension.Has("filter") ? "NONE" : FilterValue.IsString() ? FilterValue.Get<std::string>() : std::string {};
+
+        if (!IsValidMeshoptStream(Mode, Filter, Count, Stride))
         {
-            switch (NumColorComponents)
-            {
-                case 3U:
-                    Vertices.at(Iterator).Color = glm::vec4(glm::make_vec3(&ColorData[Iterator * 3]), 1.F);
-                    break;
-                case 4U:
-                    Vertices.at(Iterator).Color = glm::make_vec4(&ColorData[Iterator * 4]);
-                    break;
-                default:
-                    break;
-            }
+            Error = std::format("Unsupported EXT_meshopt_compression buffer view with mode '{}', filter '{}' and stride {}", Mode, Filter, Stride);
+            return false;
         }
-        else
+
+        // The stride is known to be non-zero here, so the decoded size is compared without overflowing
+        if (SourceBuffer < 0 || SourceBuffer >= static_cast<std::int32_t>(std::size(Buffers)) ||
+            SourceOffset > std::size(Buffers.at(SourceBuffer)) || SourceLength > std::size(Buffers.at(SourceBuffer)) - SourceOffset ||
+            Count > ViewIter.byteLength / Stride ||
+            ViewIter.byteOffset + Count * Stride > RequiredSizes.at(ViewIter.buffer))
         {
-            Vertices.at(Iterator).Color = glm::vec4(1.F);
+            Error = "Invalid EXT_meshopt_compression buffer view";
+            return false;
         }
 
-        if (HasSkin)
+        unsigned char const *const Source      = std::data(Buffers.at(SourceBuffer)) + SourceOffset;
+        void *const                Destination = Destinations.at(ViewIter.buffer) + ViewIter.byteOffset;
+
+        std::int32_t Result { -1 };
+
+        if (Mode == "ATTRIBUTES")
+        {
+            Result = meshopt_decodeVertexBuffer(Destination, Count, Stride, Source, SourceLength);
+        }
+        else if (Mode == "TRIANGLES")
+        {
+            Result = meshopt_decodeIndexBuffer(Destination, Count, Stride, Source, SourceLength);
+        }
+        else if (Mode == "INDICES")
         {
-            Vertices.at(Iterator).Joint  = glm::make_vec4(&JointData[Iterator * 4]);
-            Vertices.at(Iterator).Weight = glm::make_vec4(&WeightData[Iterator * 4]);
+            Result = meshopt_decodeIndexSequence(Destination, Count, Stride, Source, SourceLength);
         }
 
-        if (TangentData)
+        if (Result != 0)
         {
-            Vertices.at(Iterator).Tangent = glm::make_vec4(&TangentData[Iterator * 4]);
+            Error = std::format("Failed to decode EXT_meshopt_compression buffer view with mode '{}' ({})", Mode, Result);
+            return false;
+        }
+
+        // Filters are applied in place on top of the decoded stream and leave quantized components in the accessor's own type
+        if (Filter == "OCTAHEDRAL")
+        {
+            meshopt_decodeFilterOct(Destination, Count, Stride);
+        }
+        else if (Filter == "QUATERNION")
+        {
+            meshopt_decodeFilterQuat(Destination, Count, Stride);
+        }
+        else if (Filter == "EXPONENTIAL")
+        {
+            meshopt_decodeFilterExp(Destination, Count, Stride);
+        }
+    }
+
+    return true;
+}
+
+AccessorView RenderCore::GetAccessorView(std::string_view const     ID,
+                                         tinygltf::Model const &    Model,
+                                         ModelBuffers const &       Buffers,
+                                         tinygltf::Primitive const &Primitive)
+{
+    auto const AttributeIt = Primitive.attributes.find(std::string { ID });
+    if (AttributeIt == std::end(Primitive.attributes))
+    {
+        return {};
+    }
+
+    return GetAccessorView(Model, Buffers, AttributeIt->second);
+}
+
+AccessorView RenderCore::GetAccessorView(tinygltf::Model const &Model, ModelBuffers const &Buffers, std::int32_t const AccessorIndex)
+{
+    if (AccessorIndex < 0 || AccessorIndex >= static_cast<std::int32_t>(std::size(Model.accessors)))
+    {
+        return {};
+    }
+
+    tinygltf::Accessor const &Accessor = Model.accessors.at(AccessorIndex);
+    if (Accessor.bufferView < 0 || Accessor.bufferView >= static_cast<std::int32_t>(std::size(Model.bufferViews)))
+    {
+        return {};
+    }
+
+    tinygltf::BufferView const &BufferView = Model.bufferViews.at(Accessor.bufferView);
+    if (BufferView.buffer < 0 || BufferView.buffer >= static_cast<std::int32_t>(std::size(Buffers)))
+    {
+        return {};
+    }
+
+    std::span<unsigned char const> const Buffer = Buffers.at(BufferView.buffer);
+    if (BufferView.byteOffset > std::size(Buffer) || BufferView.byteLength > std::size(Buffer) - BufferView.byteOffset)
+    {
+        return {};
+    }
+
+    // Returns byteStride when the view is interleaved, otherwise the packed size of one element
+    std::int32_t const ByteStride    = Accessor.ByteStride(BufferView);
+    std::int32_t const NumComponents = tinygltf::GetNumComponentsInType(static_cast<std::uint32_t>(Accessor.type));
+    std::int32_t const ComponentSize = tinygltf::GetComponentSizeInBytes(static_cast<std::uint32_t>(Accessor.componentType));
+    if (ByteStride <= 0 || NumComponents <= 0 || ComponentSize <= 0)
+    {
+        return {};
+    }
+
+    // The last element only needs its own size to fit in the view, not a whole stride
+    if (Accessor.count > 0U)
+    {
+        std::size_t const LastElement = Accessor.byteOffset + (Accessor.count - 1U) * static_cast<std::size_t>(ByteStride);
+        if (Accessor.byteOffset > BufferView.byteLength || LastElement + static_cast<std::size_t>(NumComponents * ComponentSize) > BufferView.byteLength)
+        {
+            return {};
+        }
+    }
+
+    return AccessorView {
+            .Data = std::data(Buffer) + BufferView.byteOffset + Accessor.byteOffset,
+            .Stride = static_cast<std::size_t>(ByteStride),
+            .Count = static_cast<std::uint32_t>(Accessor.count),
+            .NumComponents = static_cast<std::uint32_t>(NumComponents),
+            .ComponentType = Accessor.componentType,
+            .Normalized = Accessor.normalized
+    };
+}
+
+void RenderCore::SetVertexAttributes(std::shared_ptr<Mesh> const &Mesh,
+                                     tinygltf::Model const &      Model,
+                                     ModelBuffers const &         Buffers,
+                                     tinygltf::Primitive const &  Primitive)
+{
+    AccessorView const PositionView = GetAccessorView("POSITION", Model, Buffers, Primitive);
+    if (!PositionView.IsValid())
+    {
+        return;
+    }
+
+    std::vector<Vertex> Vertices(PositionView.Count);
+
+    // Bounds are accumulated while positions are converted, so the transform must already be set at this point
+    glm::mat4 const MeshMatrix = Mesh->GetTransform().GetMatrix();
+    Bounds          MeshBounds {};
+
+    ConvertAttribute(PositionView,
+                     Vertices,
+                     &Vertex::Position,
+                     glm::vec3 { 0.F },
+                     [&MeshMatrix, &MeshBounds](glm::vec3 const &Position)
+                     {
+                         glm::vec3 const TransformedVertex { glm::vec4(Position, 1.F) * MeshMatrix };
+
+                         MeshBounds.Min = glm::min(MeshBounds.Min, TransformedVertex);
+                         MeshBounds.Max = glm::max(MeshBounds.Max, TransformedVertex);
+                     });
+
+    ConvertAttribute(GetAccessorView("NORMAL", Model, Buffers, Primitive), Vertices, &Vertex::Normal, glm::vec3 { 0.F });
+    ConvertAttribute(GetAccessorView("TEXCOORD_0", Model, Buffers, Primitive), Vertices, &Vertex::TextureCoordinate, glm::vec2 { 0.F });
+    ConvertAttribute(GetAccessorView("TANGENT", Model, Buffers, Primitive), Vertices, &Vertex::Tangent, glm::vec4 { 0.F });
+
+    if (AccessorView const ColorView = GetAccessorView("COLOR_0", Model, Buffers, Primitive);
+        ColorView.IsValid())
+    {
+        // RGB colors keep an opaque alpha
+        ConvertAttribute(ColorView, Vertices, &Vertex::Color, glm::vec4 { 1.F });
+    }
+    else
+    {
+        for (Vertex &VertexIter : Vertices)
+        {
+            VertexIter.Color = glm::vec4(1.F);
         }
     }
 
-    Mesh->SetVertices(Vertices);
+    AccessorView const JointView  = GetAccessorView("JOINTS_0", Model, Buffers, Primitive);
+    AccessorView const WeightView = GetAccessorView("WEIGHTS_0", Model, Buffers, Primitive);
+
+    if (JointView.IsValid() && WeightView.IsValid())
+    {
+        ConvertAttribute(JointView, Vertices, &Vertex::Joint, glm::vec4 { 0.F });
+        ConvertAttribute(WeightView, Vertices, &Vertex::Weight, glm::vec4 { 0.F });
+    }
+
+    Mesh->SetVertices(std::move(Vertices));
+    Mesh->SetBounds(MeshBounds);
 }
 
-void RenderCore::AllocatePrimitiveIndices(std::shared_ptr<Mesh> const &Mesh, tinygltf::Model const &Model, tinygltf::Primitive const &Primitive)
+void RenderCore::AllocatePrimitiveIndices(std::shared_ptr<Mesh> const &Mesh,
+                                          tinygltf::Model const &      Model,
+                                          ModelBuffers const &         Buffers,
+                                          tinygltf::Primitive const &  Primitive)
 {
     std::vector<std::uint32_t> Indices;
 
-    if (Primitive.indices >= 0)
+    // Index accessors go through the same range checks as the attributes, so malformed views leave the primitive without indices
+    if (AccessorView const IndexView = GetAccessorView(Model, Buffers, Primitive.indices);
+        IndexView.IsValid())
     {
-        tinygltf::Accessor const &  IndexAccessor   = Model.accessors.at(Primitive.indices);
-        tinygltf::BufferView const &IndexBufferView = Model.bufferViews.at(IndexAccessor.bufferView);
-        tinygltf::Buffer const &    IndexBuffer     = Model.buffers.at(IndexBufferView.buffer);
-        unsigned char const *const  IndicesData     = std::data(IndexBuffer.data) + IndexBufferView.byteOffset + IndexAccessor.byteOffset;
+        tinygltf::Accessor const & IndexAccessor = Model.accessors.at(Primitive.indices);
+        unsigned char const *const IndicesData   = IndexView.Data;
 
         Indices.reserve(IndexAccessor.count);
 
@@ -198,5 +523,56 @@ void RenderCore::SetPrimitiveTransform(std::shared_ptr<Mesh> const &Mesh, tinygl
     }
 
     Mesh->SetTransform(Transform);
-    Mesh->SetupBounds();
+}
+
+std::vector<Transform> RenderCore::GetInstanceTransforms(tinygltf::Model const &Model, ModelBuffers const &Buffers, tinygltf::Node const &Node)
+{
+    auto const ExtensionIt = Node.extensions.find("EXT_mesh_gpu_instancing");
+    if (ExtensionIt == std::end(Node.extensions) || !ExtensionIt->second.Has("attributes"))
+    {
+        return {};
+    }
+
+    tinygltf::Value const &Attributes = ExtensionIt->second.Get("attributes");
+
+    auto const GetAttributeView = [&](std::string const &ID)
+    {
+        return Attributes.Has(ID) ? GetAccessorView(Model, Buffers, Attributes.Get(ID).GetNumberAsInt()) : AccessorView {};
+    };
+
+    AccessorView const TranslationView = GetAttributeView("TRANSLATION");
+    AccessorView const RotationView    = GetAttributeView("ROTATION");
+    AccessorView const ScaleView       = GetAttributeView("SCALE");
+
+    std::uint32_t const NumInstances = std::max({ TranslationView.Count, RotationView.Count, ScaleView.Count });
+    if (NumInstances == 0U)
+    {
+        return {};
+    }
+
+    struct InstanceAttributes
+    {
+        glm::vec3 Translation { 0.F };
+        glm::vec4 Rotation { 0.F, 0.F, 0.F, 1.F };
+        glm::vec3 Scale { 1.F };
+    };
+
+    // Missing attributes keep the identity, rotations may be stored as normalized integers like any other attribute
+    std::vector<InstanceAttributes> Instances(NumInstances);
+    ConvertAttribute(TranslationView, Instances, &InstanceAttributes::Translation, glm::vec3 { 0.F });
+    ConvertAttribute(RotationView, Instances, &InstanceAttributes::Rotation, glm::vec4 { 0.F, 0.F, 0.F, 1.F });
+    ConvertAttribute(ScaleView, Instances, &InstanceAttributes::Scale, glm::vec3 { 1.F });
+
+    std::vector<Transform> Output(NumInstances);
+    for (std::uint32_t Iterator = 0U; Iterator < NumInstances; ++Iterator)
+    {
+        InstanceAttributes const &InstanceIter  = Instances.at(Iterator);
+        Transform &               TransformIter = Output.at(Iterator);
+
+        TransformIter.SetPosition(InstanceIter.Translation);
+        TransformIter.SetScale(InstanceIter.Scale);
+        TransformIter.SetRotation(degrees(eulerAngles(glm::make_quat(glm::value_ptr(InstanceIter.Rotation)))));
+    }
+
+    return Output;
 }
@@ -7,7 +7,9 @@ module;
 #include <array>
 #include <numeric>
 #include <ranges>
+#include <string_view>
 #include <vector>
+#include <glm/ext.hpp>
 #include <vma/vk_mem_alloc.h>
 #include <Volk/volk.h>
 
@@ -26,6 +28,7 @@ import RenderCore.Runtime.ShaderCompiler;
 import RenderCore.Runtime.SwapChain;
 import RenderCore.Runtime.Scene;
 import RenderCore.Runtime.Device;
+import RenderCore.Runtime.Synchronization;
 
 using namespace RenderCore;
 
@@ -63,9 +66,9 @@ constexpr VkPipelineCacheCreateInfo g_PipelineCacheCreateInfo { .sType = VK_STRU
 
 bool PipelineData::IsValid() const
 {
-    return MainPipeline != VK_NULL_HANDLE || FragmentShaderPipeline != VK_NULL_HANDLE || VertexInputPipeline != VK_NULL_HANDLE ||
-           PreRasterizationPipeline != VK_NULL_HANDLE || FragmentOutputPipeline != VK_NULL_HANDLE || PipelineLayout != VK_NULL_HANDLE || PipelineCache
-           != VK_NULL_HANDLE || PipelineLibraryCache != VK_NULL_HANDLE;
+    return MainPipeline != VK_NULL_HANDLE || MeshPipeline != VK_NULL_HANDLE || FragmentShaderPipeline != VK_NULL_HANDLE || VertexInputPipeline !=
+           VK_NULL_HANDLE || PreRasterizationPipeline != VK_NULL_HANDLE || MeshPreRasterizationPipeline != VK_NULL_HANDLE || FragmentOutputPipeline !=
+           VK_NULL_HANDLE || PipelineLayout != VK_NULL_HANDLE || PipelineCache != VK_NULL_HANDLE || PipelineLibraryCache != VK_NULL_HANDLE;
 }
 
 void PipelineData::DestroyResources(VkDevice const &LogicalDevice, bool const IncludeStatic)
@@ -76,6 +79,12 @@ void PipelineData::DestroyResources(VkDevice const &LogicalDevice, bool const In
         MainPipeline = VK_NULL_HANDLE;
     }
 
+    if (MeshPipeline != VK_NULL_HANDLE)
+    {
+        vkDestroyPipeline(LogicalDevice, MeshPipeline, nullptr);
+        MeshPipeline = VK_NULL_HANDLE;
+    }
+
     if (FragmentShaderPipeline != VK_NULL_HANDLE)
     {
         vkDestroyPipeline(LogicalDevice, FragmentShaderPipeline, nullptr);
@@ -99,6 +108,12 @@ void PipelineData::DestroyResources(VkDevice const &LogicalDevice, bool const In
         PreRasterizationPipeline = VK_NULL_HANDLE;
     }
 
+    if (MeshPreRasterizationPipeline != VK_NULL_HANDLE)
+    {
+        vkDestroyPipeline(LogicalDevice, MeshPreRasterizationPipeline, nullptr);
+        MeshPreRasterizationPipeline = VK_NULL_HANDLE;
+    }
+
     if (FragmentOutputPipeline != VK_NULL_HANDLE)
     {
         vkDestroyPipeline(LogicalDevice, FragmentOutputPipeline, nullptr);
@@ -210,124 +225,145 @@ void PipelineDescriptorData::SetupSceneBuffer(BufferAllocation const &SceneAlloc
     }
 }
 
-void PipelineDescriptorData::SetupModelsBuffer(std::vector<std::shared_ptr<Object>> const &Objects)
+// Descriptors of each object live at its model slot, so they are written when the object is added and never moved afterwards
+void WriteModelDescriptors(PipelineDescriptorData const &Descriptors, Object const &Object)
 {
-    if (std::empty(Objects))
-    {
-        return;
-    }
-
-    VkDevice const &    LogicalDevice = GetLogicalDevice();
-    VmaAllocator const &Allocator     = GetAllocator();
+    VkDevice const &       LogicalDevice = GetLogicalDevice();
+    DescriptorData const & ModelData     = Descriptors.ModelData;
+    DescriptorData const & TextureData   = Descriptors.TextureData;
+    std::uint32_t const    Slot          = Object.GetModelSlot();
+    constexpr std::uint8_t NumTextures   = static_cast<std::uint8_t>(TextureType::Count);
 
     {
-        constexpr VkBufferUsageFlags BufferUsage = VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
-
-        ModelData.Buffer.Size = static_cast<std::uint32_t>(std::size(Objects)) * ModelData.LayoutSize;
+        VkBufferDeviceAddressInfo const BufferDeviceAddressInfo {
+                .sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO,
+                .buffer = GetModelUniformBuffer()
+        };
 
-        CreateBuffer(ModelData.Buffer.Size, BufferUsage, "Model Descriptor Buffer", ModelData.Buffer.Buffer, ModelData.Buffer.Allocation);
+        VkDeviceSize const ModelUniformAddress = vkGetBufferDeviceAddress(LogicalDevice, &BufferDeviceAddressInfo);
 
-        vmaMapMemory(Allocator, ModelData.Buffer.Allocation, &ModelData.Buffer.MappedData);
+        VkDescriptorAddressInfoEXT ModelDescriptorAddressInfo {
+                .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_ADDRESS_INFO_EXT,
+                .address = ModelUniformAddress + Object.GetUniformOffset(),
+                .range = sizeof(ModelUniformData)
+        };
 
-        VkBufferDeviceAddressInfo const BufferDeviceAddressInfo {
-                .sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO,
-                .buffer = ModelData.Buffer.Buffer
+        VkDescriptorGetInfoEXT const ModelDescriptorInfo {
+                .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT,
+                .type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+                .data = VkDescriptorDataEXT { .pUniformBuffer = &ModelDescriptorAddressInfo }
         };
 
-        ModelData.BufferDeviceAddress.deviceAddress = vkGetBufferDeviceAddress(LogicalDevice, &BufferDeviceAddressInfo);
+        VkDeviceSize const BufferOffset = Slot * ModelData.LayoutSize + ModelData.LayoutOffset;
+
+        vkGetDescriptorEXT(LogicalDevice,
+                           &ModelDescriptorInfo,
+                           g_DescriptorBufferProperties.uniformBufferDescriptorSize,
+                           static_cast<unsigned char *>(ModelData.Buffer.MappedData) + BufferOffset);
     }
 
-    constexpr std::uint8_t NumTextures = static_cast<std::uint8_t>(TextureType::Count);
+    auto const &  Textures     = Object.GetMesh()->GetTextures();
+    std::uint32_t TextureCount = 0U;
 
+    for (std::uint8_t TypeIter = 0U; TypeIter < NumTextures; ++TypeIter)
     {
-        constexpr VkBufferUsageFlags BufferUsage = VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT |
-                                                   VK_BUFFER_USAGE_SAMPLER_DESCRIPTOR_BUFFER_BIT_EXT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
-
-        TextureData.Buffer.Size = NumTextures * static_cast<std::uint32_t>(std::size(Objects)) * TextureData.LayoutSize;
-        CreateBuffer(TextureData.Buffer.Size, BufferUsage, "Texture Descriptor Buffer", TextureData.Buffer.Buffer, TextureData.Buffer.Allocation);
+        auto MatchingTexture = std::ranges::find_if(Textures,
+                                                    [TypeIter](std::shared_ptr<Texture> const &Texture)
+                                                    {
+                                                        auto const Types = Texture->GetTypes();
+                                                        return std::ranges::find_if(Types,
+                                                                                    [TypeIter](TextureType const &TextureType)
+                                                                                    {
+                                                                                        return static_cast<std::uint8_t>(TextureType) == TypeIter;
+                                                                                    }) != std::end(Types);
+                                                    });
+
+        auto const &ImageDescriptor = MatchingTexture != std::cend(Textures)
+                                          ? (*MatchingTexture)->GetImageDescriptor()
+                                          : GetAllocationImageDescriptor(0U);
+
+        VkDescriptorGetInfoEXT const TextureDescriptorInfo {
+                .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT,
+                .type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                .data = VkDescriptorDataEXT { .pCombinedImageSampler = &ImageDescriptor }
+        };
 
-        vmaMapMemory(Allocator, TextureData.Buffer.Allocation, &TextureData.Buffer.MappedData);
+        VkDeviceSize const BufferOffset = (TextureCount + Slot * NumTextures) * TextureData.LayoutSize + TextureData.LayoutOffset;
 
-        VkBufferDeviceAddressInfo const BufferDeviceAddressInfo {
-                .sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO,
-                .buffer = TextureData.Buffer.Buffer
-        };
+        vkGetDescriptorEXT(LogicalDevice,
+                           &TextureDescriptorInfo,
+                           g_DescriptorBufferProperties.combinedImageSamplerDescriptorSize,
+                           static_cast<unsigned char *>(TextureData.Buffer.MappedData) + BufferOffset);
 
-        TextureData.BufferDeviceAddress.deviceAddress = vkGetBufferDeviceAddress(LogicalDevice, &BufferDeviceAddressInfo);
+        ++TextureCount;
     }
+}
 
-    auto const ModelBuffer   = static_cast<unsigned char *>(ModelData.Buffer.MappedData);
-    auto const TextureBuffer = static_cast<unsigned char *>(TextureData.Buffer.MappedData);
-
-    std::uint32_t ObjectCount = 0U;
+void CreateDescriptorBuffer(DescriptorData &Data, VkDeviceSize const Size, VkBufferUsageFlags const Usage, std::string_view const Identifier)
+{
+    Data.Buffer.Size = Size;
+    CreateBuffer(Data.Buffer.Size, Usage, Identifier, Data.Buffer.Buffer, Data.Buffer.Allocation);
+    vmaMapMemory(GetAllocator(), Data.Buffer.Allocation, &Data.Buffer.MappedData);
 
     VkBufferDeviceAddressInfo const BufferDeviceAddressInfo {
             .sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO,
-            .buffer = GetAllocationBuffer()
+            .buffer = Data.Buffer.Buffer
     };
 
-    for (std::shared_ptr<Object> const &ObjectIter : Objects)
-    {
-        {
-            VkDeviceSize const ModelUniformAddress = vkGetBufferDeviceAddress(LogicalDevice, &BufferDeviceAddressInfo);
-
-            VkDescriptorAddressInfoEXT ModelDescriptorAddressInfo {
-                    .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_ADDRESS_INFO_EXT,
-                    .address = ModelUniformAddress + ObjectIter->GetUniformOffset(),
-                    .range = sizeof(ModelUniformData)
-            };
+    Data.BufferDeviceAddress.deviceAddress = vkGetBufferDeviceAddress(GetLogicalDevice(), &BufferDeviceAddressInfo);
+}
 
-            VkDescriptorGetInfoEXT const ModelDescriptorInfo {
-                    .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT,
-                    .type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-                    .data = VkDescriptorDataEXT { .pUniformBuffer = &ModelDescriptorAddressInfo }
-            };
+// The previous buffers stay alive until the frames in flight bound to them have completed, so nothing is waited here
+void PipelineDescriptorData::SetupModelsBuffer(std::vector<std::shared_ptr<Object>> const &Objects)
+{
+    RetireWithFrames([ModelBuffer = ModelData.Buffer, TextureBuffer = TextureData.Buffer]() mutable
+    {
+        VmaAllocator const &Allocator = GetAllocator();
+        ModelBuffer.DestroyResources(Allocator);
+        TextureBuffer.DestroyResources(Allocator);
+    });
 
-            VkDeviceSize const BufferOffset = ObjectCount * ModelData.LayoutSize + ModelData.LayoutOffset;
+    ModelData.Buffer   = {};
+    TextureData.Buffer = {};
 
-            vkGetDescriptorEXT(LogicalDevice,
-                               &ModelDescriptorInfo,
-                               g_DescriptorBufferProperties.uniformBufferDescriptorSize,
-                               ModelBuffer + BufferOffset);
-        }
+    std::uint32_t const NumSlots = GetModelSlotCapacity();
+    if (NumSlots == 0U)
+    {
+        return;
+    }
 
-        auto const &  Textures     = ObjectIter->GetMesh()->GetTextures();
-        std::uint32_t TextureCount = 0U;
+    constexpr std::uint8_t NumTextures = static_cast<std::uint8_t>(TextureType::Count);
 
-        for (std::uint8_t TypeIter = 0U; TypeIter < NumTextures; ++TypeIter)
-        {
-            auto MatchingTexture = std::ranges::find_if(Textures,
-                                                        [TypeIter](std::shared_ptr<Texture> const &Texture)
-                                                        {
-                                                            auto const Types = Texture->GetTypes();
-                                                            return std::ranges::find_if(Types,
-                                                                                        [TypeIter](TextureType const &TextureType)
-                                                                                        {
-                                                                                            return static_cast<std::uint8_t>(TextureType) == TypeIter;
-                                                                                        }) != std::end(Types);
-                                                        });
-
-            auto const &ImageDescriptor = MatchingTexture != std::cend(Textures)
-                                              ? (*MatchingTexture)->GetImageDescriptor()
-                                              : GetAllocationImageDescriptor(0U);
-
-            VkDescriptorGetInfoEXT const TextureDescriptorInfo {
-                    .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT,
-                    .type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                    .data = VkDescriptorDataEXT { .pCombinedImageSampler = &ImageDescriptor }
-            };
+    CreateDescriptorBuffer(ModelData,
+                           NumSlots * ModelData.LayoutSize,
+                           VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                           "Model Descriptor Buffer");
 
-            VkDeviceSize const BufferOffset = (TextureCount + ObjectCount * NumTextures) * TextureData.LayoutSize + TextureData.LayoutOffset;
+    CreateDescriptorBuffer(TextureData,
+                           NumTextures * NumSlots * TextureData.LayoutSize,
+                           VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT | VK_BUFFER_USAGE_SAMPLER_DESCRIPTOR_BUFFER_BIT_EXT |
+                           VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                           "Texture Descriptor Buffer");
 
-            vkGetDescriptorEXT(LogicalDevice,
-                               &TextureDescriptorInfo,
-                               g_DescriptorBufferProperties.combinedImageSamplerDescriptorSize,
-                               TextureBuffer + BufferOffset);
+    for (std::shared_ptr<Object> const &ObjectIter : Objects)
+    {
+        WriteModelDescriptors(*this, *ObjectIter);
+    }
+}
 
-            ++TextureCount;
-        }
+// Slots being written are either new or were freed after the last frame reading them, so the frames in flight are not affected
+void PipelineDescriptorData::UpdateModelsBuffer(std::vector<std::shared_ptr<Object>> const &Objects)
+{
+    if (!ModelData.Buffer.IsValid() || ModelData.Buffer.Size < GetModelSlotCapacity() * ModelData.LayoutSize)
+    {
+        // The model slots outgrew the descriptor buffers, or the uniform buffer they point to was recreated with them
+        SetupModelsBuffer(GetObjects());
+        return;
+    }
 
-        ++ObjectCount;
+    for (std::shared_ptr<Object> const &ObjectIter : Objects)
+    {
+        WriteModelDescriptors(*this, *ObjectIter);
     }
 }
 
@@ -356,19 +392,34 @@ void RenderCore::CreatePipelineDynamicResources()
 void RenderCore::CreatePipelineLibraries()
 {
     std::vector<VkPipelineShaderStageCreateInfo> ShaderStagesInfo {};
+    std::vector<VkPipelineShaderStageCreateInfo> MeshShaderStagesInfo {};
     std::vector<VkShaderModuleCreateInfo>        ShaderModuleInfo {};
 
-    for (auto const &[StageInfo, ShaderCode] : GetStageData())
+    std::vector<ShaderStageData> const &StageData = GetStageData();
+    ShaderModuleInfo.reserve(std::size(StageData));
+
+    for (auto const &[StageInfo, ShaderCode] : StageData)
     {
+        std::vector<VkPipelineShaderStageCreateInfo> *TargetStages = nullptr;
+
         if (StageInfo.stage == VK_SHADER_STAGE_VERTEX_BIT)
         {
-            auto const CodeSize                            = static_cast<std::uint32_t>(std::size(ShaderCode) * sizeof(std::uint32_t));
-            ShaderStagesInfo.emplace_back(StageInfo).pNext = &ShaderModuleInfo.emplace_back(VkShaderModuleCreateInfo {
-                                                                                                    .sType =
-                                                                                                    VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
-                                                                                                    .codeSize = CodeSize,
-                                                                                                    .pCode = std::data(ShaderCode)
-                                                                                            });
+            TargetStages = &ShaderStagesInfo;
+        }
+        else if (StageInfo.stage == VK_SHADER_STAGE_TASK_BIT_EXT || StageInfo.stage == VK_SHADER_STAGE_MESH_BIT_EXT)
+        {
+            TargetStages = &MeshShaderStagesInfo;
+        }
+
+        if (TargetStages)
+        {
+            auto const CodeSize                          = static_cast<std::uint32_t>(std::size(ShaderCode) * sizeof(std::uint32_t));
+            TargetStages->emplace_back(StageInfo).pNext = &ShaderModuleInfo.emplace_back(VkShaderModuleCreateInfo {
+                                                                                                 .sType =
+                                                                                                 VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
+                                                                                                 .codeSize = CodeSize,
+                                                                                                 .pCode = std::data(ShaderCode)
+                                                                                         });
         }
     }
 
@@ -397,20 +448,46 @@ void RenderCore::CreatePipelineLibraries()
             .lineWidth = 1.F
     };
 
+    std::vector<VkVertexInputAttributeDescription> InputAttributes = GetVertexFormat() == VertexFormat::Packed
+                                                                         ? GetAttributeDescriptions(0U,
+                                                                                                    {
+                                                                                                            PackedVertexAttributes::Position,
+                                                                                                            PackedVertexAttributes::Normal,
+                                                                                                            PackedVertexAttributes::TextureCoordinate,
+                                                                                                            PackedVertexAttributes::Color,
+                                                                                                            PackedVertexAttributes::Tangent,
+                                                                                                    })
+                                                                         : GetAttributeDescriptions(0U,
+                                                                                                    {
+                                                                                                            VertexAttributes::Position,
+                                                                                                            VertexAttributes::Normal,
+                                                                                                            VertexAttributes::TextureCoordinate,
+                                                                                                            VertexAttributes::Color,
+                                                                                                            VertexAttributes::Tangent,
+                                                                                                    });
+
+    // The instance transform follows the vertex attributes, one location per matrix column
+    for (std::uint32_t ColumnIter = 0U; ColumnIter < 4U; ++ColumnIter)
+    {
+        InputAttributes.push_back({
+                .location = static_cast<std::uint32_t>(std::size(InputAttributes)),
+                .binding = 1U,
+                .format = VK_FORMAT_R32G32B32A32_SFLOAT,
+                .offset = static_cast<std::uint32_t>(ColumnIter * sizeof(glm::vec4))
+        });
+    }
+
     PipelineLibraryCreationArguments const Arguments {
             .RasterizationState = RasterizationState,
             .ColorBlendAttachment = ColorBlendAttachmentStates,
             .MultisampleState = g_MultisampleState,
-            .VertexBinding = GetBindingDescriptors(0U),
-            .VertexAttributes = GetAttributeDescriptions(0U,
-                                                         {
-                                                                 VertexAttributes::Position,
-                                                                 VertexAttributes::Normal,
-                                                                 VertexAttributes::TextureCoordinate,
-                                                                 VertexAttributes::Color,
-                                                                 VertexAttributes::Tangent,
-                                                         }),
-            .ShaderStages = ShaderStagesInfo
+            .VertexBindings = {
+                    GetBindingDescriptors(0U, GetVertexStride()),
+                    GetBindingDescriptors(1U, sizeof(ModelInstanceData), VK_VERTEX_INPUT_RATE_INSTANCE)
+            },
+            .VertexAttributes = std::move(InputAttributes),
+            .ShaderStages = ShaderStagesInfo,
+            .MeshShaderStages = MeshShaderStagesInfo
     };
 
     CreatePipelineLibraries(g_PipelineData, Arguments, VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT);
@@ -437,13 +514,19 @@ void CreateDescriptorSetLayout(VkDescriptorSetLayoutBinding const &Binding, std:
 
 void RenderCore::SetupPipelineLayouts()
 {
-    constexpr std::array LayoutBindings {
+    bool const MeshShading = IsMeshShadingEnabled();
+
+    VkShaderStageFlags const UniformStages = MeshShading
+                                                 ? VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_TASK_BIT_EXT | VK_SHADER_STAGE_MESH_BIT_EXT
+                                                 : VK_SHADER_STAGE_VERTEX_BIT;
+
+    std::array const LayoutBindings {
             VkDescriptorSetLayoutBinding // Uniform Buffer
             {
                     .binding = 0U,
                     .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
                     .descriptorCount = 1U,
-                    .stageFlags = VK_SHADER_STAGE_VERTEX_BIT,
+                    .stageFlags = UniformStages,
                     .pImmutableSamplers = nullptr
             },
             VkDescriptorSetLayoutBinding // Texture Sampler
@@ -466,10 +549,18 @@ void RenderCore::SetupPipelineLayouts()
             g_DescriptorData.TextureData.SetLayout
     };
 
+    constexpr VkPushConstantRange MeshletPushConstantRange {
+            .stageFlags = VK_SHADER_STAGE_TASK_BIT_EXT | VK_SHADER_STAGE_MESH_BIT_EXT,
+            .offset = 0U,
+            .size = sizeof(MeshletPushConstants)
+    };
+
     VkPipelineLayoutCreateInfo const PipelineLayoutCreateInfo {
             .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
             .setLayoutCount = static_cast<std::uint32_t>(std::size(DescriptorLayouts)),
-            .pSetLayouts = std::data(DescriptorLayouts)
+            .pSetLayouts = std::data(DescriptorLayouts),
+            .pushConstantRangeCount = MeshShading ? 1U : 0U,
+            .pPushConstantRanges = MeshShading ? &MeshletPushConstantRange : nullptr
     };
 
     VkDevice const &LogicalDevice = GetLogicalDevice();
@@ -494,6 +585,11 @@ VkPipeline const &RenderCore::GetMainPipeline()
     return g_PipelineData.MainPipeline;
 }
 
+VkPipeline const &RenderCore::GetMeshPipeline()
+{
+    return g_PipelineData.MeshPipeline;
+}
+
 VkPipelineCache const &RenderCore::GetPipelineCache()
 {
     return g_PipelineData.PipelineCache;
@@ -523,8 +619,8 @@ void RenderCore::CreatePipelineLibraries(PipelineData &Data, PipelineLibraryCrea
 
         VkPipelineVertexInputStateCreateInfo const VertexInputState {
                 .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
-                .vertexBindingDescriptionCount = 1U,
-                .pVertexBindingDescriptions = &Arguments.VertexBinding,
+                .vertexBindingDescriptionCount = static_cast<std::uint32_t>(std::size(Arguments.VertexBindings)),
+                .pVertexBindingDescriptions = std::data(Arguments.VertexBindings),
                 .vertexAttributeDescriptionCount = static_cast<std::uint32_t>(std::size(Arguments.VertexAttributes)),
                 .pVertexAttributeDescriptions = std::data(Arguments.VertexAttributes)
         };
@@ -570,24 +666,30 @@ void RenderCore::CreatePipelineLibraries(PipelineData &Data, PipelineLibraryCrea
                 .pDynamicStates = std::data(g_DynamicStates)
         };
 
-        VkGraphicsPipelineCreateInfo const PreRasterizationInfo {
-                .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
-                .pNext = &PreRasterizationLibrary,
-                .flags = g_PipelineFlags | Flags,
-                .stageCount = static_cast<std::uint32_t>(std::size(Arguments.ShaderStages)),
-                .pStages = std::data(Arguments.ShaderStages),
-                .pViewportState = &ViewportState,
-                .pRasterizationState = &Arguments.RasterizationState,
-                .pDynamicState = &DynamicState,
-                .layout = Data.PipelineLayout
+        auto const CreatePreRasterizationLibrary = [&](std::vector<VkPipelineShaderStageCreateInfo> const &Stages, VkPipeline &Output)
+        {
+            VkGraphicsPipelineCreateInfo const PreRasterizationInfo {
+                    .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+                    .pNext = &PreRasterizationLibrary,
+                    .flags = g_PipelineFlags | Flags,
+                    .stageCount = static_cast<std::uint32_t>(std::size(Stages)),
+                    .pStages = std::data(Stages),
+                    .pViewportState = &ViewportState,
+                    .pRasterizationState = &Arguments.RasterizationState,
+                    .pDynamicState = &DynamicState,
+                    .layout = Data.PipelineLayout
+            };
+
+            CheckVulkanResult(vkCreateGraphicsPipelines(LogicalDevice, Data.PipelineLibraryCache, 1U, &PreRasterizationInfo, nullptr, &Output));
         };
 
-        CheckVulkanResult(vkCreateGraphicsPipelines(LogicalDevice,
-                                                    Data.PipelineLibraryCache,
-                                                    1U,
-                                                    &PreRasterizationInfo,
-                                                    nullptr,
-                                                    &Data.PreRasterizationPipeline));
+        CreatePreRasterizationLibrary(Arguments.ShaderStages, Data.PreRasterizationPipeline);
+
+        // The mesh variant shares every other library, it only swaps the vertex input and pre rasterization parts
+        if (!std::empty(Arguments.MeshShaderStages))
+        {
+            CreatePreRasterizationLibrary(Arguments.MeshShaderStages, Data.MeshPreRasterizationPipeline);
+        }
     }
 
     // Fragment output library
@@ -684,15 +786,8 @@ void RenderCore::CreateMainPipeline(PipelineData &
                                                     &Data.FragmentShaderPipeline));
     }
 
-    // Main Pipeline
+    auto const LinkPipeline = [&](std::vector<VkPipeline> const &Libraries, VkPipeline &Output)
     {
-        std::vector const Libraries {
-                Data.VertexInputPipeline,
-                Data.PreRasterizationPipeline,
-                Data.FragmentOutputPipeline,
-                Data.FragmentShaderPipeline
-        };
-
         VkPipelineLibraryCreateInfoKHR PipelineLibraryCreateInfo {
                 .sType = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR,
                 .pNext = &RenderingCreateInfo,
@@ -707,6 +802,16 @@ void RenderCore::CreateMainPipeline(PipelineData &
                 .layout = Data.PipelineLayout
         };
 
-        CheckVulkanResult(vkCreateGraphicsPipelines(LogicalDevice, Data.PipelineCache, 1U, &GraphicsPipelineCreateInfo, nullptr, &Data.MainPipeline));
+        CheckVulkanResult(vkCreateGraphicsPipelines(LogicalDevice, Data.PipelineCache, 1U, &GraphicsPipelineCreateInfo, nullptr, &Output));
+    };
+
+    // Main Pipeline
+    LinkPipeline({ Data.VertexInputPipeline, Data.PreRasterizationPipeline, Data.FragmentOutputPipeline, Data.FragmentShaderPipeline },
+                 Data.MainPipeline);
+
+    // Mesh Pipeline
+    if (Data.MeshPreRasterizationPipeline != VK_NULL_HANDLE)
+    {
+        LinkPipeline({ Data.MeshPreRasterizationPipeline, Data.FragmentOutputPipeline, Data.FragmentShaderPipeline }, Data.MeshPipeline);
     }
 }
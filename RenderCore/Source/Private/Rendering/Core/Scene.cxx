@@ -18,8 +18,16 @@ module;
 #ifndef STB_IMAGE_WRITE_IMPLEMENTATION
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #endif
+#include <algorithm>
 #include <execution>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <span>
 #include <tiny_gltf.h>
+#include <unordered_map>
 
 module RenderCore.Runtime.Scene;
 
@@ -27,12 +35,17 @@ import RenderCore.Types.Object;
 import RenderCore.Types.Mesh;
 import RenderCore.Types.Material;
 import RenderCore.Types.Texture;
+import RenderCore.Types.Vertex;
+import RenderCore.Types.Transform;
 import RenderCore.Types.UniformBufferObject;
 import RenderCore.Types.SurfaceProperties;
 import RenderCore.Runtime.Device;
 import RenderCore.Runtime.Command;
 import RenderCore.Runtime.Memory;
 import RenderCore.Runtime.Model;
+import RenderCore.Runtime.MeshCache;
+import RenderCore.Runtime.GLBFile;
+import RenderCore.Runtime.Synchronization;
 import RenderCore.Runtime.SwapChain;
 import RenderCore.Utils.Helpers;
 import RenderCore.Utils.Constants;
@@ -119,84 +132,560 @@ void RenderCore::AllocateEmptyTexture(VkFormat const TextureFormat)
     VkCommandPool                CommandPool { VK_NULL_HANDLE };
     std::vector<VkCommandBuffer> CommandBuffers(1U, VK_NULL_HANDLE);
 
-    auto const &[FamilyIndex, Queue] = GetGraphicsQueue();
+    InitializeSingleCommandQueue(CommandPool, CommandBuffers, GetGraphicsQueue().first);
+    const auto [Index, Staging] = AllocateTexture(CommandBuffers.at(0U),
+                                                  std::data(DefaultTextureData),
+                                                  DefaultTextureHalfSize,
+                                                  DefaultTextureHalfSize,
+                                                  TextureFormat,
+                                                  DefaultTextureSize * DefaultTextureSize);
 
-    InitializeSingleCommandQueue(CommandPool, CommandBuffers, FamilyIndex);
-    const auto [Index, Buffer, Allocation] = AllocateTexture(CommandBuffers.at(0U),
-                                                             std::data(DefaultTextureData),
-                                                             DefaultTextureHalfSize,
-                                                             DefaultTextureHalfSize,
-                                                             TextureFormat,
-                                                             DefaultTextureSize * DefaultTextureSize);
+    // Frames are submitted to the same queue after the upload, so nothing has to wait for it here
+    ReleaseStagingRegion(Staging, SubmitSingleCommandQueue(CommandPool, CommandBuffers));
+}
 
-    FinishSingleCommandQueue(Queue, CommandPool, CommandBuffers);
+// Entries of one cache sharing a content hash only share the upload when they also describe the same image
+bool IsSameTextureImage(CachedTexture const &Lhs, CachedTexture const &Rhs)
+{
+    return Lhs.Width == Rhs.Width && Lhs.Height == Rhs.Height && Lhs.Format == Rhs.Format && Lhs.DataSize == Rhs.DataSize;
+}
 
-    VmaAllocator const &Allocator = GetAllocator();
-    vmaDestroyBuffer(Allocator, Buffer, Allocation);
+TextureUploadRegion MakeCachedTextureRegion(CachedTexture const &Texture, std::shared_ptr<MeshCache const> const &Cache, VkDeviceSize const StagingOffset)
+{
+    return TextureUploadRegion {
+            .StagingOffset = StagingOffset,
+            .Width = Texture.Width,
+            .Height = Texture.Height,
+            .Format = Texture.Format,
+            .LevelOffsets = std::vector<VkDeviceSize>(Texture.LevelOffsets, Texture.LevelOffsets + Texture.NumLevels),
+            .Data = std::span { Texture.Data, Texture.DataSize },
+            .DataOwner = Cache
+    };
+}
+
+// Texture and geometry data go from the cache mapping to the staging memory and the geometry heap, the mapping lives as long as something reads it
+std::vector<std::shared_ptr<Object>> LoadSceneFromCache(std::string_view const ModelPath, std::shared_ptr<MeshCache const> const &Cache)
+{
+    std::vector<std::shared_ptr<Object>> LoadedObjects {};
+
+    VkCommandPool                CommandPool { VK_NULL_HANDLE };
+    std::vector<VkCommandBuffer> CommandBuffers { VK_NULL_HANDLE };
+
+    std::vector<CachedTexture> const &    CachedTextures = Cache->GetTextures();
+    std::vector<std::shared_ptr<Texture>> Textures {};
+    std::vector<TextureUploadRegion>      Regions {};
+    std::vector<std::size_t>              RegionTextures {};
+
+    // Textures whose content is already resident, or queued by an earlier entry, only take a reference
+    std::vector<std::uint32_t>                       BufferIDs(std::size(CachedTextures), 0U);
+    std::unordered_map<std::uint64_t, std::size_t>   QueuedContent {};
+    std::vector<std::pair<std::size_t, std::size_t>> SharedTextures {};
+
+    VkDeviceSize StagingSize { 0U };
+    for (std::size_t Iterator = 0U; Iterator < std::size(CachedTextures); ++Iterator)
+    {
+        CachedTexture const &TextureIter = CachedTextures.at(Iterator);
+
+        if (std::uint32_t BufferID { 0U };
+            AcquireCachedTexture(TextureIter.ContentHash, { .width = TextureIter.Width, .height = TextureIter.Height }, TextureIter.Format, BufferID))
+        {
+            BufferIDs.at(Iterator) = BufferID;
+            continue;
+        }
+
+        if (auto const Queued = QueuedContent.find(TextureIter.ContentHash);
+            Queued != std::end(QueuedContent) && IsSameTextureImage(CachedTextures.at(Queued->second), TextureIter))
+        {
+            SharedTextures.emplace_back(Iterator, Queued->second);
+            continue;
+        }
+
+        QueuedContent.emplace(TextureIter.ContentHash, Iterator);
+        RegionTextures.push_back(Iterator);
+
+        Regions.push_back(MakeCachedTextureRegion(TextureIter, Cache, StagingSize));
+
+        StagingSize += AlignUp(TextureIter.DataSize, g_TextureStagingAlignment);
+    }
+
+    if (StagingSize > 0U)
+    {
+        StagingRegion const Staging = AcquireStagingRegion(StagingSize);
+
+        std::for_each(std::execution::par,
+                      std::begin(Regions),
+                      std::end(Regions),
+                      [&](TextureUploadRegion const &RegionIter)
+                      {
+                          std::memcpy(Staging.MappedData + RegionIter.StagingOffset, std::data(RegionIter.Data), std::size(RegionIter.Data));
+                      });
+
+        std::vector<std::uint32_t> UploadedIDs {};
+
+        InitializeSingleCommandQueue(CommandPool, CommandBuffers, GetGraphicsQueue().first);
+        {
+            UploadedIDs = AllocateTextures(CommandBuffers.at(0U), Staging, std::move(Regions));
+        }
+        ReleaseStagingRegion(Staging, SubmitSingleCommandQueue(CommandPool, CommandBuffers));
+
+        for (std::size_t Iterator = 0U; Iterator < std::size(RegionTextures); ++Iterator)
+        {
+            std::size_t const TextureIndex = RegionTextures.at(Iterator);
+
+            BufferIDs.at(TextureIndex) = UploadedIDs.at(Iterator);
+            RegisterTextureContent(UploadedIDs.at(Iterator), CachedTextures.at(TextureIndex).ContentHash);
+        }
+    }
+
+    for (auto const &[TextureIndex, SourceIndex] : SharedTextures)
+    {
+        BufferIDs.at(TextureIndex) = BufferIDs.at(SourceIndex);
+        RetainTexture(BufferIDs.at(TextureIndex));
+    }
+
+    Textures.reserve(std::size(CachedTextures));
+    for (std::size_t Iterator = 0U; Iterator < std::size(CachedTextures); ++Iterator)
+    {
+        CachedTexture const &TextureIter = CachedTextures.at(Iterator);
+        auto const           TextureID   = static_cast<std::uint32_t>(g_ObjectAllocationIDCounter.fetch_add(1U));
+        auto                 NewTexture  = std::shared_ptr<Texture>(new Texture { TextureID, TextureIter.Uri, std::format("{}_{:03d}", TextureIter.Name, TextureID) },
+                                                             TextureDeleter {});
+
+        NewTexture->SetBufferIndex(BufferIDs.at(Iterator));
+        Textures.push_back(std::move(NewTexture));
+    }
+
+    std::vector<CachedGeometry> const &        CachedGeometries = Cache->GetGeometries();
+    std::vector<std::shared_ptr<MeshGeometry>> Geometries(std::size(CachedGeometries));
+
+    LoadedObjects.reserve(std::size(Cache->GetMeshes()));
+    for (CachedMesh const &MeshIter : Cache->GetMeshes())
+    {
+        auto const MeshID  = static_cast<std::uint32_t>(g_ObjectAllocationIDCounter.fetch_add(1U));
+        auto       NewMesh = std::make_shared<Mesh>(MeshID, ModelPath, std::format("{}_{:03d}", MeshIter.Name, MeshID));
+
+        NewMesh->SetTransform(MeshIter.MeshTransform);
+
+        if (std::shared_ptr<MeshGeometry> &Geometry = Geometries.at(MeshIter.GeometryIndex);
+            !Geometry)
+        {
+            CachedGeometry const &GeometryIter = CachedGeometries.at(MeshIter.GeometryIndex);
+
+            Geometry                   = std::make_shared<MeshGeometry>();
+            Geometry->IndexType        = GeometryIter.Layout.IndexType;
+            Geometry->LODs             = std::vector<MeshLOD>(GeometryIter.LODs, GeometryIter.LODs + GeometryIter.NumLODs);
+            Geometry->CachedImage      = std::span { GeometryIter.Image, GeometryIter.Layout.Size };
+            Geometry->CachedImageOwner = Cache;
+            Geometry->CachedLayout     = GeometryIter.Layout;
+        }
+
+        NewMesh->SetGeometry(Geometries.at(MeshIter.GeometryIndex));
+
+        NewMesh->SetBounds(MeshIter.MeshBounds);
+        NewMesh->SetMaterialData(MeshIter.Material);
+
+        std::vector<std::shared_ptr<Texture>> MeshTextures {};
+        for (std::uint8_t TypeIter = 0U; TypeIter < static_cast<std::uint8_t>(TextureType::Count); ++TypeIter)
+        {
+            if (std::int32_t const TextureIndex = MeshIter.TextureIndices.at(TypeIter);
+                TextureIndex >= 0 && TextureIndex < static_cast<std::int32_t>(std::size(Textures)))
+            {
+                std::shared_ptr<Texture> const &TextureIter = Textures.at(TextureIndex);
+                TextureIter->AppendType(static_cast<TextureType>(TypeIter));
+                MeshTextures.push_back(TextureIter);
+            }
+        }
+        NewMesh->SetTextures(MeshTextures);
+
+        auto NewObject = std::make_shared<Object>(static_cast<std::uint32_t>(g_ObjectAllocationIDCounter.fetch_add(1U)), ModelPath);
+        NewObject->SetInstanceTransforms(MeshIter.InstanceTransforms);
+        NewObject->SetMesh(std::move(NewMesh));
+        LoadedObjects.push_back(std::move(NewObject));
+    }
+
+    return LoadedObjects;
 }
 
-void RenderCore::LoadScene(std::string_view const ModelPath)
+// Instanced meshes are culled as a whole, so their bounds enclose every instance placed as the shaders do, by the node and then the instance matrix
+Bounds GetInstancedBounds(Mesh const &InstancedMesh, std::vector<Transform> const &Instances)
 {
-    tinygltf::Model Model {};
+    // Bounds start with a maximum of FLT_MIN, the smallest positive float, so both are seeded here to enclose meshes lying below zero
+    Bounds const EmptyBounds { .Min = glm::vec3 { std::numeric_limits<float>::max() }, .Max = glm::vec3 { std::numeric_limits<float>::lowest() } };
+
+    Bounds LocalBounds = EmptyBounds;
+
+    for (Vertex const &VertexIter : InstancedMesh.GetVertices())
+    {
+        LocalBounds.Min = glm::min(LocalBounds.Min, VertexIter.Position);
+        LocalBounds.Max = glm::max(LocalBounds.Max, VertexIter.Position);
+    }
+
+    glm::mat4 const NodeMatrix = InstancedMesh.GetTransform().GetMatrix();
+    Bounds          Output     = EmptyBounds;
+
+    for (Transform const &InstanceIter : Instances)
     {
-        tinygltf::TinyGLTF          ModelLoader {};
-        std::string                 Error {};
-        std::string                 Warning {};
-        std::filesystem::path const ModelFilepath(ModelPath);
-        bool const                  LoadResult = ModelFilepath.extension() == ".gltf"
-                                                     ? ModelLoader.LoadASCIIFromFile(&Model, &Error, &Warning, std::data(ModelPath))
-                                                     : ModelLoader.LoadBinaryFromFile(&Model, &Error, &Warning, std::data(ModelPath));
-        if (!std::empty(Error))
+        glm::mat4 const Matrix = NodeMatrix * InstanceIter.GetMatrix();
+
+        for (std::uint8_t CornerIter = 0U; CornerIter < 8U; ++CornerIter)
         {
-            BOOST_LOG_TRIVIAL(error) << "[" << __func__ << "]: Error: '" << Error << "'";
+            glm::vec3 const Corner { CornerIter & 1U ? LocalBounds.Max.x : LocalBounds.Min.x,
+                                     CornerIter & 2U ? LocalBounds.Max.y : LocalBounds.Min.y,
+                                     CornerIter & 4U ? LocalBounds.Max.z : LocalBounds.Min.z };
+
+            glm::vec3 const Transformed = glm::vec3(Matrix * glm::vec4(Corner, 1.F));
+            Output.Min                  = glm::min(Output.Min, Transformed);
+            Output.Max                  = glm::max(Output.Max, Transformed);
         }
+    }
+
+    return Output;
+}
+
+CachedMesh MakeCachedMesh(Mesh const &                                          LoadedMesh,
+                          MeshConstructionInputParameters const &               Arguments,
+                          std::unordered_map<std::uint32_t, std::int32_t> const &TextureCacheIndices,
+                          std::uint32_t const                                   GeometryIndex,
+                          std::vector<Transform> const &                        Instances)
+{
+    tinygltf::Material const &MeshMaterial = Arguments.Model.materials.at(Arguments.Primitive.material);
+
+    auto const GetCacheIndex = [&TextureCacheIndices](std::int32_t const TextureIndex)
+    {
+        return TextureIndex >= 0 && TextureCacheIndices.contains(TextureIndex) ? TextureCacheIndices.at(TextureIndex) : -1;
+    };
+
+    return CachedMesh {
+            .Name = std::empty(Arguments.Mesh.name) ? "None" : Arguments.Mesh.name,
+            .MeshTransform = LoadedMesh.GetTransform(),
+            .MeshBounds = LoadedMesh.GetBounds(),
+            .Material = LoadedMesh.GetMaterialData(),
+            .TextureIndices = {
+                    GetCacheIndex(MeshMaterial.pbrMetallicRoughness.baseColorTexture.index),
+                    GetCacheIndex(MeshMaterial.normalTexture.index),
+                    GetCacheIndex(MeshMaterial.occlusionTexture.index),
+                    GetCacheIndex(MeshMaterial.emissiveTexture.index),
+                    GetCacheIndex(MeshMaterial.pbrMetallicRoughness.metallicRoughnessTexture.index)
+            },
+            .GeometryIndex = GeometryIndex,
+            .InstanceTransforms = Instances
+    };
+}
+
+// Textures uploaded by a load that missed the cache stream their levels from the file it just baked, as if they were loaded from it
+void AttachCachedTextureSources(std::string_view const ModelPath, std::vector<std::uint32_t> const &BufferIDs)
+{
+    auto const Cache = std::make_shared<MeshCache>();
+    if (std::empty(BufferIDs) || !Cache->Open(ModelPath) || std::size(Cache->GetTextures()) != std::size(BufferIDs))
+    {
+        return;
+    }
+
+    std::vector<TextureUploadRegion> Regions {};
+    Regions.reserve(std::size(BufferIDs));
+
+    for (CachedTexture const &TextureIter : Cache->GetTextures())
+    {
+        Regions.push_back(MakeCachedTextureRegion(TextureIter, Cache, 0U));
+    }
+
+    AttachTextureSources(BufferIDs, Regions);
+}
+
+// Chains blitted on the GPU are baked with their box filtered stand-in, so the cache holds every level that can be streamed
+void BakeTextureLevels(std::vector<CachedTexture> &Textures, std::vector<std::pair<std::vector<unsigned char>, std::vector<VkDeviceSize>>> &Levels)
+{
+    Levels.resize(std::size(Textures));
+
+    std::for_each(std::execution::par,
+                  std::begin(Textures),
+                  std::end(Textures),
+                  [&Textures, &Levels](CachedTexture &TextureIter)
+                  {
+                      if (TextureIter.NumLevels > 0U)
+                      {
+                          return;
+                      }
+
+                      auto &[Data, LevelOffsets] = Levels.at(std::distance(std::data(Textures), &TextureIter));
+                      Data.assign(TextureIter.Data, TextureIter.Data + TextureIter.DataSize);
 
-        if (!std::empty(Warning))
+                      if (!BuildTextureLevels(TextureIter.Format, { .width = TextureIter.Width, .height = TextureIter.Height }, Data, LevelOffsets))
+                      {
+                          Data.clear();
+                          return;
+                      }
+
+                      TextureIter.Data         = std::data(Data);
+                      TextureIter.DataSize     = std::size(Data);
+                      TextureIter.LevelOffsets = std::data(LevelOffsets);
+                      TextureIter.NumLevels    = static_cast<std::uint32_t>(std::size(LevelOffsets));
+                  });
+}
+
+// Everything read from the file, handed from the parse stage of the loader to the build stage
+struct RenderCore::ParsedScene
+{
+    std::string                                 Path {};
+    std::shared_ptr<MeshCache>                  Cache { std::make_shared<MeshCache>() };
+    bool                                        IsCached { false };
+    GLBFile                                     Binary {};
+    tinygltf::Model                             Model {};
+    ModelBuffers                                Buffers {};
+    std::vector<std::vector<unsigned char>>     DecodedBuffers {};
+    std::vector<std::vector<unsigned char>>     CapturedImages {};
+    std::vector<std::span<unsigned char const>> EncodedImages {};
+};
+
+// Images embedded in a buffer view are read from the model buffers, so those stored in a GLB stay in the mapping
+void ResolveEncodedImages(ParsedScene &Scene)
+{
+    Scene.EncodedImages.resize(std::size(Scene.Model.images));
+
+    for (std::size_t Iterator = 0U; Iterator < std::size(Scene.Model.images); ++Iterator)
+    {
+        if (tinygltf::Image const &ImageIter = Scene.Model.images.at(Iterator);
+            ImageIter.bufferView >= 0)
         {
-            BOOST_LOG_TRIVIAL(warning) << "[" << __func__ << "]: Warning: '" << Warning << "'";
+            if (ImageIter.bufferView >= static_cast<std::int32_t>(std::size(Scene.Model.bufferViews)))
+            {
+                continue;
+            }
+
+            // Views reaching past their buffer leave the image empty, which is then skipped like any image that fails to decode
+            tinygltf::BufferView const &BufferView = Scene.Model.bufferViews.at(ImageIter.bufferView);
+            if (BufferView.buffer < 0 || BufferView.buffer >= static_cast<std::int32_t>(std::size(Scene.Buffers)))
+            {
+                continue;
+            }
+
+            if (std::span<unsigned char const> const Buffer = Scene.Buffers.at(BufferView.buffer);
+                BufferView.byteOffset <= std::size(Buffer) && BufferView.byteLength <= std::size(Buffer) - BufferView.byteOffset)
+            {
+                Scene.EncodedImages.at(Iterator) = Buffer.subspan(BufferView.byteOffset, BufferView.byteLength);
+            }
+        }
+        else if (Iterator < std::size(Scene.CapturedImages))
+        {
+            Scene.EncodedImages.at(Iterator) = Scene.CapturedImages.at(Iterator);
         }
+    }
+}
+
+// Files next to the model that feed its buffers and images, embedded data and GLB chunks are covered by the model stamp itself
+std::vector<std::string> GetExternalDependencies(tinygltf::Model const &Model)
+{
+    std::vector<std::string> Output {};
 
-        if (!LoadResult)
+    auto const InsertDependency = [&Output](std::string const &Uri)
+    {
+        std::string DecodedUri {};
+        if (std::empty(Uri) || tinygltf::IsDataURI(Uri) || !tinygltf::URIDecode(Uri, &DecodedUri, nullptr))
         {
-            BOOST_LOG_TRIVIAL(error) << "[" << __func__ << "]: Failed to load model from path: '" << ModelPath << "'";
             return;
         }
+
+        if (std::ranges::find(Output, DecodedUri) == std::cend(Output))
+        {
+            Output.push_back(std::move(DecodedUri));
+        }
+    };
+
+    for (tinygltf::Buffer const &BufferIter : Model.buffers)
+    {
+        InsertDependency(BufferIter.uri);
     }
 
+    for (tinygltf::Image const &ImageIter : Model.images)
+    {
+        InsertDependency(ImageIter.uri);
+    }
+
+    return Output;
+}
+
+// Text files are only rewritten when they use meshopt compression, whose fallback buffers would otherwise be rejected by the loader
+bool LoadASCIIModel(tinygltf::TinyGLTF &Loader, tinygltf::Model &Model, std::string &Error, std::string &Warning, std::filesystem::path const &Path)
+{
+    std::ifstream Stream(Path, std::ios::binary);
+    if (!Stream.is_open())
+    {
+        Error = std::format("Failed to open file: '{}'", Path.string());
+        return false;
+    }
+
+    std::string JSON { std::istreambuf_iterator { Stream }, std::istreambuf_iterator<char> {} };
+
+    if (JSON.find("EXT_meshopt_compression") != std::string::npos)
+    {
+        nlohmann::json Document = nlohmann::json::parse(JSON, nullptr, false);
+        if (Document.is_discarded() || !Document.is_object())
+        {
+            Error = "Invalid glTF JSON";
+            return false;
+        }
+
+        StubCompressionFallbackBuffers(Document);
+        JSON = Document.dump();
+    }
+
+    return Loader.LoadASCIIFromString(&Model, &Error, &Warning, std::data(JSON), static_cast<unsigned int>(std::size(JSON)), Path.parent_path().string());
+}
+
+std::shared_ptr<ParsedScene> RenderCore::ParseScene(std::string_view const ModelPath, std::string &Error)
+{
+    auto Output  = std::make_shared<ParsedScene>();
+    Output->Path = ModelPath;
+
+    if (Output->Cache->Open(ModelPath))
+    {
+        Output->IsCached = true;
+        return Output;
+    }
+
+    tinygltf::TinyGLTF ModelLoader {};
+    ModelLoader.SetImageLoader(&CaptureEncodedImage, &Output->CapturedImages);
+
+    std::string                 Warning {};
+    std::filesystem::path const ModelFilepath(Output->Path);
+    bool const                  IsBinary = ModelFilepath.extension() == ".glb";
+
+    // Binary files are mapped instead of read, so their BIN chunk goes from the mapping to the staging memory without intermediate copies
+    bool const LoadResult = IsBinary
+                                ? Output->Binary.Open(ModelPath, Error) &&
+                                  Output->Binary.LoadModel(ModelLoader, Output->Model, Error, Warning, ModelFilepath.parent_path().string())
+                                : LoadASCIIModel(ModelLoader, Output->Model, Error, Warning, ModelFilepath);
+    if (!std::empty(Error))
+    {
+        BOOST_LOG_TRIVIAL(error) << "[" << __func__ << "]: Error: '" << Error << "'";
+    }
+
+    if (!std::empty(Warning))
+    {
+        BOOST_LOG_TRIVIAL(warning) << "[" << __func__ << "]: Warning: '" << Warning << "'";
+    }
+
+    if (!LoadResult)
+    {
+        BOOST_LOG_TRIVIAL(error) << "[" << __func__ << "]: Failed to load model from path: '" << ModelPath << "'";
+
+        if (std::empty(Error))
+        {
+            Error = "Failed to load model";
+        }
+
+        return nullptr;
+    }
+
+    Output->Buffers = GetModelBuffers(Output->Model);
+    if (std::int32_t const BinaryBuffer = Output->Binary.GetBinaryBufferIndex();
+        BinaryBuffer >= 0)
+    {
+        Output->Buffers.at(BinaryBuffer) = Output->Binary.GetBinaryBuffer();
+    }
+
+    if (!DecodeCompressedBufferViews(Output->Model, Output->Buffers, Output->DecodedBuffers, Error))
+    {
+        BOOST_LOG_TRIVIAL(error) << "[" << __func__ << "]: Failed to decode compressed buffers of model: '" << ModelPath << "': " << Error;
+        return nullptr;
+    }
+
+    ResolveEncodedImages(*Output);
+
+    return Output;
+}
+
+std::vector<std::shared_ptr<Object>> RenderCore::LoadScene(std::string_view const ModelPath)
+{
+    std::string Error {};
+
+    if (std::shared_ptr<ParsedScene> const Scene = ParseScene(ModelPath, Error))
+    {
+        return BuildScene(*Scene);
+    }
+
+    return {};
+}
+
+std::vector<std::shared_ptr<Object>> RenderCore::BuildScene(ParsedScene &Scene)
+{
+    if (Scene.IsCached)
+    {
+        return LoadSceneFromCache(Scene.Path, Scene.Cache);
+    }
+
+    std::string_view const                             ModelPath     = Scene.Path;
+    tinygltf::Model const &                            Model         = Scene.Model;
+    ModelBuffers const &                               Buffers       = Scene.Buffers;
+    std::vector<std::span<unsigned char const>> const &EncodedImages = Scene.EncodedImages;
+
+    std::vector<std::shared_ptr<Object>>    LoadedObjects {};
+    std::vector<CachedTexture>              BakedTextures {};
+    std::vector<std::uint32_t>              BakedTextureBufferIDs {};
+    std::vector<CachedGeometry>             BakedGeometries {};
+    std::vector<std::vector<unsigned char>> BakedGeometryImages {};
+    std::vector<CachedMesh>                 BakedMeshes {};
+
     VkCommandPool                CommandPool { VK_NULL_HANDLE };
     std::vector<VkCommandBuffer> CommandBuffers { VK_NULL_HANDLE };
 
-    auto const &                                                [QueueIndex, Queue] = GetGraphicsQueue();
-    std::unordered_map<VkBuffer, VmaAllocation>                 BufferAllocations {};
     std::unordered_map<std::uint32_t, std::shared_ptr<Texture>> TextureMap {};
+    TextureConstructionOutputParameters                         TextureOutput {};
 
-    InitializeSingleCommandQueue(CommandPool, CommandBuffers, QueueIndex);
+    InitializeSingleCommandQueue(CommandPool, CommandBuffers, GetGraphicsQueue().first);
     {
         VkCommandBuffer &CommandBuffer = CommandBuffers.at(0U);
 
+        std::vector<std::uint32_t> TextureIDs(std::size(Model.textures));
+        for (std::uint32_t &IDIter : TextureIDs)
+        {
+            IDIter = static_cast<std::uint32_t>(g_ObjectAllocationIDCounter.fetch_add(1U));
+        }
+
+        TextureConstructionInputParameters const TextureInput {
+                .IDs = TextureIDs,
+                .Model = Model,
+                .EncodedImages = EncodedImages,
+                .AllocationCmdBuffer = CommandBuffer
+        };
+
+        ConstructTextures(TextureInput, TextureOutput);
+        TextureMap = std::move(TextureOutput.Textures);
+
+        std::unordered_map<std::uint32_t, std::int32_t> TextureCacheIndices {};
         for (std::uint32_t Iterator = 0U; Iterator < std::size(Model.textures); ++Iterator)
         {
-            tinygltf::Texture const &TextureIter = Model.textures.at(Iterator);
-            if (TextureIter.source < 0 || TextureMap.contains(Iterator))
+            if (!TextureMap.contains(Iterator))
             {
                 continue;
             }
 
-            TextureConstructionInputParameters Input {
-                    .ID = static_cast<std::uint32_t>(g_ObjectAllocationIDCounter.fetch_add(1U)),
-                    .Image = Model.images.at(TextureIter.source),
-                    .AllocationCmdBuffer = CommandBuffer
-            };
+            std::int32_t const     Source      = GetTextureSource(Model.textures.at(Iterator));
+            tinygltf::Image const &ImageIter   = Model.images.at(Source);
+            DecodedImage const &   DecodedIter = TextureOutput.Images.at(Source);
+            TextureCacheIndices.emplace(Iterator, static_cast<std::int32_t>(std::size(BakedTextures)));
+            BakedTextureBufferIDs.push_back(TextureMap.at(Iterator)->GetBufferIndex());
+
+            BakedTextures.push_back({
+                    .Name = std::empty(ImageIter.name) ? "None" : ImageIter.name,
+                    .Uri = ImageIter.uri,
+                    .Width = DecodedIter.Width,
+                    .Height = DecodedIter.Height,
+                    .Format = DecodedIter.Format,
+                    .Data = TextureOutput.Staging.MappedData + DecodedIter.StagingOffset,
+                    .DataSize = DecodedIter.Size,
+                    .LevelOffsets = std::data(DecodedIter.LevelOffsets),
+                    .NumLevels = static_cast<std::uint32_t>(std::size(DecodedIter.LevelOffsets)),
+                    .ContentHash = DecodedIter.ContentHash
+            });
+        }
 
-            TextureConstructionOutputParameters Output {};
+        std::vector<MeshConstructionInputParameters> MeshArguments {};
+        std::vector<std::uint32_t>                   ObjectIDs {};
 
-            if (std::shared_ptr<Texture> NewTexture = ConstructTexture(Input, Output);
-                NewTexture)
-            {
-                TextureMap.emplace(Iterator, std::move(NewTexture));
-                BufferAllocations.emplace(std::move(Output.StagingBuffer), std::move(Output.StagingAllocation));
-            }
-        }
+        // Nodes referencing an already gathered (mesh, primitive) pair only differ by transform and reuse its geometry
+        std::vector<std::size_t>                                    GeometrySources {};
+        std::map<std::pair<std::int32_t, std::size_t>, std::size_t> PrimitiveSources {};
 
         for (tinygltf::Node const &Node : Model.nodes)
         {
@@ -206,66 +695,149 @@ void RenderCore::LoadScene(std::string_view const ModelPath)
                 continue;
             }
 
-            for (tinygltf::Mesh const &     LoadedMesh = Model.meshes.at(MeshIndex);
-                 tinygltf::Primitive const &PrimitiveIter : LoadedMesh.primitives)
+            tinygltf::Mesh const &LoadedMesh = Model.meshes.at(MeshIndex);
+            for (std::size_t PrimitiveIndex = 0U; PrimitiveIndex < std::size(LoadedMesh.primitives); ++PrimitiveIndex)
             {
-                MeshConstructionInputParameters Arguments {
+                tinygltf::Primitive const &PrimitiveIter = LoadedMesh.primitives.at(PrimitiveIndex);
+
+                GeometrySources.push_back(PrimitiveSources.try_emplace({ MeshIndex, PrimitiveIndex }, std::size(MeshArguments)).first->second);
+
+                MeshArguments.push_back({
                         .ID = static_cast<std::uint32_t>(g_ObjectAllocationIDCounter.fetch_add(1U)),
                         .Path = ModelPath,
                         .Model = Model,
+                        .Buffers = Buffers,
                         .Node = Node,
                         .Mesh = LoadedMesh,
                         .Primitive = PrimitiveIter,
                         .TextureMap = TextureMap
-                };
-
-                if (std::shared_ptr<Mesh> NewMesh = ConstructMesh(Arguments);
-                    NewMesh)
-                {
-                    std::uint32_t const ObjectID  = g_ObjectAllocationIDCounter.fetch_add(1U);
-                    auto                NewObject = std::make_shared<Object>(ObjectID, ModelPath);
-                    NewObject->SetMesh(std::move(NewMesh));
-                    g_Objects.push_back(std::move(NewObject));
-                }
+                });
+
+                ObjectIDs.push_back(static_cast<std::uint32_t>(g_ObjectAllocationIDCounter.fetch_add(1U)));
             }
         }
 
-        AllocateModelsBuffers(g_Objects);
+        std::vector<std::shared_ptr<Mesh>> LoadedMeshes(std::size(MeshArguments));
+
+        std::for_each(std::execution::par,
+                      std::begin(MeshArguments),
+                      std::end(MeshArguments),
+                      [&](MeshConstructionInputParameters const &ArgumentsIter)
+                      {
+                          if (std::size_t const Index = std::distance(std::data(MeshArguments), &ArgumentsIter);
+                              GeometrySources.at(Index) == Index)
+                          {
+                              LoadedMeshes.at(Index) = ConstructMesh(ArgumentsIter);
+                          }
+                      });
+
+        std::for_each(std::execution::par,
+                      std::begin(MeshArguments),
+                      std::end(MeshArguments),
+                      [&](MeshConstructionInputParameters const &ArgumentsIter)
+                      {
+                          if (std::size_t const Index = std::distance(std::data(MeshArguments), &ArgumentsIter);
+                              GeometrySources.at(Index) != Index)
+                          {
+                              LoadedMeshes.at(Index) = ConstructMeshInstance(ArgumentsIter, LoadedMeshes.at(GeometrySources.at(Index)));
+                          }
+                      });
+
+        std::unordered_map<MeshGeometry const *, std::uint32_t> GeometryCacheIndices {};
+
+        LoadedObjects.reserve(std::size(LoadedMeshes));
+        for (std::size_t Iterator = 0U; Iterator < std::size(LoadedMeshes); ++Iterator)
+        {
+            std::shared_ptr<Mesh> &NewMesh = LoadedMeshes.at(Iterator);
+            if (!NewMesh)
+            {
+                continue;
+            }
+
+            SetupMeshTextures(NewMesh, MeshArguments.at(Iterator));
+
+            auto const [GeometryIt, NewGeometry] = GeometryCacheIndices.try_emplace(NewMesh->GetGeometry().get(),
+                                                                                    static_cast<std::uint32_t>(std::size(BakedGeometries)));
+            if (NewGeometry)
+            {
+                // Baked as the heap range itself, so a cache hit writes it to the heap without packing it again
+                MeshGeometry const &     Geometry = *NewMesh->GetGeometry();
+                MeshGeometryLayout const Layout   = GetGeometryLayout(Geometry);
+
+                std::vector<unsigned char> &Image = BakedGeometryImages.emplace_back(Layout.Size);
+                WriteGeometryImage(Geometry, std::data(Image));
+
+                BakedGeometries.push_back({ .Image = std::data(Image), .Layout = Layout, .LODs = std::data(Geometry.LODs), .NumLODs = NewMesh->GetNumLODs() });
+            }
+
+            std::vector<Transform> const Instances = GetInstanceTransforms(Model, Buffers, MeshArguments.at(Iterator).Node);
+            if (!std::empty(Instances))
+            {
+                NewMesh->SetBounds(GetInstancedBounds(*NewMesh, Instances));
+            }
+
+            BakedMeshes.push_back(MakeCachedMesh(*NewMesh, MeshArguments.at(Iterator), TextureCacheIndices, GeometryIt->second, Instances));
+
+            auto NewObject = std::make_shared<Object>(ObjectIDs.at(Iterator), ModelPath);
+            NewObject->SetInstanceTransforms(Instances);
+            NewObject->SetMesh(std::move(NewMesh));
+            LoadedObjects.push_back(std::move(NewObject));
+        }
     }
-    FinishSingleCommandQueue(Queue, CommandPool, CommandBuffers);
+    // The cache is written while the GPU consumes the upload, the staging memory is only read on both sides until the ticket is passed
+    UploadTicket const Ticket = SubmitSingleCommandQueue(CommandPool, CommandBuffers);
 
-    VmaAllocator const &Allocator = GetAllocator();
-    for (auto &[Buffer, Allocation] : BufferAllocations)
+    if (!std::empty(LoadedObjects))
     {
-        vmaDestroyBuffer(Allocator, Buffer, Allocation);
+        std::vector<std::pair<std::vector<unsigned char>, std::vector<VkDeviceSize>>> BakedLevels {};
+        BakeTextureLevels(BakedTextures, BakedLevels);
+
+        if (WriteMeshCache(ModelPath, BakedTextures, BakedGeometries, BakedMeshes, GetExternalDependencies(Scene.Model)))
+        {
+            AttachCachedTextureSources(ModelPath, BakedTextureBufferIDs);
+        }
+        else
+        {
+            BOOST_LOG_TRIVIAL(warning) << "[" << __func__ << "]: Failed to write mesh cache for model: '" << ModelPath << "'";
+        }
     }
+
+    ReleaseStagingRegion(TextureOutput.Staging, Ticket);
+
+    return LoadedObjects;
+}
+
+void RenderCore::InsertObjects(std::vector<std::shared_ptr<Object>> const &Objects)
+{
+    std::lock_guard Lock { g_ObjectMutex };
+
+    g_Objects.insert(std::end(g_Objects), std::begin(Objects), std::end(Objects));
+    AllocateModels(Objects);
 }
 
 void RenderCore::UnloadObjects(std::vector<std::uint32_t> const &ObjectIDs)
 {
     std::lock_guard Lock { g_ObjectMutex };
 
-    std::for_each(std::execution::unseq,
-                  std::begin(ObjectIDs),
-                  std::end(ObjectIDs),
-                  [&](std::uint32_t const ObjectIDIter)
-                  {
-                      if (auto const MatchingIter = std::ranges::find_if(g_Objects,
-                                                                         [ObjectIDIter](std::shared_ptr<Object> const &ObjectIter)
-                                                                         {
-                                                                             return ObjectIter->GetID() == ObjectIDIter;
-                                                                         });
-                          MatchingIter != std::end(g_Objects))
-                      {
-                          MatchingIter->get()->Destroy();
-                          g_Objects.erase(MatchingIter);
-                      }
-                  });
+    std::vector<std::shared_ptr<Object>> RemovedObjects {};
 
-    if (std::empty(g_Objects))
+    for (std::uint32_t const ObjectIDIter : ObjectIDs)
     {
-        g_ObjectAllocationIDCounter.fetch_sub(g_ObjectAllocationIDCounter.load());
+        if (auto const MatchingIter = std::ranges::find_if(g_Objects,
+                                                           [ObjectIDIter](std::shared_ptr<Object> const &ObjectIter)
+                                                           {
+                                                               return ObjectIter->GetID() == ObjectIDIter;
+                                                           });
+            MatchingIter != std::end(g_Objects))
+        {
+            MatchingIter->get()->Destroy();
+            RemovedObjects.push_back(std::move(*MatchingIter));
+            g_Objects.erase(MatchingIter);
+        }
     }
+
+    // The remaining objects keep their slots, the removed ones release theirs once no frame in flight reads them
+    RetireModels(std::move(RemovedObjects));
 }
 
 void RenderCore::ReleaseSceneResources()
@@ -293,9 +865,10 @@ void RenderCore::DestroyObjects()
     {
         Object->Destroy();
     }
-    g_Objects.clear();
 
-    g_ObjectAllocationIDCounter.fetch_sub(g_ObjectAllocationIDCounter.load());
+    std::vector<std::shared_ptr<Object>> RemovedObjects {};
+    RemovedObjects.swap(g_Objects);
+    RetireModels(std::move(RemovedObjects));
 }
 
 void RenderCore::TickObjects(float const DeltaTime)
@@ -314,6 +887,34 @@ void RenderCore::TickObjects(float const DeltaTime)
                   });
 }
 
+std::unordered_map<std::uint32_t, float> RenderCore::GetTextureScreenCoverage()
+{
+    std::unordered_map<std::uint32_t, float> Output {};
+
+    std::lock_guard Lock { g_ObjectMutex };
+
+    // Each image keeps the largest projected size among the visible meshes sampling it, hidden ones only register it
+    for (std::shared_ptr<Object> const &ObjectIter : g_Objects)
+    {
+        std::shared_ptr<Mesh> const &Mesh = ObjectIter->GetMesh();
+
+        if (!Mesh)
+        {
+            continue;
+        }
+
+        float const Coverage = g_Camera.CanDrawObject(ObjectIter) ? g_Camera.GetProjectedSize(ObjectIter) : 0.F;
+
+        for (std::shared_ptr<Texture> const &TextureIter : Mesh->GetTextures())
+        {
+            float &ImageCoverage = Output[TextureIter->GetBufferIndex()];
+            ImageCoverage        = std::max(ImageCoverage, Coverage);
+        }
+    }
+
+    return Output;
+}
+
 ImageAllocation const &RenderCore::GetDepthImage()
 {
     return g_DepthImage;
@@ -22,11 +22,27 @@ module RenderCore.Runtime.ShaderCompiler;
 
 import RenderCore.Utils.Helpers;
 import RenderCore.Utils.DebugHelpers;
+import RenderCore.Runtime.Device;
 
 using namespace RenderCore;
 
 std::vector<ShaderStageData> g_StageInfos;
 
+VkShaderStageFlagBits GetShaderStageFlag(EShLanguage const Language)
+{
+    switch (Language)
+    {
+        case EShLangTask:
+            return VK_SHADER_STAGE_TASK_BIT_EXT;
+        case EShLangMesh:
+            return VK_SHADER_STAGE_MESH_BIT_EXT;
+        case EShLangVertex:
+            return VK_SHADER_STAGE_VERTEX_BIT;
+        default:
+            return VK_SHADER_STAGE_FRAGMENT_BIT;
+    }
+}
+
 bool CompileInternal(ShaderType const            ShaderType,
                      std::string_view const      Source,
                      EShLanguage const           Language,
@@ -45,7 +61,9 @@ bool CompileInternal(ShaderType const            ShaderType,
     Shader.setSourceEntryPoint(std::data(EntryPoint));
     Shader.setEnvInput(ShaderType == ShaderType::GLSL ? glslang::EShSourceGlsl : glslang::EShSourceHlsl, Language, glslang::EShClientVulkan, 1);
     Shader.setEnvClient(glslang::EShClientVulkan, glslang::EShTargetVulkan_1_3);
-    Shader.setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_0);
+    // EXT_mesh_shader is only expressible from SPIR-V 1.4 onwards
+    bool const IsMeshStage = Language == EShLangTask || Language == EShLangMesh;
+    Shader.setEnvTarget(glslang::EShTargetSpv, IsMeshStage ? glslang::EShTargetSpv_1_4 : glslang::EShTargetSpv_1_0);
 
     TBuiltInResource const *Resources    = GetDefaultResources();
     constexpr auto          MessageFlags = static_cast<EShMessages>(EShMsgSpvRules | EShMsgVulkanRules);
@@ -238,7 +256,7 @@ void RenderCore::ReleaseShaderResources()
     g_StageInfos.clear();
 }
 
-void RenderCore::CompileDefaultShaders()
+void RenderCore::CompileDefaultShaders(VertexFormat const Format)
 {
     constexpr auto GlslVersion = 450;
     constexpr auto EntryPoint  = "main";
@@ -250,22 +268,26 @@ void RenderCore::CompileDefaultShaders()
         {
             StageInfo = VkPipelineShaderStageCreateInfo {
                     .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
-                    .stage = Language == EShLangVertex ? VK_SHADER_STAGE_VERTEX_BIT : VK_SHADER_STAGE_FRAGMENT_BIT,
+                    .stage = GetShaderStageFlag(Language),
                     .pName = EntryPoint
             };
         }
     };
 
-    // constexpr auto TaskLang { EShLangTask };
-    // constexpr auto TaskShader { DEFAULT_TASK_SHADER };
-    // CompileAndStage(TaskShader, TaskLang);
+    // The meshlet stages fetch the full vertex layout, so the packed format always stays on the vertex pipeline
+    if (IsMeshShaderEnabled() && Format == VertexFormat::Full)
+    {
+        constexpr auto TaskLang { EShLangTask };
+        constexpr auto TaskShader { DEFAULT_TASK_SHADER };
+        CompileAndStage(TaskShader, TaskLang);
 
-    // constexpr auto MeshLang { EShLangMesh };
-    // constexpr auto MeshShader { DEFAULT_MESH_SHADER };
-    // CompileAndStage(MeshShader, MeshLang);
+        constexpr auto MeshLang { EShLangMesh };
+        constexpr auto MeshShader { DEFAULT_MESH_SHADER };
+        CompileAndStage(MeshShader, MeshLang);
+    }
 
     constexpr auto VertexLang { EShLangVertex };
-    constexpr auto VertexShader { DEFAULT_VERTEX_SHADER };
+    auto const     VertexShader { Format == VertexFormat::Packed ? PACKED_VERTEX_SHADER : DEFAULT_VERTEX_SHADER };
     CompileAndStage(VertexShader, VertexLang);
 
     constexpr auto FragmentLang { EShLangFragment };
@@ -7,6 +7,7 @@ module;
 #include <Volk/volk.h>
 #include <algorithm>
 #include <execution>
+#include <mutex>
 #include <vector>
 #include <vma/vk_mem_alloc.h>
 
@@ -120,6 +121,7 @@ void RenderCore::PresentFrame(std::uint32_t const ImageIndice)
                                         .pSwapchains        = &g_SwapChain,
                                         .pImageIndices      = &ImageIndice};
 
+    std::lock_guard Lock {GetGraphicsQueueMutex()};
     CheckVulkanResult(vkQueuePresentKHR(GetGraphicsQueue().second, &PresentInfo));
 }
 
@@ -6,6 +6,10 @@ module;
 
 #include <Volk/volk.h>
 #include <array>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <vector>
 
 module RenderCore.Runtime.Synchronization;
 
@@ -20,6 +24,26 @@ std::array<VkSemaphore, g_ImageCount> g_ImageAvailableSemaphores {};
 std::array<VkSemaphore, g_ImageCount> g_RenderFinishedSemaphores {};
 std::array<VkFence, g_ImageCount>     g_Fences {};
 std::array<bool, g_ImageCount>        g_FenceInUse {};
+VkSemaphore                           g_GraphicsTimelineSemaphore { VK_NULL_HANDLE };
+VkSemaphore                           g_TransferTimelineSemaphore { VK_NULL_HANDLE };
+std::uint32_t                         g_LastSubmittedFence { g_ImageCount };
+
+std::array<std::vector<std::function<void()>>, g_ImageCount> g_RetiredResources {};
+std::mutex                                                    g_RetiredResourcesMutex {};
+
+void ReleaseRetiredResources(std::uint32_t const Index)
+{
+    std::vector<std::function<void()>> Releases {};
+    {
+        std::lock_guard Lock { g_RetiredResourcesMutex };
+        Releases.swap(g_RetiredResources.at(Index));
+    }
+
+    for (std::function<void()> const &ReleaseIter : Releases)
+    {
+        ReleaseIter();
+    }
+}
 
 void RenderCore::WaitAndResetFence(std::uint32_t const Index)
 {
@@ -34,6 +58,23 @@ void RenderCore::WaitAndResetFence(std::uint32_t const Index)
     g_FenceInUse.at(Index) = false;
 
     ResetCommandPool(Index);
+    ReleaseRetiredResources(Index);
+}
+
+// Frames are submitted in order to a single queue, so the fence of the last one also covers every frame submitted before it
+void RenderCore::RetireWithFrames(std::function<void()> &&Release)
+{
+    {
+        std::lock_guard Lock { g_RetiredResourcesMutex };
+
+        if (g_LastSubmittedFence < g_ImageCount && g_FenceInUse.at(g_LastSubmittedFence))
+        {
+            g_RetiredResources.at(g_LastSubmittedFence).push_back(std::move(Release));
+            return;
+        }
+    }
+
+    Release();
 }
 
 void RenderCore::CreateSynchronizationObjects()
@@ -58,12 +99,27 @@ void RenderCore::CreateSynchronizationObjects()
     }
 
     CheckVulkanResult(vkResetFences(LogicalDevice, static_cast<std::uint32_t>(std::size(g_Fences)), data(g_Fences)));
+
+    constexpr VkSemaphoreTypeCreateInfo TimelineTypeCreateInfo {
+            .sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+            .semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE,
+            .initialValue = 0U
+    };
+
+    VkSemaphoreCreateInfo const TimelineCreateInfo {.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO, .pNext = &TimelineTypeCreateInfo};
+    CheckVulkanResult(vkCreateSemaphore(LogicalDevice, &TimelineCreateInfo, nullptr, &g_GraphicsTimelineSemaphore));
+    CheckVulkanResult(vkCreateSemaphore(LogicalDevice, &TimelineCreateInfo, nullptr, &g_TransferTimelineSemaphore));
 }
 
 void RenderCore::ReleaseSynchronizationObjects()
 {
     VkDevice const &LogicalDevice = GetLogicalDevice();
-    vkDeviceWaitIdle(LogicalDevice);
+    WaitDeviceIdle();
+
+    for (std::uint32_t Iterator = 0U; Iterator < g_ImageCount; ++Iterator)
+    {
+        ReleaseRetiredResources(Iterator);
+    }
 
     for (auto &Semaphore : g_ImageAvailableSemaphores)
     {
@@ -92,12 +148,24 @@ void RenderCore::ReleaseSynchronizationObjects()
         }
     }
 
+    for (VkSemaphore *Semaphore : {&g_GraphicsTimelineSemaphore, &g_TransferTimelineSemaphore})
+    {
+        if (*Semaphore != VK_NULL_HANDLE)
+        {
+            vkDestroySemaphore(LogicalDevice, *Semaphore, nullptr);
+            *Semaphore = VK_NULL_HANDLE;
+        }
+    }
+
     ResetFenceStatus();
 }
 
 void RenderCore::ResetSemaphores()
 {
-    vkQueueWaitIdle(GetGraphicsQueue().second);
+    {
+        std::lock_guard Lock {GetGraphicsQueueMutex()};
+        vkQueueWaitIdle(GetGraphicsQueue().second);
+    }
 
     VkDevice const                 &LogicalDevice = GetLogicalDevice();
     constexpr VkSemaphoreCreateInfo SemaphoreCreateInfo {.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
@@ -136,6 +204,12 @@ void RenderCore::ResetFenceStatus()
 void RenderCore::SetFenceWaitStatus(std::uint32_t const Index, bool const Value)
 {
     g_FenceInUse.at(Index) = Value;
+
+    if (Value)
+    {
+        std::lock_guard Lock { g_RetiredResourcesMutex };
+        g_LastSubmittedFence = Index;
+    }
 }
 
 bool const &RenderCore::GetFenceWaitStatus(std::uint32_t const Index)
@@ -157,3 +231,43 @@ VkFence const &RenderCore::GetFence(std::uint32_t const Index)
 {
     return g_Fences.at(Index);
 }
+
+VkSemaphore const &RenderCore::GetGraphicsTimelineSemaphore()
+{
+    return g_GraphicsTimelineSemaphore;
+}
+
+VkSemaphore const &RenderCore::GetTransferTimelineSemaphore()
+{
+    return g_TransferTimelineSemaphore;
+}
+
+bool RenderCore::IsUploadComplete(UploadTicket const &Ticket)
+{
+    if (Ticket.Semaphore == VK_NULL_HANDLE)
+    {
+        return true;
+    }
+
+    std::uint64_t Value {0U};
+    CheckVulkanResult(vkGetSemaphoreCounterValue(GetLogicalDevice(), Ticket.Semaphore, &Value));
+
+    return Value >= Ticket.Value;
+}
+
+void RenderCore::WaitUpload(UploadTicket const &Ticket)
+{
+    if (Ticket.Semaphore == VK_NULL_HANDLE)
+    {
+        return;
+    }
+
+    VkSemaphoreWaitInfo const WaitInfo {
+            .sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+            .semaphoreCount = 1U,
+            .pSemaphores = &Ticket.Semaphore,
+            .pValues = &Ticket.Value
+    };
+
+    CheckVulkanResult(vkWaitSemaphores(GetLogicalDevice(), &WaitInfo, g_Timeout));
+}
@@ -0,0 +1,277 @@
+// Author: Lucas Vilas-Boas
+// Year : 2024
+// Repo : https://github.com/lucoiso/vulkan-renderer
+
+module;
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <ranges>
+#include <string>
+#include <vector>
+#include <boost/log/trivial.hpp>
+#include <glm/ext.hpp>
+#include <nlohmann/json.hpp>
+
+module RenderCore.Runtime.WorldStreaming;
+
+import RenderCore.Runtime.Loader;
+import RenderCore.Types.ObjectLoadBatch;
+import RenderCore.Types.Transform;
+import RenderCore.Utils.Constants;
+
+using namespace RenderCore;
+
+enum class WorldCellState : std::uint8_t
+{
+    Unloaded,
+    Loading,
+    Loaded,
+    Failed
+};
+
+// Cells are loaded as single file batches, whose status tells a file that failed apart from one that holds no objects
+struct WorldCell
+{
+    std::string                      Path {};
+    Bounds                           CellBounds {};
+    WorldCellState                   State { WorldCellState::Unloaded };
+    std::shared_ptr<ObjectLoadBatch> Load {};
+    std::vector<std::uint32_t>       ObjectIDs {};
+    std::uint32_t                    NumFailures { 0U };
+    std::uint32_t                    RetryCountdown { 0U };
+};
+
+std::vector<WorldCell>                        g_WorldCells {};
+std::vector<std::shared_ptr<ObjectLoadBatch>> g_DetachedWorldLoads {};
+float                                         g_WorldLoadRadius { g_WorldStreamingLoadRadius };
+float                                         g_WorldUnloadRadius { g_WorldStreamingUnloadRadius };
+std::uint32_t                                 g_NumWorldLoadsInFlight { 0U };
+
+float GetDistanceToCell(glm::vec3 const &Position, WorldCell const &Cell)
+{
+    return glm::distance(Position, glm::clamp(Position, Cell.CellBounds.Min, Cell.CellBounds.Max));
+}
+
+bool IsManifestVector(nlohmann::json const &Value)
+{
+    return Value.is_array() && std::size(Value) == 3U && Value[0].is_number() && Value[1].is_number() && Value[2].is_number();
+}
+
+glm::vec3 GetManifestVector(nlohmann::json const &Value)
+{
+    return glm::vec3 { Value[0].get<float>(), Value[1].get<float>(), Value[2].get<float>() };
+}
+
+float GetManifestRadius(nlohmann::json const &Manifest, std::string_view const Key, float const Default)
+{
+    auto const Value = Manifest.find(std::string { Key });
+    return Value != std::end(Manifest) && Value->is_number() ? Value->get<float>() : Default;
+}
+
+// Manifest layout: { "loadRadius": 128, "unloadRadius": 192, "cells": [ { "file": "Cells/0_0.glb", "min": [x, y, z], "max": [x, y, z] } ] }
+// Cell files are relative to the manifest and can be any model the loader accepts, so each one also gets its own mesh cache
+bool RenderCore::OpenWorld(std::string_view const ManifestPath)
+{
+    if (IsWorldOpen())
+    {
+        BOOST_LOG_TRIVIAL(warning) << "[" << __func__ << "]: A world is already open, close it before opening: '" << ManifestPath << "'";
+        return false;
+    }
+
+    std::ifstream Stream(std::filesystem::path { ManifestPath });
+    if (!Stream.is_open())
+    {
+        BOOST_LOG_TRIVIAL(error) << "[" << __func__ << "]: Failed to open world manifest: '" << ManifestPath << "'";
+        return false;
+    }
+
+    nlohmann::json const Manifest = nlohmann::json::parse(Stream, nullptr, false);
+    if (Manifest.is_discarded() || !Manifest.is_object() || !Manifest.contains("cells") || !Manifest["cells"].is_array())
+    {
+        BOOST_LOG_TRIVIAL(error) << "[" << __func__ << "]: Invalid world manifest: '" << ManifestPath << "'";
+        return false;
+    }
+
+    std::filesystem::path const BaseDirectory = std::filesystem::path { ManifestPath }.parent_path();
+    std::vector<WorldCell>      Cells {};
+    Cells.reserve(std::size(Manifest["cells"]));
+
+    for (nlohmann::json const &CellIter : Manifest["cells"])
+    {
+        if (!CellIter.is_object() || !CellIter.contains("file") || !CellIter["file"].is_string() || !CellIter.contains("min") ||
+            !IsManifestVector(CellIter["min"]) || !CellIter.contains("max") || !IsManifestVector(CellIter["max"]))
+        {
+            BOOST_LOG_TRIVIAL(warning) << "[" << __func__ << "]: Skipping invalid cell " << std::size(Cells) << " of world manifest: '" << ManifestPath
+                                       << "'";
+            continue;
+        }
+
+        Cells.push_back({
+                .Path = (BaseDirectory / CellIter["file"].get<std::string>()).string(),
+                .CellBounds = { .Min = GetManifestVector(CellIter["min"]), .Max = GetManifestVector(CellIter["max"]) }
+        });
+    }
+
+    // The world is only open while it has cells, so a manifest without any valid one would be reported as opened but never stream
+    if (std::empty(Cells))
+    {
+        BOOST_LOG_TRIVIAL(error) << "[" << __func__ << "]: World manifest has no valid cells: '" << ManifestPath << "'";
+        return false;
+    }
+
+    g_WorldLoadRadius   = GetManifestRadius(Manifest, "loadRadius", g_WorldStreamingLoadRadius);
+    g_WorldUnloadRadius = std::max(GetManifestRadius(Manifest, "unloadRadius", g_WorldStreamingUnloadRadius), g_WorldLoadRadius);
+    g_WorldCells        = std::move(Cells);
+
+    BOOST_LOG_TRIVIAL(info) << "[" << __func__ << "]: Opened world manifest '" << ManifestPath << "' with " << std::size(g_WorldCells) << " cells";
+
+    return true;
+}
+
+void RenderCore::CloseWorld(std::vector<std::uint32_t> &ObjectsToUnload)
+{
+    for (WorldCell &CellIter : g_WorldCells)
+    {
+        // Loads in flight are only fulfilled when published on this thread, so they are kept aside and released once they land
+        if (CellIter.State == WorldCellState::Loading)
+        {
+            g_DetachedWorldLoads.push_back(std::move(CellIter.Load));
+        }
+
+        ObjectsToUnload.insert(std::end(ObjectsToUnload), std::begin(CellIter.ObjectIDs), std::end(CellIter.ObjectIDs));
+    }
+
+    g_WorldCells.clear();
+    g_NumWorldLoadsInFlight = 0U;
+}
+
+void RenderCore::ReleaseWorldStreamingResources()
+{
+    g_WorldCells.clear();
+    g_DetachedWorldLoads.clear();
+    g_NumWorldLoadsInFlight = 0U;
+}
+
+void RenderCore::UpdateWorldStreaming(glm::vec3 const &Position, std::vector<std::uint32_t> &ObjectsToUnload)
+{
+    std::erase_if(g_DetachedWorldLoads,
+                  [&ObjectsToUnload](std::shared_ptr<ObjectLoadBatch> const &LoadIter)
+                  {
+                      if (!LoadIter->IsComplete())
+                      {
+                          return false;
+                      }
+
+                      std::vector<ObjectLoadResult> const Results   = LoadIter->GetResults();
+                      std::vector<std::uint32_t> const &  ObjectIDs = Results.front().ObjectIDs;
+                      ObjectsToUnload.insert(std::end(ObjectsToUnload), std::begin(ObjectIDs), std::end(ObjectIDs));
+                      return true;
+                  });
+
+    std::vector<std::pair<float, WorldCell *>> CellsToLoad {};
+
+    for (WorldCell &CellIter : g_WorldCells)
+    {
+        float const Distance = GetDistanceToCell(Position, CellIter);
+
+        switch (CellIter.State)
+        {
+            case WorldCellState::Unloaded:
+            {
+                if (Distance <= g_WorldLoadRadius)
+                {
+                    CellsToLoad.emplace_back(Distance, &CellIter);
+                }
+                break;
+            }
+            case WorldCellState::Loading:
+            {
+                if (!CellIter.Load->IsComplete())
+                {
+                    break;
+                }
+
+                --g_NumWorldLoadsInFlight;
+                ObjectLoadResult Result = std::move(CellIter.Load->GetResults().front());
+                CellIter.Load           = nullptr;
+
+                if (Result.Status == ObjectLoadStatus::Failed)
+                {
+                    // Files may still be written or copied in, so the cell is tried again later, waiting longer after each failure
+                    CellIter.RetryCountdown = g_WorldStreamingRetryInterval << std::min(CellIter.NumFailures, g_WorldStreamingMaxRetryShift);
+                    ++CellIter.NumFailures;
+                    CellIter.State = WorldCellState::Failed;
+
+                    BOOST_LOG_TRIVIAL(warning) << "[" << __func__ << "]: Failed to stream world cell: '" << CellIter.Path << "': " << Result.Error
+                                               << ", retrying in " << CellIter.RetryCountdown << " updates";
+                    break;
+                }
+
+                // Cells without objects are kept as loaded and empty, so they are not requested again until evicted
+                CellIter.ObjectIDs   = std::move(Result.ObjectIDs);
+                CellIter.NumFailures = 0U;
+                CellIter.State       = WorldCellState::Loaded;
+                [[fallthrough]];
+            }
+            case WorldCellState::Loaded:
+            {
+                if (Distance > g_WorldUnloadRadius)
+                {
+                    ObjectsToUnload.insert(std::end(ObjectsToUnload), std::begin(CellIter.ObjectIDs), std::end(CellIter.ObjectIDs));
+                    CellIter.ObjectIDs.clear();
+                    CellIter.State = WorldCellState::Unloaded;
+                }
+                break;
+            }
+            case WorldCellState::Failed:
+            {
+                if (--CellIter.RetryCountdown == 0U)
+                {
+                    CellIter.State = WorldCellState::Unloaded;
+                }
+                break;
+            }
+        }
+    }
+
+    // Nearest cells first, and only a few at a time so each publish stays small enough to fit in a frame
+    std::ranges::sort(CellsToLoad,
+                      [](auto const &Lhs, auto const &Rhs)
+                      {
+                          return Lhs.first < Rhs.first;
+                      });
+
+    for (WorldCell *const CellIter : CellsToLoad | std::views::values)
+    {
+        if (g_NumWorldLoadsInFlight >= g_WorldStreamingMaxLoadsInFlight)
+        {
+            break;
+        }
+
+        CellIter->Load  = EnqueueObjectBatchLoad({ CellIter->Path });
+        CellIter->State = WorldCellState::Loading;
+        ++g_NumWorldLoadsInFlight;
+    }
+}
+
+bool RenderCore::IsWorldOpen()
+{
+    return !std::empty(g_WorldCells);
+}
+
+std::uint32_t RenderCore::GetNumWorldCells()
+{
+    return static_cast<std::uint32_t>(std::size(g_WorldCells));
+}
+
+std::uint32_t RenderCore::GetNumResidentWorldCells()
+{
+    return static_cast<std::uint32_t>(std::ranges::count_if(g_WorldCells,
+                                                            [](WorldCell const &CellIter)
+                                                            {
+                                                                return CellIter.State == WorldCellState::Loaded;
+                                                            }));
+}
@@ -5,19 +5,25 @@
 module;
 
 #include <Volk/volk.h>
+#include <atomic>
 #include <format>
 #include <glm/ext.hpp>
+#include <meshoptimizer.h>
 #include <string>
 #include <tiny_gltf.h>
+#include <boost/log/trivial.hpp>
 
 module RenderCore.Factories.Mesh;
 
 import RenderCore.Runtime.Memory;
 import RenderCore.Runtime.Model;
 import RenderCore.Types.Material;
+import RenderCore.Utils.Constants;
 
 using namespace RenderCore;
 
+std::atomic<bool> g_OptimizeMeshIndices { true };
+
 std::shared_ptr<Mesh> RenderCore::ConstructMesh(MeshConstructionInputParameters const &Arguments)
 {
     if (Arguments.Primitive.material < 0)
@@ -28,9 +34,21 @@ std::shared_ptr<Mesh> RenderCore::ConstructMesh(MeshConstructionInputParameters
     std::string const MeshName = std::format("{}_{:03d}", std::empty(Arguments.Mesh.name) ? "None" : Arguments.Mesh.name, Arguments.ID);
     auto              NewMesh  = std::make_shared<Mesh>(Arguments.ID, Arguments.Path, MeshName);
 
-    SetVertexAttributes(NewMesh, Arguments.Model, Arguments.Primitive);
     SetPrimitiveTransform(NewMesh, Arguments.Node);
-    AllocatePrimitiveIndices(NewMesh, Arguments.Model, Arguments.Primitive);
+    SetVertexAttributes(NewMesh, Arguments.Model, Arguments.Buffers, Arguments.Primitive);
+    AllocatePrimitiveIndices(NewMesh, Arguments.Model, Arguments.Buffers, Arguments.Primitive);
+
+    if (g_OptimizeMeshIndices.load())
+    {
+        OptimizeMeshIndices(NewMesh);
+    }
+
+    NewMesh->SetupLODs();
+
+    if (IsMeshShadingEnabled())
+    {
+        NewMesh->SetupMeshlets();
+    }
 
     tinygltf::Material const &MeshMaterial = Arguments.Model.materials.at(Arguments.Primitive.material);
 
@@ -50,6 +68,31 @@ std::shared_ptr<Mesh> RenderCore::ConstructMesh(MeshConstructionInputParameters
                                      .DoubleSided = MeshMaterial.doubleSided
                              });
 
+    return NewMesh;
+}
+
+std::shared_ptr<Mesh> RenderCore::ConstructMeshInstance(MeshConstructionInputParameters const &Arguments, std::shared_ptr<Mesh> const &Source)
+{
+    if (!Source)
+    {
+        return nullptr;
+    }
+
+    std::string const MeshName = std::format("{}_{:03d}", std::empty(Arguments.Mesh.name) ? "None" : Arguments.Mesh.name, Arguments.ID);
+    auto              NewMesh  = std::make_shared<Mesh>(Arguments.ID, Arguments.Path, MeshName);
+
+    SetPrimitiveTransform(NewMesh, Arguments.Node);
+    NewMesh->SetGeometry(Source->GetGeometry());
+    NewMesh->SetMaterialData(Source->GetMaterialData());
+    NewMesh->SetupBounds();
+
+    return NewMesh;
+}
+
+void RenderCore::SetupMeshTextures(std::shared_ptr<Mesh> const &Mesh, MeshConstructionInputParameters const &Arguments)
+{
+    tinygltf::Material const &MeshMaterial = Arguments.Model.materials.at(Arguments.Primitive.material);
+
     std::vector<std::shared_ptr<Texture>> Textures {};
 
     if (MeshMaterial.pbrMetallicRoughness.baseColorTexture.index >= 0)
@@ -87,6 +130,58 @@ std::shared_ptr<Mesh> RenderCore::ConstructMesh(MeshConstructionInputParameters
         Textures.push_back(Texture);
     }
 
-    NewMesh->SetTextures(std::move(Textures));
-    return NewMesh;
+    Mesh->SetTextures(std::move(Textures));
+}
+
+void RenderCore::OptimizeMeshIndices(std::shared_ptr<Mesh> const &Mesh)
+{
+    std::vector<Vertex> const &       SourceVertices = Mesh->GetVertices();
+    std::vector<std::uint32_t> const &SourceIndices  = Mesh->GetIndices();
+
+    if (std::empty(SourceVertices) || std::empty(SourceIndices) || std::size(SourceIndices) % 3U != 0U)
+    {
+        return;
+    }
+
+    std::size_t const NumVertices = std::size(SourceVertices);
+    std::size_t const NumIndices  = std::size(SourceIndices);
+
+    float const SourceACMR = meshopt_analyzeVertexCache(std::data(SourceIndices), NumIndices, NumVertices, g_VertexCacheSize, 0U, 0U).acmr;
+
+    std::vector<std::uint32_t> Indices(NumIndices);
+    meshopt_optimizeVertexCache(std::data(Indices), std::data(SourceIndices), NumIndices, NumVertices);
+
+    meshopt_optimizeOverdraw(std::data(Indices),
+                             std::data(Indices),
+                             NumIndices,
+                             glm::value_ptr(SourceVertices.front().Position),
+                             NumVertices,
+                             sizeof(Vertex),
+                             g_OverdrawThreshold);
+
+    // Vertices are reordered in first-use order, dropping the ones no triangle references
+    std::vector<Vertex> Vertices(NumVertices);
+    Vertices.resize(meshopt_optimizeVertexFetch(std::data(Vertices),
+                                                std::data(Indices),
+                                                NumIndices,
+                                                std::data(SourceVertices),
+                                                NumVertices,
+                                                sizeof(Vertex)));
+
+    float const OptimizedACMR = meshopt_analyzeVertexCache(std::data(Indices), NumIndices, std::size(Vertices), g_VertexCacheSize, 0U, 0U).acmr;
+
+    BOOST_LOG_TRIVIAL(debug) << "[" << __func__ << "]: Mesh '" << Mesh->GetName() << "' ACMR " << SourceACMR << " -> " << OptimizedACMR;
+
+    Mesh->SetVertices(std::move(Vertices));
+    Mesh->SetIndices(std::move(Indices));
+}
+
+bool RenderCore::IsMeshOptimizationEnabled()
+{
+    return g_OptimizeMeshIndices.load();
+}
+
+void RenderCore::SetMeshOptimizationEnabled(bool const Value)
+{
+    g_OptimizeMeshIndices.store(Value);
 }
@@ -5,38 +5,328 @@
 module;
 
 #include <Volk/volk.h>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <execution>
 #include <format>
+#include <ktx.h>
+#include <memory>
+#include <span>
+#include <stb_image.h>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <boost/log/trivial.hpp>
 
 module RenderCore.Factories.Texture;
 
 import RenderCore.Runtime.Memory;
+import RenderCore.Runtime.Device;
 import RenderCore.Types.Texture;
+import RenderCore.Utils.Helpers;
+import RenderCore.Utils.Constants;
 
 using namespace RenderCore;
 
-std::shared_ptr<Texture> RenderCore::ConstructTexture(TextureConstructionInputParameters const &Parameters,
-                                                      TextureConstructionOutputParameters &     Output)
+constexpr std::array<unsigned char, 12U> g_KTX2Identifier { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+bool IsKTX2Image(std::span<unsigned char const> const EncodedImage)
+{
+    return std::size(EncodedImage) >= std::size(g_KTX2Identifier) &&
+           std::equal(std::begin(g_KTX2Identifier), std::end(g_KTX2Identifier), std::begin(EncodedImage));
+}
+
+bool IsSampledFormatSupported(VkFormat const Format)
+{
+    VkFormatProperties FormatProperties {};
+    vkGetPhysicalDeviceFormatProperties(GetPhysicalDevice(), Format, &FormatProperties);
+
+    return (FormatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT) != 0U;
+}
+
+// Picks the best block compressed target for Basis Universal payloads, ordered by quality
+ktx_transcode_fmt_e GetBasisTranscodeFormat()
 {
-    if (std::empty(Parameters.Image.image))
+    if (IsTextureCompressionBCEnabled() && IsSampledFormatSupported(VK_FORMAT_BC7_UNORM_BLOCK))
+    {
+        return KTX_TTF_BC7_RGBA;
+    }
+
+    if (IsTextureCompressionASTCEnabled() && IsSampledFormatSupported(VK_FORMAT_ASTC_4x4_UNORM_BLOCK))
     {
+        return KTX_TTF_ASTC_4x4_RGBA;
+    }
+
+    if (IsTextureCompressionBCEnabled() && IsSampledFormatSupported(VK_FORMAT_BC3_UNORM_BLOCK))
+    {
+        return KTX_TTF_BC3_RGBA;
+    }
+
+    return KTX_TTF_RGBA32;
+}
+
+// Loads a KTX2 container and transcodes it if needed, the returned texture owns the level data copied to the staging arena
+ktxTexture2 *LoadKTX2Image(std::span<unsigned char const> const EncodedImage, DecodedImage &Output)
+{
+    ktxTexture2 *Texture { nullptr };
+
+    if (ktxTexture2_CreateFromMemory(std::data(EncodedImage), std::size(EncodedImage), KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT, &Texture) != KTX_SUCCESS)
+    {
+        BOOST_LOG_TRIVIAL(warning) << "[" << __func__ << "]: Failed to read KTX2 image";
         return nullptr;
     }
 
-    std::string const TextureName = std::format("{}_{:03d}", std::empty(Parameters.Image.name) ? "None" : Parameters.Image.name, Parameters.ID);
-    auto              NewTexture  = std::shared_ptr<Texture>(new Texture { Parameters.ID, Parameters.Image.uri, TextureName }, TextureDeleter {});
+    if (ktxTexture2_NeedsTranscoding(Texture))
+    {
+        if (ktx_error_code_e const Result = ktxTexture2_TranscodeBasis(Texture, GetBasisTranscodeFormat(), 0);
+            Result != KTX_SUCCESS)
+        {
+            BOOST_LOG_TRIVIAL(warning) << "[" << __func__ << "]: Failed to transcode KTX2 image: " << ktxErrorString(Result);
+            ktxTexture_Destroy(ktxTexture(Texture));
+            return nullptr;
+        }
+    }
 
-    auto [Index, Buffer, Allocation] = AllocateTexture(Parameters.AllocationCmdBuffer,
-                                                       std::data(Parameters.Image.image),
-                                                       Parameters.Image.width,
-                                                       Parameters.Image.height,
-                                                       Parameters.Image.component == 3 ? VK_FORMAT_R8G8B8_UNORM : VK_FORMAT_R8G8B8A8_UNORM,
-                                                       Parameters.Image.image.size());
+    auto const Format = static_cast<VkFormat>(Texture->vkFormat);
 
-    Output.StagingBuffer     = std::move(Buffer);
-    Output.StagingAllocation = std::move(Allocation);
+    if (Format == VK_FORMAT_UNDEFINED || Texture->numFaces != 1U || Texture->numLayers != 1U || Texture->baseDepth != 1U ||
+        !IsSampledFormatSupported(Format))
+    {
+        BOOST_LOG_TRIVIAL(warning) << "[" << __func__ << "]: Unsupported KTX2 image layout or format";
+        ktxTexture_Destroy(ktxTexture(Texture));
+        return nullptr;
+    }
+
+    Output.Width  = Texture->baseWidth;
+    Output.Height = Texture->baseHeight;
+    Output.Format = Format;
+    Output.Size   = ktxTexture_GetDataSize(ktxTexture(Texture));
+    Output.LevelOffsets.resize(Texture->numLevels);
+
+    for (std::uint32_t LevelIter = 0U; LevelIter < Texture->numLevels; ++LevelIter)
+    {
+        ktx_size_t LevelOffset { 0U };
+        ktxTexture_GetImageOffset(ktxTexture(Texture), LevelIter, 0U, 0U, &LevelOffset);
+        Output.LevelOffsets.at(LevelIter) = LevelOffset;
+    }
+
+    return Texture;
+}
+
+std::int32_t RenderCore::GetTextureSource(tinygltf::Texture const &Texture)
+{
+    // KHR_texture_basisu keeps the KTX2 image in its own source, the core one is only an optional fallback
+    if (auto const Extension = Texture.extensions.find("KHR_texture_basisu");
+        Extension != std::end(Texture.extensions) && Extension->second.Has("source"))
+    {
+        return Extension->second.Get("source").GetNumberAsInt();
+    }
+
+    return Texture.source;
+}
 
-    NewTexture->SetBufferIndex(Index);
+std::uint64_t RenderCore::GetImageContentHash(std::span<unsigned char const> const EncodedImage)
+{
+    // Every texture shares the same sampler, so the source bytes identify the uploaded image, hits are still checked against its extent and format
+    return std::hash<std::string_view> {}(std::string_view { reinterpret_cast<char const *>(std::data(EncodedImage)), std::size(EncodedImage) });
+}
+
+bool RenderCore::CaptureEncodedImage(tinygltf::Image *,
+                                     int const ImageIndex,
+                                     std::string *,
+                                     std::string *,
+                                     int,
+                                     int,
+                                     unsigned char const *const Bytes,
+                                     int const                  Size,
+                                     void *const                UserData)
+{
+    auto &EncodedImages = *static_cast<std::vector<std::vector<unsigned char>> *>(UserData);
+
+    if (std::size(EncodedImages) <= static_cast<std::size_t>(ImageIndex))
+    {
+        EncodedImages.resize(ImageIndex + 1U);
+    }
 
-    return NewTexture;
+    EncodedImages.at(ImageIndex).assign(Bytes, Bytes + Size);
+
+    return true;
+}
+
+void RenderCore::ConstructTextures(TextureConstructionInputParameters const &Parameters, TextureConstructionOutputParameters &Output)
+{
+    std::vector<std::span<unsigned char const>> const &EncodedImages = Parameters.EncodedImages;
+    Output.Images.resize(std::size(EncodedImages));
+
+    // Transcoding happens on the worker threads, its output is kept alive until copied to the staging arena
+    std::vector<ktxTexture2 *> KTX2Images(std::size(EncodedImages), nullptr);
+
+    std::for_each(std::execution::par,
+                  std::begin(EncodedImages),
+                  std::end(EncodedImages),
+                  [&](std::span<unsigned char const> const &EncodedIter)
+                  {
+                      std::size_t const Index     = std::distance(std::data(EncodedImages), &EncodedIter);
+                      DecodedImage &    ImageIter = Output.Images.at(Index);
+
+                      ImageIter.ContentHash = GetImageContentHash(EncodedIter);
+
+                      if (IsKTX2Image(EncodedIter))
+                      {
+                          KTX2Images.at(Index) = LoadKTX2Image(EncodedIter, ImageIter);
+                      }
+                      else if (std::int32_t Width, Height, Components;
+                          !std::empty(EncodedIter) &&
+                          stbi_info_from_memory(std::data(EncodedIter), static_cast<std::int32_t>(std::size(EncodedIter)), &Width, &Height, &Components))
+                      {
+                          ImageIter.Width  = static_cast<std::uint32_t>(Width);
+                          ImageIter.Height = static_cast<std::uint32_t>(Height);
+                          ImageIter.Size   = static_cast<VkDeviceSize>(Width) * Height * STBI_rgb_alpha;
+                      }
+                  });
+
+    VkDeviceSize StagingSize { 0U };
+    for (DecodedImage &ImageIter : Output.Images)
+    {
+        ImageIter.StagingOffset = StagingSize;
+        StagingSize += AlignUp(ImageIter.Size, g_TextureStagingAlignment);
+    }
+
+    auto const ReleaseKTX2Images = [&KTX2Images]
+    {
+        for (ktxTexture2 *&ImageIter : KTX2Images)
+        {
+            if (ImageIter)
+            {
+                ktxTexture_Destroy(ktxTexture(ImageIter));
+                ImageIter = nullptr;
+            }
+        }
+    };
+
+    if (StagingSize == 0U)
+    {
+        ReleaseKTX2Images();
+        return;
+    }
+
+    Output.Staging = AcquireStagingRegion(StagingSize);
+
+    std::for_each(std::execution::par,
+                  std::begin(Output.Images),
+                  std::end(Output.Images),
+                  [&](DecodedImage &ImageIter)
+                  {
+                      if (ImageIter.Size == 0U)
+                      {
+                          return;
+                      }
+
+                      std::size_t const                    Index       = std::distance(std::data(Output.Images), &ImageIter);
+                      std::span<unsigned char const> const EncodedIter = EncodedImages.at(Index);
+
+                      if (ktxTexture2 *const KTX2Image = KTX2Images.at(Index))
+                      {
+                          auto const *const Data = ktxTexture_GetData(ktxTexture(KTX2Image));
+
+                          std::memcpy(Output.Staging.MappedData + ImageIter.StagingOffset, Data, ImageIter.Size);
+                          return;
+                      }
+
+                      std::int32_t Width, Height, Components;
+                      if (stbi_uc *const Pixels = stbi_load_from_memory(std::data(EncodedIter),
+                                                                        static_cast<std::int32_t>(std::size(EncodedIter)),
+                                                                        &Width,
+                                                                        &Height,
+                                                                        &Components,
+                                                                        STBI_rgb_alpha))
+                      {
+                          std::memcpy(Output.Staging.MappedData + ImageIter.StagingOffset, Pixels, ImageIter.Size);
+                          stbi_image_free(Pixels);
+                      }
+                      else
+                      {
+                          ImageIter.Size = 0U;
+                      }
+                  });
+
+    ReleaseKTX2Images();
+
+    // Images are decoded even when already resident since the mesh cache bakes their data, only the upload is shared
+    std::vector<TextureUploadRegion>                Regions {};
+    std::vector<std::int32_t>                       RegionSources {};
+    std::unordered_map<std::int32_t, std::uint32_t> ImageBufferIDs {};
+
+    for (tinygltf::Texture const &TextureIter : Parameters.Model.textures)
+    {
+        std::int32_t const Source = GetTextureSource(TextureIter);
+        if (Source < 0 || Source >= static_cast<std::int32_t>(std::size(Output.Images)) || Output.Images.at(Source).Size == 0U ||
+            ImageBufferIDs.contains(Source) || std::ranges::find(RegionSources, Source) != std::end(RegionSources))
+        {
+            continue;
+        }
+
+        DecodedImage &ImageIter = Output.Images.at(Source);
+
+        if (std::uint32_t BufferID { 0U };
+            AcquireCachedTexture(ImageIter.ContentHash, { .width = ImageIter.Width, .height = ImageIter.Height }, ImageIter.Format, BufferID))
+        {
+            ImageBufferIDs.emplace(Source, BufferID);
+            continue;
+        }
+
+        // Decoded bytes are only read from the staging memory, the levels streamed later come from the mesh cache baked from it
+        Regions.push_back({
+                .StagingOffset = ImageIter.StagingOffset,
+                .Width = ImageIter.Width,
+                .Height = ImageIter.Height,
+                .Format = ImageIter.Format,
+                .LevelOffsets = ImageIter.LevelOffsets
+        });
+        RegionSources.push_back(Source);
+    }
+
+    if (!std::empty(Regions))
+    {
+        std::vector<std::uint32_t> const BufferIDs = AllocateTextures(Parameters.AllocationCmdBuffer, Output.Staging, std::move(Regions));
+
+        for (std::size_t Iterator = 0U; Iterator < std::size(RegionSources); ++Iterator)
+        {
+            std::int32_t const  Source   = RegionSources.at(Iterator);
+            std::uint32_t const BufferID = BufferIDs.at(Iterator);
+
+            RegisterTextureContent(BufferID, Output.Images.at(Source).ContentHash);
+            ImageBufferIDs.emplace(Source, BufferID);
+        }
+    }
+
+    // The acquired or allocated reference goes to the first texture of each image, the next ones retain their own
+    std::unordered_set<std::int32_t> ConsumedSources {};
+
+    for (std::uint32_t TextureIndex = 0U; TextureIndex < std::size(Parameters.Model.textures); ++TextureIndex)
+    {
+        std::int32_t const Source = GetTextureSource(Parameters.Model.textures.at(TextureIndex));
+
+        auto const BufferID = ImageBufferIDs.find(Source);
+        if (BufferID == std::end(ImageBufferIDs))
+        {
+            continue;
+        }
+
+        if (!ConsumedSources.insert(Source).second)
+        {
+            RetainTexture(BufferID->second);
+        }
+
+        std::uint32_t const    TextureID = Parameters.IDs.at(TextureIndex);
+        tinygltf::Image const &Image     = Parameters.Model.images.at(Source);
+
+        std::string const TextureName = std::format("{}_{:03d}", std::empty(Image.name) ? "None" : Image.name, TextureID);
+        auto              NewTexture  = std::shared_ptr<Texture>(new Texture { TextureID, Image.uri, TextureName }, TextureDeleter {});
+
+        NewTexture->SetBufferIndex(BufferID->second);
+        Output.Textures.emplace(TextureIndex, std::move(NewTexture));
+    }
 }
@@ -5,6 +5,8 @@
 module;
 
 #include <filesystem>
+#include <memory>
+#include <string>
 #include <vector>
 
 // Include vulkan before glfw
@@ -16,6 +18,8 @@ module;
 // Include glfw after vulkan
 #include <execution>
 #include <future>
+#include <mutex>
+#include <boost/log/trivial.hpp>
 #include <GLFW/glfw3.h>
 
 module RenderCore.Renderer;
@@ -27,6 +31,9 @@ import RenderCore.Runtime.Command;
 import RenderCore.Runtime.Pipeline;
 import RenderCore.Runtime.Memory;
 import RenderCore.Runtime.Scene;
+import RenderCore.Runtime.Loader;
+import RenderCore.Runtime.WorldStreaming;
+import RenderCore.Factories.Mesh;
 import RenderCore.Runtime.Model;
 import RenderCore.Runtime.SwapChain;
 import RenderCore.Runtime.Synchronization;
@@ -37,12 +44,14 @@ import RenderCore.Utils.Helpers;
 import RenderCore.Utils.EnumHelpers;
 import RenderCore.Utils.Constants;
 import RenderCore.Types.Allocation;
+import RenderCore.Types.ObjectLoadBatch;
+import RenderCore.Types.Mesh;
+import RenderCore.Types.Texture;
 
 using namespace RenderCore;
 
 auto                       g_StateFlags { RendererStateFlags::NONE };
 auto                       g_ObjectsManagementStateFlags { RendererObjectsManagementStateFlags::NONE };
-std::vector<std::string>   g_ModelsToLoad {};
 std::vector<std::uint32_t> g_ModelsToUnload {};
 double                     g_FrameTime { 0.F };
 double                     g_FrameRateCap { 0.016667F };
@@ -50,27 +59,97 @@ bool                       g_UseVSync { true };
 bool                       g_RenderOffscreen { false };
 bool                       g_EnableImGui { false };
 std::uint32_t              g_ImageIndex { g_ImageCount };
+std::uint32_t              g_FramesSinceResidencyUpdate { 0U };
+std::uint32_t              g_FramesSinceWorldUpdate { 0U };
 
 constexpr RendererStateFlags g_InvalidStatesToRender = RendererStateFlags::PENDING_DEVICE_PROPERTIES_UPDATE |
                                                        RendererStateFlags::PENDING_RESOURCES_DESTRUCTION |
                                                        RendererStateFlags::PENDING_RESOURCES_CREATION | RendererStateFlags::PENDING_PIPELINE_REFRESH |
                                                        RendererStateFlags::INVALID_SIZE;
 
-void RenderCore::DrawFrame(GLFWwindow *const Window, double const DeltaTime, Control *const Owner)
+// Removed objects are retired with the frames in flight, so nothing is waited here and the remaining objects keep their slots
+void ProcessObjectsManagementRequests()
 {
-    g_FrameTime = DeltaTime;
+    // Destroying an object queues its own unload request again, so take the pending requests before processing them
+    std::vector<std::uint32_t> ModelsToUnload {};
+    ModelsToUnload.swap(g_ModelsToUnload);
+
+    bool const ClearScene = HasFlag(g_ObjectsManagementStateFlags, RendererObjectsManagementStateFlags::PENDING_CLEAR);
+
+    if (ClearScene)
+    {
+        DestroyObjects();
+    }
+    else
+    {
+        UnloadObjects(ModelsToUnload);
+    }
+
+    g_ModelsToUnload.clear();
+    RemoveFlags(g_ObjectsManagementStateFlags,
+                RendererObjectsManagementStateFlags::PENDING_CLEAR | RendererObjectsManagementStateFlags::PENDING_UNLOAD);
+
+    SetNumObjectsPerThread(GetNumAllocations());
+}
+
+// Residency changes are evaluated periodically and uploaded on the transfer queue, completed uploads are published as soon as they land
+void UpdateTextureStreaming()
+{
+    if (++g_FramesSinceResidencyUpdate >= g_TextureStreamingFrameInterval)
+    {
+        g_FramesSinceResidencyUpdate = 0U;
+        UpdateTextureResidency(GetTextureScreenCoverage());
+    }
+
+    if (!PublishTextureResidency())
+    {
+        return;
+    }
+
+    for (std::shared_ptr<Object> const &ObjectIter : GetObjects())
+    {
+        if (std::shared_ptr<Mesh> const &Mesh = ObjectIter->GetMesh())
+        {
+            for (std::shared_ptr<Texture> const &TextureIter : Mesh->GetTextures())
+            {
+                TextureIter->SetupTexture();
+            }
+        }
+    }
+
+    GetPipelineDescriptorData().SetupModelsBuffer(GetObjects());
+}
+
+// World cells are loaded through the regular loader, evicted cells are retired with the frames in flight right away instead of waiting on them
+void StreamWorldCells()
+{
+    if (++g_FramesSinceWorldUpdate < g_WorldStreamingFrameInterval)
+    {
+        return;
+    }
 
-    if (HasAnyFlag(g_ObjectsManagementStateFlags))
+    g_FramesSinceWorldUpdate = 0U;
+
+    std::vector<std::uint32_t> ObjectsToUnload {};
+    UpdateWorldStreaming(GetCamera().GetPosition(), ObjectsToUnload);
+
+    if (!std::empty(ObjectsToUnload))
     {
-        AddFlags(g_StateFlags, RendererStateFlags::PENDING_RESOURCES_DESTRUCTION);
+        UnloadObjects(ObjectsToUnload);
+        SetNumObjectsPerThread(GetNumAllocations());
     }
+}
+
+void RenderCore::DrawFrame(GLFWwindow *const Window, double const DeltaTime, Control *const Owner)
+{
+    g_FrameTime = DeltaTime;
 
     if (HasAnyFlag(g_StateFlags, g_InvalidStatesToRender))
     {
         if (!HasFlag(g_StateFlags, RendererStateFlags::PENDING_RESOURCES_CREATION) && HasFlag(g_StateFlags,
                                                                                               RendererStateFlags::PENDING_RESOURCES_DESTRUCTION))
         {
-            CheckVulkanResult(vkDeviceWaitIdle(GetLogicalDevice()));
+            WaitDeviceIdle();
 
             g_ImageIndex = g_ImageCount;
 
@@ -84,34 +163,6 @@ void RenderCore::DrawFrame(GLFWwindow *const Window, double const DeltaTime, Con
             DestroyOffscreenImages();
             ReleasePipelineResources(false);
 
-            if (HasAnyFlag(g_ObjectsManagementStateFlags,
-                           RendererObjectsManagementStateFlags::PENDING_CLEAR | RendererObjectsManagementStateFlags::PENDING_UNLOAD))
-            {
-                if (HasFlag(g_ObjectsManagementStateFlags, RendererObjectsManagementStateFlags::PENDING_CLEAR))
-                {
-                    DestroyObjects();
-                }
-                else if (HasFlag(g_ObjectsManagementStateFlags, RendererObjectsManagementStateFlags::PENDING_UNLOAD))
-                {
-                    UnloadObjects(g_ModelsToUnload);
-                }
-
-                g_ModelsToUnload.clear();
-                RemoveFlags(g_ObjectsManagementStateFlags,
-                            RendererObjectsManagementStateFlags::PENDING_CLEAR | RendererObjectsManagementStateFlags::PENDING_UNLOAD);
-            }
-
-            if (HasFlag(g_ObjectsManagementStateFlags, RendererObjectsManagementStateFlags::PENDING_LOAD))
-            {
-                for (auto const &ModelPath : g_ModelsToLoad)
-                {
-                    LoadScene(ModelPath);
-                }
-
-                g_ModelsToLoad.clear();
-                RemoveFlags(g_ObjectsManagementStateFlags, RendererObjectsManagementStateFlags::PENDING_LOAD);
-            }
-
             RemoveFlags(g_StateFlags, RendererStateFlags::PENDING_RESOURCES_DESTRUCTION);
             AddFlags(g_StateFlags, RendererStateFlags::PENDING_RESOURCES_CREATION);
         }
@@ -167,16 +218,32 @@ void RenderCore::DrawFrame(GLFWwindow *const Window, double const DeltaTime, Con
             RemoveFlags(g_StateFlags, RendererStateFlags::PENDING_PIPELINE_REFRESH);
         }
     }
-    else if (RequestSwapChainImage(g_ImageIndex))
+    else
     {
-        DrawImGuiFrame(Owner);
+        if (HasAnyFlag(g_ObjectsManagementStateFlags))
+        {
+            ProcessObjectsManagementRequests();
+        }
+
+        if (HasLoadedObjectsToPublish())
+        {
+            PublishLoadedObjects();
+        }
+
+        StreamWorldCells();
+        UpdateTextureStreaming();
 
-        UpdateSceneUniformBuffer();
-        Tick();
+        if (RequestSwapChainImage(g_ImageIndex))
+        {
+            DrawImGuiFrame(Owner);
+
+            UpdateSceneUniformBuffer();
+            Tick();
 
-        RecordCommandBuffers(g_ImageIndex);
-        SubmitCommandBuffers(g_ImageIndex);
-        PresentFrame(g_ImageIndex);
+            RecordCommandBuffers(g_ImageIndex);
+            SubmitCommandBuffers(g_ImageIndex);
+            PresentFrame(g_ImageIndex);
+        }
     }
 }
 
@@ -203,11 +270,12 @@ bool RenderCore::Initialize(GLFWwindow *const Window, bool const EnableImGui)
     volkLoadDevice(GetLogicalDevice());
 
     InitializeCommandsResources(GetGraphicsQueue().first);
+    InitializeLoaderResources();
     CreateSynchronizationObjects();
     CreateMemoryAllocator();
     CreateSceneUniformBuffer();
     CreateImageSampler();
-    CompileDefaultShaders();
+    CompileDefaultShaders(GetVertexFormat());
     auto const SurfaceProperties = GetSurfaceProperties(Window);
     AllocateEmptyTexture(SurfaceProperties.Format.format);
 
@@ -223,6 +291,8 @@ void RenderCore::Shutdown(Control *Window)
         return;
     }
 
+    ReleaseWorldStreamingResources();
+    ReleaseLoaderResources();
     ReleaseSynchronizationObjects();
     ReleaseCommandsResources();
 
@@ -276,10 +346,14 @@ RendererStateFlags Renderer::GetStateFlags()
     return g_StateFlags;
 }
 
-void Renderer::RequestLoadObject(std::string_view const ObjectPath)
+std::shared_future<std::vector<std::uint32_t>> Renderer::RequestLoadObject(std::string_view const ObjectPath)
+{
+    return EnqueueObjectLoad(ObjectPath);
+}
+
+std::shared_ptr<ObjectLoadBatch> Renderer::RequestLoadObjects(std::vector<std::string> const &ObjectPaths)
 {
-    g_ModelsToLoad.emplace_back(ObjectPath);
-    AddFlags(g_ObjectsManagementStateFlags, RendererObjectsManagementStateFlags::PENDING_LOAD);
+    return EnqueueObjectBatchLoad(ObjectPaths);
 }
 
 void Renderer::RequestUnloadObjects(std::vector<std::uint32_t> const &ObjectIDs)
@@ -290,9 +364,34 @@ void Renderer::RequestUnloadObjects(std::vector<std::uint32_t> const &ObjectIDs)
 
 void Renderer::RequestClearScene()
 {
+    // Streamed cells are part of the scene, so clearing it also closes the world
+    std::vector<std::uint32_t> WorldObjects {};
+    CloseWorld(WorldObjects);
+
     AddFlags(g_ObjectsManagementStateFlags, RendererObjectsManagementStateFlags::PENDING_CLEAR);
 }
 
+bool Renderer::RequestOpenWorld(std::string_view const ManifestPath)
+{
+    return OpenWorld(ManifestPath);
+}
+
+void Renderer::RequestCloseWorld()
+{
+    std::vector<std::uint32_t> WorldObjects {};
+    CloseWorld(WorldObjects);
+
+    if (!std::empty(WorldObjects))
+    {
+        RequestUnloadObjects(WorldObjects);
+    }
+}
+
+std::uint32_t Renderer::GetNumResidentWorldCells()
+{
+    return RenderCore::GetNumResidentWorldCells();
+}
+
 void Renderer::RequestUpdateResources()
 {
     AddFlags(g_StateFlags, RendererStateFlags::PENDING_RESOURCES_DESTRUCTION);
@@ -326,6 +425,33 @@ void Renderer::SetVSync(bool const Value)
     g_UseVSync = Value;
 }
 
+VertexFormat Renderer::GetVertexFormat()
+{
+    return RenderCore::GetVertexFormat();
+}
+
+void Renderer::SetVertexFormat(VertexFormat const Format)
+{
+    // Shaders, pipeline libraries and the unified buffer layout are built for a single format during initialization
+    if (IsInitialized())
+    {
+        BOOST_LOG_TRIVIAL(warning) << "[" << __func__ << "]: The vertex format can only be changed before the renderer is initialized";
+        return;
+    }
+
+    RenderCore::SetVertexFormat(Format);
+}
+
+bool Renderer::IsMeshOptimizationEnabled()
+{
+    return RenderCore::IsMeshOptimizationEnabled();
+}
+
+void Renderer::SetMeshOptimizationEnabled(bool const Value)
+{
+    RenderCore::SetMeshOptimizationEnabled(Value);
+}
+
 bool const &Renderer::GetRenderOffscreen()
 {
     return g_RenderOffscreen;
@@ -10,6 +10,7 @@ module;
 module RenderCore.Types.Allocation;
 
 import RenderCore.Runtime.Device;
+import RenderCore.Utils.Helpers;
 
 using namespace RenderCore;
 
@@ -112,7 +113,7 @@ void DescriptorData::SetDescriptorLayoutSize(VkDeviceSize const &MinAlignment)
     VkDevice const &LogicalDevice = GetLogicalDevice();
 
     vkGetDescriptorSetLayoutSizeEXT(LogicalDevice, SetLayout, &LayoutSize);
-    LayoutSize = LayoutSize + MinAlignment - 1 & ~(MinAlignment - 1);
+    LayoutSize = AlignUp(LayoutSize, MinAlignment);
 
     vkGetDescriptorSetLayoutBindingOffsetEXT(LogicalDevice, SetLayout, 0U, &LayoutOffset);
 }
@@ -4,7 +4,9 @@
 
 module;
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <glm/ext.hpp>
 #include <Volk/volk.h>
 
@@ -305,6 +307,51 @@ bool Camera::CanDrawObject(std::shared_ptr<Object> const &Object) const
     return IsInsideCameraFrustum(Object) && IsInAllowedDistance(Object);
 }
 
+float Camera::GetProjectedSize(std::shared_ptr<Object> const &Object) const
+{
+    std::shared_ptr<Mesh> const &Mesh = Object->GetMesh();
+
+    if (!Mesh)
+    {
+        return 0.F;
+    }
+
+    // Instanced meshes are measured by the bounds of all their instances, so they share one LOD picked for the whole group
+    float const MeshSize = Mesh->GetSize();
+    float const Distance = std::max(length(Mesh->GetCenter() - GetPosition()) - MeshSize * 0.5F, m_NearPlane);
+
+    // World-space size covered by a single pixel at the distance of the mesh
+    float const PixelSize = 2.F * Distance * std::tan(glm::radians(m_FieldOfView) * 0.5F) / static_cast<float>(GetSwapChainExtent().height);
+
+    return MeshSize / PixelSize;
+}
+
+std::uint32_t Camera::SelectLOD(std::shared_ptr<Object> const &Object) const
+{
+    std::shared_ptr<Mesh> const &Mesh = Object->GetMesh();
+
+    if (!Mesh || Mesh->GetNumLODs() <= 1U)
+    {
+        return 0U;
+    }
+
+    float const ProjectedSize = GetProjectedSize(Object);
+
+    std::uint32_t SelectedLOD = 0U;
+
+    for (std::uint32_t LODIter = 1U; LODIter < Mesh->GetNumLODs(); ++LODIter)
+    {
+        if (Mesh->GetLOD(LODIter).Error * ProjectedSize > g_MeshLODPixelError)
+        {
+            break;
+        }
+
+        SelectedLOD = LODIter;
+    }
+
+    return SelectedLOD;
+}
+
 bool Camera::IsRenderDirty() const
 {
     return m_IsRenderDirty;
@@ -4,17 +4,42 @@
 
 module;
 
+#include <algorithm>
+#include <limits>
 #include <string_view>
+#include <vector>
 #include <glm/ext.hpp>
+#include <meshoptimizer.h>
 #include <Volk/volk.h>
 
 module RenderCore.Types.Mesh;
 
 import RenderCore.Runtime.Scene;
 import RenderCore.Runtime.Memory;
+import RenderCore.Runtime.Device;
+import RenderCore.Utils.Constants;
+import RenderCore.Types.UniformBufferObject;
 
 using namespace RenderCore;
 
+VkIndexType SelectIndexType(std::vector<std::uint32_t> const &Indices)
+{
+    // The all-ones value of each width is reserved as the primitive restart index
+    std::uint32_t const MaxIndex = std::empty(Indices) ? 0U : std::ranges::max(Indices);
+
+    if (MaxIndex < std::numeric_limits<std::uint8_t>::max() && IsIndexTypeUint8Enabled())
+    {
+        return VK_INDEX_TYPE_UINT8_EXT;
+    }
+
+    if (MaxIndex < std::numeric_limits<std::uint16_t>::max())
+    {
+        return VK_INDEX_TYPE_UINT16;
+    }
+
+    return VK_INDEX_TYPE_UINT32;
+}
+
 Mesh::Mesh(std::uint32_t const ID, std::string_view const Path)
     : Resource(ID, Path)
 {
@@ -50,11 +75,18 @@ Bounds const &Mesh::GetBounds() const
     return m_Bounds;
 }
 
+void Mesh::SetBounds(Bounds const &Bounds)
+{
+    m_Bounds = Bounds;
+}
+
 void Mesh::SetupBounds()
 {
-    for (const auto &VertexIter : m_Vertices)
+    glm::mat4 const Matrix = m_Transform.GetMatrix();
+
+    for (const auto &VertexIter : m_Geometry->Vertices)
     {
-        glm::vec4 const TransformedVertex = glm::vec4(VertexIter.Position, 1.0f) * m_Transform.GetMatrix();
+        glm::vec4 const TransformedVertex = glm::vec4(VertexIter.Position, 1.0f) * Matrix;
 
         m_Bounds.Min.x = std::min(m_Bounds.Min.x, TransformedVertex.x);
         m_Bounds.Min.y = std::min(m_Bounds.Min.y, TransformedVertex.y);
@@ -68,23 +100,36 @@ void Mesh::SetupBounds()
 
 std::vector<Vertex> const &Mesh::GetVertices() const
 {
-    return m_Vertices;
+    return m_Geometry->Vertices;
 }
 
 void Mesh::SetVertices(std::vector<Vertex> const &Vertices)
 {
-    m_Vertices = Vertices;
+    m_Geometry->Vertices = Vertices;
+}
+
+void Mesh::SetVertices(std::vector<Vertex> &&Vertices)
+{
+    m_Geometry->Vertices = std::move(Vertices);
 }
 
 std::vector<std::uint32_t> const &Mesh::GetIndices() const
 {
-    return m_Indices;
+    return m_Geometry->Indices;
 }
 
 void Mesh::SetIndices(std::vector<std::uint32_t> const &Indices)
 {
-    m_Indices      = Indices;
-    m_NumTriangles = static_cast<std::uint32_t>(std::size(m_Indices) / 3U);
+    m_Geometry->Indices   = Indices;
+    m_Geometry->IndexType = SelectIndexType(m_Geometry->Indices);
+    SetLODs({ MeshLOD { .NumIndices = static_cast<std::uint32_t>(std::size(m_Geometry->Indices)) } });
+}
+
+void Mesh::SetIndices(std::vector<std::uint32_t> &&Indices)
+{
+    m_Geometry->Indices   = std::move(Indices);
+    m_Geometry->IndexType = SelectIndexType(m_Geometry->Indices);
+    SetLODs({ MeshLOD { .NumIndices = static_cast<std::uint32_t>(std::size(m_Geometry->Indices)) } });
 }
 
 std::uint32_t Mesh::GetNumTriangles() const
@@ -92,24 +137,114 @@ std::uint32_t Mesh::GetNumTriangles() const
     return m_NumTriangles;
 }
 
-VkDeviceSize Mesh::GetVertexOffset() const
+std::uint32_t Mesh::GetNumLODs() const
 {
-    return m_VertexOffset;
+    return static_cast<std::uint32_t>(std::size(m_Geometry->LODs));
 }
 
-void Mesh::SetVertexOffset(VkDeviceSize const &VertexOffset)
+MeshLOD const &Mesh::GetLOD(std::uint32_t const Index) const
 {
-    m_VertexOffset = VertexOffset;
+    return m_Geometry->LODs.at(Index);
 }
 
-VkDeviceSize Mesh::GetIndexOffset() const
+void Mesh::SetLODs(std::vector<MeshLOD> const &LODs)
+{
+    m_Geometry->LODs = LODs;
+    m_NumTriangles   = std::empty(LODs) ? 0U : LODs.front().NumIndices / 3U;
+}
+
+void Mesh::SetupLODs()
+{
+    std::vector<Vertex> const & Vertices = m_Geometry->Vertices;
+    std::vector<std::uint32_t> &Indices  = m_Geometry->Indices;
+    std::vector<MeshLOD> &      LODs     = m_Geometry->LODs;
+
+    if (std::empty(LODs) || std::empty(Vertices) || LODs.front().NumIndices < g_MeshLODMinIndices)
+    {
+        return;
+    }
+
+    LODs.resize(1U);
+    Indices.resize(LODs.front().NumIndices);
+
+    // Each level is simplified from the previous one, so the error is accumulated along the chain
+    std::vector<std::uint32_t> SourceIndices { Indices };
+    std::vector<std::uint32_t> SimplifiedIndices(std::size(SourceIndices));
+
+    for (std::uint8_t LODIter = 1U; LODIter < g_MaxMeshLODs; ++LODIter)
+    {
+        std::size_t const TargetIndexCount = static_cast<std::size_t>(static_cast<float>(std::size(SourceIndices)) * g_MeshLODReductionRatio) / 3U * 3U;
+
+        float             ResultError { 0.F };
+        std::size_t const NumIndices = meshopt_simplify(std::data(SimplifiedIndices),
+                                                        std::data(SourceIndices),
+                                                        std::size(SourceIndices),
+                                                        glm::value_ptr(Vertices.front().Position),
+                                                        std::size(Vertices),
+                                                        sizeof(Vertex),
+                                                        TargetIndexCount,
+                                                        g_MeshLODMaxError,
+                                                        0U,
+                                                        &ResultError);
+
+        if (NumIndices == 0U || static_cast<float>(NumIndices) > static_cast<float>(std::size(SourceIndices)) * g_MeshLODMinReduction)
+        {
+            break;
+        }
+
+        LODs.push_back({
+                .FirstIndex = static_cast<std::uint32_t>(std::size(Indices)),
+                .NumIndices = static_cast<std::uint32_t>(NumIndices),
+                .Error = LODs.back().Error + ResultError
+        });
+
+        Indices.insert(std::end(Indices), std::begin(SimplifiedIndices), std::begin(SimplifiedIndices) + NumIndices);
+        SourceIndices.assign(std::begin(SimplifiedIndices), std::begin(SimplifiedIndices) + NumIndices);
+    }
+}
+
+std::shared_ptr<MeshGeometry> const &Mesh::GetGeometry() const
+{
+    return m_Geometry;
+}
+
+void Mesh::SetGeometry(std::shared_ptr<MeshGeometry> const &Geometry)
+{
+    m_Geometry     = Geometry;
+    m_NumTriangles = std::empty(m_Geometry->LODs) ? 0U : m_Geometry->LODs.front().NumIndices / 3U;
+}
+
+VkIndexType Mesh::GetIndexType() const
+{
+    return m_Geometry->IndexType;
+}
+
+VkDeviceSize RenderCore::GetIndexTypeSize(VkIndexType const IndexType)
+{
+    switch (IndexType)
+    {
+        case VK_INDEX_TYPE_UINT8_EXT:
+            return sizeof(std::uint8_t);
+        case VK_INDEX_TYPE_UINT16:
+            return sizeof(std::uint16_t);
+        default:
+            return sizeof(std::uint32_t);
+    }
+}
+
+VkDeviceSize Mesh::GetIndexSize() const
 {
-    return m_IndexOffset;
+    return GetIndexTypeSize(m_Geometry->IndexType);
 }
 
-void Mesh::SetIndexOffset(VkDeviceSize const &IndexOffset)
+VkDeviceSize Mesh::GetVertexOffset() const
 {
-    m_IndexOffset = IndexOffset;
+    return m_Geometry->VertexOffset;
+}
+
+VkDeviceSize Mesh::GetIndexOffset() const
+{
+    return m_Geometry->IndexOffset;
 }
 
 MaterialData const &Mesh::GetMaterialData() const
@@ -137,11 +272,128 @@ void Mesh::SetTextures(std::vector<std::shared_ptr<Texture>> const &Textures)
     }
 }
 
-void Mesh::BindBuffers(VkCommandBuffer const &CommandBuffer, std::uint32_t const NumInstances) const
+void Mesh::SetupMeshlets()
 {
-    VkBuffer const &AllocationBuffer = GetAllocationBuffer();
+    std::vector<Vertex> const &       Vertices = m_Geometry->Vertices;
+    std::vector<std::uint32_t> const &Indices  = m_Geometry->Indices;
+
+    m_Geometry->Meshlets.clear();
+    m_Geometry->MeshletVertices.clear();
+    m_Geometry->MeshletTriangles.clear();
+
+    if (std::empty(Vertices))
+    {
+        return;
+    }
+
+    float const *const PositionData = glm::value_ptr(Vertices.front().Position);
+
+    // Every LOD gets its own clusters so the task shader can cull whichever level is selected
+    for (MeshLOD &LODIter : m_Geometry->LODs)
+    {
+        LODIter.FirstMeshlet = static_cast<std::uint32_t>(std::size(m_Geometry->Meshlets));
+        LODIter.NumMeshlets  = 0U;
+
+        if (LODIter.NumIndices == 0U)
+        {
+            continue;
+        }
+
+        std::size_t const MaxMeshlets = meshopt_buildMeshletsBound(LODIter.NumIndices, g_MaxMeshletVertices, g_MaxMeshletTriangles);
+
+        std::vector<meshopt_Meshlet> SourceMeshlets(MaxMeshlets);
+        std::vector<std::uint32_t>   SourceVertices(MaxMeshlets * g_MaxMeshletVertices);
+        std::vector<std::uint8_t>    SourceTriangles(MaxMeshlets * g_MaxMeshletTriangles * 3U);
+
+        std::size_t const NumMeshlets = meshopt_buildMeshlets(std::data(SourceMeshlets),
+                                                              std::data(SourceVertices),
+                                                              std::data(SourceTriangles),
+                                                              std::data(Indices) + LODIter.FirstIndex,
+                                                              LODIter.NumIndices,
+                                                              PositionData,
+                                                              std::size(Vertices),
+                                                              sizeof(Vertex),
+                                                              g_MaxMeshletVertices,
+                                                              g_MaxMeshletTriangles,
+                                                              g_MeshletConeWeight);
+
+        for (std::size_t MeshletIter = 0U; MeshletIter < NumMeshlets; ++MeshletIter)
+        {
+            meshopt_Meshlet const &SourceMeshlet = SourceMeshlets.at(MeshletIter);
+
+            meshopt_Bounds const Bounds = meshopt_computeMeshletBounds(std::data(SourceVertices) + SourceMeshlet.vertex_offset,
+                                                                       std::data(SourceTriangles) + SourceMeshlet.triangle_offset,
+                                                                       SourceMeshlet.triangle_count,
+                                                                       PositionData,
+                                                                       std::size(Vertices),
+                                                                       sizeof(Vertex));
+
+            m_Geometry->Meshlets.push_back({
+                    .BoundingSphere = glm::vec4 { glm::make_vec3(Bounds.center), Bounds.radius },
+                    .ConeAxisCutoff = glm::vec4 { glm::make_vec3(Bounds.cone_axis), Bounds.cone_cutoff },
+                    .ConeApex = glm::vec4 { glm::make_vec3(Bounds.cone_apex), 0.F },
+                    .VertexOffset = static_cast<std::uint32_t>(std::size(m_Geometry->MeshletVertices)),
+                    .TriangleOffset = static_cast<std::uint32_t>(std::size(m_Geometry->MeshletTriangles)),
+                    .VertexCount = SourceMeshlet.vertex_count,
+                    .TriangleCount = SourceMeshlet.triangle_count
+            });
+
+            m_Geometry->MeshletVertices.insert(std::end(m_Geometry->MeshletVertices),
+                                               std::begin(SourceVertices) + SourceMeshlet.vertex_offset,
+                                               std::begin(SourceVertices) + SourceMeshlet.vertex_offset + SourceMeshlet.vertex_count);
+
+            for (std::uint32_t TriangleIter = 0U; TriangleIter < SourceMeshlet.triangle_count; ++TriangleIter)
+            {
+                std::uint8_t const *const Triangle = std::data(SourceTriangles) + SourceMeshlet.triangle_offset + TriangleIter * 3U;
+                m_Geometry->MeshletTriangles.push_back(Triangle[0] | Triangle[1] << 8U | Triangle[2] << 16U);
+            }
+        }
+
+        LODIter.NumMeshlets = static_cast<std::uint32_t>(NumMeshlets);
+    }
+}
+
+void Mesh::BindBuffers(VkCommandBuffer const &CommandBuffer, std::uint32_t const NumInstances, std::uint32_t const LODIndex) const
+{
+    vkCmdBindVertexBuffers(CommandBuffer, 0U, 1U, &m_Geometry->HeapBuffer, &m_Geometry->VertexOffset);
+    vkCmdBindIndexBuffer(CommandBuffer, m_Geometry->HeapBuffer, m_Geometry->IndexOffset, m_Geometry->IndexType);
+
+    MeshLOD const &LOD = GetLOD(LODIndex);
+    vkCmdDrawIndexed(CommandBuffer, LOD.NumIndices, NumInstances, LOD.FirstIndex, 0U, 0U);
+}
+
+void Mesh::DrawMeshlets(VkCommandBuffer const & CommandBuffer,
+                        VkPipelineLayout const &PipelineLayout,
+                        VkDeviceAddress const   Instances,
+                        std::uint32_t const     NumInstances,
+                        std::uint32_t const     LODIndex) const
+{
+    MeshLOD const &LOD = GetLOD(LODIndex);
+
+    if (LOD.NumMeshlets == 0U)
+    {
+        return;
+    }
+
+    VkDeviceAddress const HeapAddress = m_Geometry->HeapAddress;
+
+    MeshletPushConstants const PushConstants {
+            .Vertices = HeapAddress + m_Geometry->VertexOffset,
+            .Meshlets = HeapAddress + m_Geometry->MeshletOffset + LOD.FirstMeshlet * sizeof(Meshlet),
+            .MeshletVertices = HeapAddress + m_Geometry->MeshletVertexOffset,
+            .MeshletTriangles = HeapAddress + m_Geometry->MeshletTriangleOffset,
+            .Instances = Instances,
+            .CameraPosition = glm::vec4 { GetCamera().GetPosition(), 1.F },
+            .NumMeshlets = LOD.NumMeshlets
+    };
+
+    vkCmdPushConstants(CommandBuffer,
+                       PipelineLayout,
+                       VK_SHADER_STAGE_TASK_BIT_EXT | VK_SHADER_STAGE_MESH_BIT_EXT,
+                       0U,
+                       sizeof(MeshletPushConstants),
+                       &PushConstants);
 
-    vkCmdBindVertexBuffers(CommandBuffer, 0U, 1U, &AllocationBuffer, &m_VertexOffset);
-    vkCmdBindIndexBuffer(CommandBuffer, AllocationBuffer, m_IndexOffset, VK_INDEX_TYPE_UINT32);
-    vkCmdDrawIndexed(CommandBuffer, static_cast<std::uint32_t>(std::size(m_Indices)), NumInstances, 0U, 0U, 0U);
+    // The second dimension selects the instance, so all instances are culled and drawn by a single dispatch
+    vkCmdDrawMeshTasksEXT(CommandBuffer, (LOD.NumMeshlets + g_MeshletsPerTaskGroup - 1U) / g_MeshletsPerTaskGroup, NumInstances, 1U);
 }
@@ -5,7 +5,9 @@
 module;
 
 #include <Volk/volk.h>
+#include <algorithm>
 #include <array>
+#include <cstring>
 #include <glm/ext.hpp>
 #include <string>
 
@@ -76,6 +78,12 @@ void Object::SetInstanceTransform(std::uint32_t const Index, Transform const &Va
     }
 }
 
+void Object::SetInstanceTransforms(std::vector<Transform> const &Value)
+{
+    m_InstanceTransform = Value;
+    m_IsRenderDirty     = true;
+}
+
 glm::vec3 Object::GetPosition() const
 {
     return m_Transform.GetPosition();
@@ -135,6 +143,16 @@ void Object::Destroy()
     Renderer::RequestUnloadObjects({ GetID() });
 }
 
+std::uint32_t Object::GetModelSlot() const
+{
+    return m_ModelSlot;
+}
+
+void Object::SetModelSlot(std::uint32_t const Slot)
+{
+    m_ModelSlot = Slot;
+}
+
 std::uint32_t Object::GetUniformOffset() const
 {
     return m_UniformOffset;
@@ -145,15 +163,33 @@ void Object::SetUniformOffset(std::uint32_t const &Offset)
     m_UniformOffset = Offset;
 }
 
+std::uint32_t Object::GetInstanceOffset() const
+{
+    return m_InstanceOffset;
+}
+
+std::uint32_t Object::GetNumDrawnInstances() const
+{
+    // Instances added after the models buffers were allocated are only drawn once the buffers are set up again
+    return std::clamp(GetNumInstances(), 1U, std::max(m_InstanceCapacity, 1U));
+}
+
+void Object::SetInstanceRange(std::uint32_t const Offset, std::uint32_t const Capacity)
+{
+    m_InstanceOffset   = Offset;
+    m_InstanceCapacity = Capacity;
+}
+
 void Object::SetupUniformDescriptor()
 {
-    m_UniformBufferInfo = GetAllocationBufferDescriptor(m_UniformOffset, sizeof(ModelUniformData));
-    m_MappedData        = GetAllocationMappedData();
+    m_UniformBufferInfo  = GetModelUniformDescriptor(m_UniformOffset, sizeof(ModelUniformData));
+    m_MappedData         = GetModelUniformMappedData();
+    m_InstanceMappedData = GetModelInstanceMappedData();
 }
 
 void Object::UpdateUniformBuffers() const
 {
-    if (!m_MappedData)
+    if (!m_MappedData || !m_InstanceMappedData)
     {
         return;
     }
@@ -176,11 +212,26 @@ void Object::UpdateUniformBuffers() const
         };
 
         std::memcpy(static_cast<char *>(m_MappedData) + GetUniformOffset(), &UpdatedModelUBO, ModelUBOSize);
+
+        // Objects without instances still own a single identity entry, so every draw reads the instance binding the same way
+        auto *const InstanceData = static_cast<ModelInstanceData *>(m_InstanceMappedData) + m_InstanceOffset;
+        if (std::empty(m_InstanceTransform))
+        {
+            *InstanceData = ModelInstanceData {};
+        }
+        else
+        {
+            for (std::uint32_t Iterator = 0U; Iterator < GetNumDrawnInstances(); ++Iterator)
+            {
+                InstanceData[Iterator] = ModelInstanceData { .Transform = m_InstanceTransform.at(Iterator).GetMatrix() };
+            }
+        }
+
         m_IsRenderDirty = false;
     }
 }
 
-void Object::DrawObject(VkCommandBuffer const &CommandBuffer, VkPipelineLayout const &PipelineLayout, std::uint32_t const ObjectIndex) const
+void Object::DrawObject(VkCommandBuffer const &CommandBuffer, VkPipelineLayout const &PipelineLayout, std::uint32_t const LODIndex) const
 {
     if (!m_Mesh)
     {
@@ -216,8 +267,8 @@ void Object::DrawObject(VkCommandBuffer const &CommandBuffer, VkPipelineLayout c
 
     std::array const BufferOffsets {
             SceneData.LayoutOffset,
-            ObjectIndex * ModelData.LayoutSize + ModelData.LayoutOffset,
-            ObjectIndex * NumTextures * TextureData.LayoutSize + TextureData.LayoutOffset
+            m_ModelSlot * ModelData.LayoutSize + ModelData.LayoutOffset,
+            m_ModelSlot * NumTextures * TextureData.LayoutSize + TextureData.LayoutOffset
     };
 
     vkCmdSetDescriptorBufferOffsetsEXT(CommandBuffer,
@@ -228,7 +279,18 @@ void Object::DrawObject(VkCommandBuffer const &CommandBuffer, VkPipelineLayout c
                                        std::data(BufferIndices),
                                        std::data(BufferOffsets));
 
-    m_Mesh->BindBuffers(CommandBuffer, std::empty(m_InstanceTransform) ? 1U : GetNumInstances());
+    std::uint32_t const NumInstances   = GetNumDrawnInstances();
+    VkDeviceSize const  InstanceOffset = m_InstanceOffset * sizeof(ModelInstanceData);
+
+    if (GetMeshPipeline() != VK_NULL_HANDLE)
+    {
+        m_Mesh->DrawMeshlets(CommandBuffer, PipelineLayout, GetModelInstanceBufferAddress() + InstanceOffset, NumInstances, LODIndex);
+    }
+    else
+    {
+        vkCmdBindVertexBuffers(CommandBuffer, 1U, 1U, &GetModelInstanceBuffer(), &InstanceOffset);
+        m_Mesh->BindBuffers(CommandBuffer, NumInstances, LODIndex);
+    }
 }
 
 std::shared_ptr<Mesh> Object::GetMesh() const
@@ -0,0 +1,118 @@
+// Author: Lucas Vilas-Boas
+// Year : 2024
+// Repo : https://github.com/lucoiso/vulkan-renderer
+
+module;
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+module RenderCore.Types.ObjectLoadBatch;
+
+using namespace RenderCore;
+
+ObjectLoadBatch::ObjectLoadBatch(std::vector<std::string> const &Paths)
+{
+    m_Results.reserve(std::size(Paths));
+
+    for (std::string const &PathIter : Paths)
+    {
+        m_Results.push_back({ .Path = PathIter });
+    }
+}
+
+std::uint32_t ObjectLoadBatch::GetNumFiles() const
+{
+    return static_cast<std::uint32_t>(std::size(m_Results));
+}
+
+std::uint32_t ObjectLoadBatch::GetNumParsed() const
+{
+    return m_NumParsed.load();
+}
+
+std::uint32_t ObjectLoadBatch::GetNumCompleted() const
+{
+    return m_NumCompleted.load();
+}
+
+std::uint32_t ObjectLoadBatch::GetNumFailed() const
+{
+    return m_NumFailed.load();
+}
+
+float ObjectLoadBatch::GetProgress() const
+{
+    if (std::empty(m_Results))
+    {
+        return 1.F;
+    }
+
+    // Parsing and building each account for half of a file
+    auto const NumSteps = static_cast<float>(m_NumParsed.load() + m_NumCompleted.load());
+    return NumSteps / static_cast<float>(2U * std::size(m_Results));
+}
+
+bool ObjectLoadBatch::IsComplete() const
+{
+    return m_NumCompleted.load() == GetNumFiles();
+}
+
+std::string ObjectLoadBatch::GetPath(std::uint32_t const Index) const
+{
+    return m_Results.at(Index).Path;
+}
+
+std::vector<ObjectLoadResult> ObjectLoadBatch::GetResults() const
+{
+    std::lock_guard Lock { m_Mutex };
+    return m_Results;
+}
+
+void ObjectLoadBatch::SetParsed(std::uint32_t const Index)
+{
+    {
+        std::lock_guard Lock { m_Mutex };
+        m_Results.at(Index).Status = ObjectLoadStatus::Parsed;
+    }
+
+    m_NumParsed.fetch_add(1U);
+}
+
+// Files without any mesh are still loaded, only with no objects, so callers can tell them apart from files that failed
+void ObjectLoadBatch::SetLoaded(std::uint32_t const Index, std::vector<std::uint32_t> &&ObjectIDs)
+{
+    {
+        std::lock_guard Lock { m_Mutex };
+        ObjectLoadResult &Result = m_Results.at(Index);
+        Result.Status            = ObjectLoadStatus::Loaded;
+        Result.ObjectIDs         = std::move(ObjectIDs);
+    }
+
+    m_NumCompleted.fetch_add(1U);
+}
+
+void ObjectLoadBatch::SetFailed(std::uint32_t const Index, std::string_view const Error)
+{
+    bool WasParsed { false };
+    {
+        std::lock_guard Lock { m_Mutex };
+        ObjectLoadResult &Result = m_Results.at(Index);
+        WasParsed                = Result.Status == ObjectLoadStatus::Parsed;
+        Result.Status            = ObjectLoadStatus::Failed;
+        Result.Error             = Error;
+    }
+
+    // Failed files still count as fully processed for the progress
+    if (!WasParsed)
+    {
+        m_NumParsed.fetch_add(1U);
+    }
+
+    m_NumFailed.fetch_add(1U);
+    m_NumCompleted.fetch_add(1U);
+}
@@ -4,6 +4,7 @@
 
 module;
 
+#include <algorithm>
 #include <filesystem>
 #include <format>
 #include <regex>
@@ -137,9 +138,11 @@ std::vector<std::string> RenderCore::GetAvailableInstanceExtensionsNames()
     return Output;
 }
 
-VkVertexInputBindingDescription RenderCore::GetBindingDescriptors(std::uint32_t const InBinding)
+VkVertexInputBindingDescription RenderCore::GetBindingDescriptors(std::uint32_t const     InBinding,
+                                                                  std::uint32_t const     Stride,
+                                                                  VkVertexInputRate const InputRate)
 {
-    return VkVertexInputBindingDescription { .binding = InBinding, .stride = sizeof(Vertex), .inputRate = VK_VERTEX_INPUT_RATE_VERTEX };
+    return VkVertexInputBindingDescription { .binding = InBinding, .stride = Stride, .inputRate = InputRate };
 }
 
 std::vector<VkVertexInputAttributeDescription> RenderCore::GetAttributeDescriptions(std::uint32_t const                                   InBinding,
@@ -159,6 +162,77 @@ std::vector<VkVertexInputAttributeDescription> RenderCore::GetAttributeDescripti
     return Output;
 }
 
+VkDeviceSize RenderCore::GetImageLevelSize(VkFormat const Format, std::uint32_t const Width, std::uint32_t const Height)
+{
+    std::uint32_t BlockSize { 0U };
+    std::uint32_t BlockExtent { 1U };
+
+    switch (Format)
+    {
+        case VK_FORMAT_R8_UNORM:
+        case VK_FORMAT_R8_SRGB:
+            BlockSize = 1U;
+            break;
+        case VK_FORMAT_R8G8_UNORM:
+        case VK_FORMAT_R8G8_SRGB:
+            BlockSize = 2U;
+            break;
+        case VK_FORMAT_R8G8B8A8_UNORM:
+        case VK_FORMAT_R8G8B8A8_SRGB:
+        case VK_FORMAT_B8G8R8A8_UNORM:
+        case VK_FORMAT_B8G8R8A8_SRGB:
+            BlockSize = 4U;
+            break;
+        case VK_FORMAT_R16G16B16A16_SFLOAT:
+            BlockSize = 8U;
+            break;
+        case VK_FORMAT_R32G32B32A32_SFLOAT:
+            BlockSize = 16U;
+            break;
+        case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+        case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+        case VK_FORMAT_BC4_UNORM_BLOCK:
+        case VK_FORMAT_BC4_SNORM_BLOCK:
+        case VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK:
+        case VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK:
+        case VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK:
+        case VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK:
+        case VK_FORMAT_EAC_R11_UNORM_BLOCK:
+        case VK_FORMAT_EAC_R11_SNORM_BLOCK:
+            BlockSize   = 8U;
+            BlockExtent = 4U;
+            break;
+        case VK_FORMAT_BC2_UNORM_BLOCK:
+        case VK_FORMAT_BC2_SRGB_BLOCK:
+        case VK_FORMAT_BC3_UNORM_BLOCK:
+        case VK_FORMAT_BC3_SRGB_BLOCK:
+        case VK_FORMAT_BC5_UNORM_BLOCK:
+        case VK_FORMAT_BC5_SNORM_BLOCK:
+        case VK_FORMAT_BC6H_UFLOAT_BLOCK:
+        case VK_FORMAT_BC6H_SFLOAT_BLOCK:
+        case VK_FORMAT_BC7_UNORM_BLOCK:
+        case VK_FORMAT_BC7_SRGB_BLOCK:
+        case VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK:
+        case VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK:
+        case VK_FORMAT_EAC_R11G11_UNORM_BLOCK:
+        case VK_FORMAT_EAC_R11G11_SNORM_BLOCK:
+        case VK_FORMAT_ASTC_4x4_UNORM_BLOCK:
+        case VK_FORMAT_ASTC_4x4_SRGB_BLOCK:
+            BlockSize   = 16U;
+            BlockExtent = 4U;
+            break;
+        default:
+            return 0U;
+    }
+
+    VkDeviceSize const BlocksX = (std::max(Width, 1U) + BlockExtent - 1U) / BlockExtent;
+    VkDeviceSize const BlocksY = (std::max(Height, 1U) + BlockExtent - 1U) / BlockExtent;
+
+    return BlocksX * BlocksY * BlockSize;
+}
+
 std::vector<VkExtensionProperties> RenderCore::GetAvailableInstanceLayerExtensions(std::string_view const LayerName)
 {
     if (std::vector<std::string> const AvailableLayers = GetAvailableInstanceLayersNames();
@@ -12,9 +12,18 @@ export module RenderCore.Runtime.Command;
 
 import RenderCore.Types.Object;
 import RenderCore.Types.Camera;
+import RenderCore.Runtime.Synchronization;
 
 namespace RenderCore
 {
+    // Copies recorded for the transfer queue, with the barriers the graphics queue uses to acquire the images they fill
+    export struct TransferCommands
+    {
+        VkCommandPool                      CommandPool { VK_NULL_HANDLE };
+        VkCommandBuffer                    CommandBuffer { VK_NULL_HANDLE };
+        std::vector<VkImageMemoryBarrier2> AcquireBarriers {};
+    };
+
     [[nodiscard]] VkCommandPool CreateCommandPool(std::uint8_t, VkCommandPoolCreateFlags);
     export void                 SetNumObjectsPerThread(std::uint32_t);
     export void                 ResetCommandPool(std::uint32_t);
@@ -24,5 +33,15 @@ namespace RenderCore
     export void                 RecordCommandBuffers(std::uint32_t);
     export void                 SubmitCommandBuffers(std::uint32_t);
     export void                 InitializeSingleCommandQueue(VkCommandPool &, std::vector<VkCommandBuffer> &, std::uint8_t);
-    export void                 FinishSingleCommandQueue(VkQueue const &, VkCommandPool const &, std::vector<VkCommandBuffer> const &);
+
+    // Submissions return as soon as the work is queued, the command pool is destroyed once the GPU has passed the ticket
+    export [[nodiscard]] UploadTicket SubmitSingleCommandQueue(VkCommandPool const &, std::vector<VkCommandBuffer> const &);
+    export void                       FinishSingleCommandQueue(VkCommandPool const &, std::vector<VkCommandBuffer> const &);
+
+    export [[nodiscard]] TransferCommands BeginTransferCommands();
+    export void                           ReleaseTransferredImage(TransferCommands &, VkImage const &, std::uint32_t);
+    export [[nodiscard]] UploadTicket     SubmitTransferCommands(TransferCommands &&);
+
+    // Images must drop their pending acquisitions before being destroyed, or a later frame would record barriers on a dead handle
+    export void DiscardTransferAcquires(VkImage const &);
 } // namespace RenderCore
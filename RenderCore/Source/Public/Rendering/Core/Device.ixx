@@ -4,6 +4,7 @@
 
 module;
 
+#include <mutex>
 #include <string>
 #include <vector>
 #include <GLFW/glfw3.h>
@@ -23,8 +24,17 @@ namespace RenderCore
     export [[nodiscard]] VkDevice &GetLogicalDevice();
     export [[nodiscard]] VkPhysicalDevice &GetPhysicalDevice();
     export [[nodiscard]] std::pair<std::uint8_t, VkQueue> &GetGraphicsQueue();
+    export [[nodiscard]] std::mutex &GetGraphicsQueueMutex();
+    export [[nodiscard]] std::pair<std::uint8_t, VkQueue> &GetTransferQueue();
+    export [[nodiscard]] std::mutex &GetTransferQueueMutex();
+    export [[nodiscard]] bool HasDedicatedTransferQueue();
+    export void WaitDeviceIdle();
     export [[nodiscard]] std::vector<std::uint32_t> GetUniqueQueueFamilyIndicesU32();
     export [[nodiscard]] VkPhysicalDeviceProperties const &GetPhysicalDeviceProperties();
+    export [[nodiscard]] bool IsIndexTypeUint8Enabled();
+    export [[nodiscard]] bool IsMeshShaderEnabled();
+    export [[nodiscard]] bool IsTextureCompressionBCEnabled();
+    export [[nodiscard]] bool IsTextureCompressionASTCEnabled();
 
     [[nodiscard]] std::vector<VkPhysicalDevice> GetAvailablePhysicalDevices();
 
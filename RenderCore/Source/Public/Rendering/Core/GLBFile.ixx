@@ -0,0 +1,39 @@
+// Author: Lucas Vilas-Boas
+// Year : 2024
+// Repo : https://github.com/lucoiso/vulkan-renderer
+
+module;
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tiny_gltf.h>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+export module RenderCore.Runtime.GLBFile;
+
+export namespace RenderCore
+{
+    // Binary glTF read through a file mapping: the BIN chunk is never copied, accessors and embedded images point straight into it
+    class GLBFile
+    {
+        boost::interprocess::file_mapping  m_File {};
+        boost::interprocess::mapped_region m_Region {};
+        std::string_view                   m_JSON {};
+        std::span<unsigned char const>     m_BinaryChunk {};
+        std::int32_t                       m_BinaryBuffer { -1 };
+        std::uint64_t                      m_BinaryLength { 0U };
+
+    public:
+        [[nodiscard]] bool Open(std::string_view, std::string &);
+        [[nodiscard]] bool LoadModel(tinygltf::TinyGLTF &, tinygltf::Model &, std::string &, std::string &, std::string const &);
+
+        [[nodiscard]] std::int32_t                   GetBinaryBufferIndex() const;
+        [[nodiscard]] std::span<unsigned char const> GetBinaryBuffer() const;
+    };
+
+    // EXT_meshopt_compression fallback buffers have neither uri nor data, the loader gets a one byte stub and the decoder allocates them
+    void StubCompressionFallbackBuffers(nlohmann::json &);
+} // namespace RenderCore
@@ -0,0 +1,28 @@
+// Author: Lucas Vilas-Boas
+// Year : 2024
+// Repo : https://github.com/lucoiso/vulkan-renderer
+
+module;
+
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+export module RenderCore.Runtime.Loader;
+
+import RenderCore.Types.ObjectLoadBatch;
+
+export namespace RenderCore
+{
+    void InitializeLoaderResources();
+    void ReleaseLoaderResources();
+
+    [[nodiscard]] std::shared_future<std::vector<std::uint32_t>> EnqueueObjectLoad(std::string_view);
+    [[nodiscard]] std::shared_ptr<ObjectLoadBatch>               EnqueueObjectBatchLoad(std::vector<std::string> const &);
+
+    [[nodiscard]] bool HasLoadedObjectsToPublish();
+    void               PublishLoadedObjects();
+} // namespace RenderCore
@@ -6,7 +6,9 @@ module;
 
 #include <Volk/volk.h>
 #include <memory>
+#include <span>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 #include <vma/vk_mem_alloc.h>
 
@@ -20,9 +22,36 @@ import RenderCore.Types.Texture;
 import RenderCore.Utils.Helpers;
 import RenderCore.Utils.EnumHelpers;
 import RenderCore.Utils.Constants;
+import RenderCore.Runtime.Synchronization;
 
 export namespace RenderCore
 {
+    struct TextureUploadRegion
+    {
+        VkDeviceSize  StagingOffset { 0U };
+        std::uint32_t Width { 0U };
+        std::uint32_t Height { 0U };
+        VkFormat      Format { VK_FORMAT_UNDEFINED };
+
+        // Offsets of a pre-built mip chain relative to StagingOffset, the chain is generated on the GPU when empty
+        std::vector<VkDeviceSize> LevelOffsets {};
+
+        // Stored chain read again when the residency of the image changes, textures without one keep every level resident
+        // The owner keeps the bytes valid, such as the mesh cache mapping they point into, so they are never copied to the heap
+        std::span<unsigned char const> Data {};
+        std::shared_ptr<void const>    DataOwner {};
+    };
+
+    // Slice of the persistently mapped staging ring, or a dedicated buffer when the payload does not fit in it
+    struct StagingRegion
+    {
+        VkBuffer        Buffer { VK_NULL_HANDLE };
+        VkDeviceSize    Offset { 0U };
+        VkDeviceSize    Size { 0U };
+        unsigned char * MappedData { nullptr };
+        VmaAllocation   DedicatedAllocation { VK_NULL_HANDLE };
+    };
+
     void CreateMemoryAllocator();
     void ReleaseMemoryResources();
 
@@ -32,6 +61,10 @@ export namespace RenderCore
     void              CopyBuffer(VkCommandBuffer const &, VkBuffer const &, VkBuffer const &, VkDeviceSize const &);
     void              CreateUniformBuffers(BufferAllocation &, VkDeviceSize, std::string_view);
 
+    [[nodiscard]] StagingRegion AcquireStagingRegion(VkDeviceSize);
+    void                        FlushStagingRegion(StagingRegion const &);
+    void                        ReleaseStagingRegion(StagingRegion const &, UploadTicket const & = {});
+
     void CreateImage(VkFormat const &,
                      VkExtent2D const &,
                      VkImageTiling const &,
@@ -39,23 +72,53 @@ export namespace RenderCore
                      VmaMemoryUsage,
                      std::string_view,
                      VkImage &,
-                     VmaAllocation &);
-    void CreateImageView(VkImage const &, VkFormat const &, VkImageAspectFlags const &, VkImageView &);
+                     VmaAllocation &,
+                     std::uint32_t = 1U);
+    void CreateImageView(VkImage const &, VkFormat const &, VkImageAspectFlags const &, VkImageView &, std::uint32_t = 1U);
     void CreateTextureImageView(ImageAllocation &, VkFormat);
-    void CopyBufferToImage(VkCommandBuffer const &, VkBuffer const &, VkImage const &, VkExtent2D const &);
-
-    [[nodiscard]] std::tuple<std::uint32_t, VkBuffer, VmaAllocation> AllocateTexture(VkCommandBuffer const &,
-                                                                                     unsigned char const *,
-                                                                                     std::uint32_t,
-                                                                                     std::uint32_t,
-                                                                                     VkFormat,
-                                                                                     VkDeviceSize);
-
-    void AllocateModelsBuffers(std::vector<std::shared_ptr<Object>> const &);
-
-    [[nodiscard]] VkBuffer const &       GetAllocationBuffer();
-    [[nodiscard]] void *                 GetAllocationMappedData();
-    [[nodiscard]] VkDescriptorBufferInfo GetAllocationBufferDescriptor(std::uint32_t, std::uint32_t);
+    void CopyBufferToImage(VkCommandBuffer const &, VkBuffer const &, VkImage const &, VkExtent2D const &, VkDeviceSize = 0U, std::uint32_t = 0U);
+
+    [[nodiscard]] std::uint32_t GetTextureMipLevels(VkFormat, VkExtent2D const &);
+    void                        GenerateMipmaps(VkCommandBuffer const &, ImageAllocation const &);
+
+    [[nodiscard]] std::pair<std::uint32_t, StagingRegion> AllocateTexture(VkCommandBuffer const &,
+                                                                          unsigned char const *,
+                                                                          std::uint32_t,
+                                                                          std::uint32_t,
+                                                                          VkFormat,
+                                                                          VkDeviceSize);
+
+    [[nodiscard]] std::vector<std::uint32_t> AllocateTextures(VkCommandBuffer const &, StagingRegion const &, std::vector<TextureUploadRegion> &&);
+    void               AttachTextureSources(std::vector<std::uint32_t> const &, std::vector<TextureUploadRegion> const &);
+    [[nodiscard]] bool BuildTextureLevels(VkFormat, VkExtent2D const &, std::vector<unsigned char> &, std::vector<VkDeviceSize> &);
+
+    void               UpdateTextureResidency(std::unordered_map<std::uint32_t, float> const &);
+    [[nodiscard]] bool PublishTextureResidency();
+
+    [[nodiscard]] bool AcquireCachedTexture(std::uint64_t, VkExtent2D const &, VkFormat, std::uint32_t &);
+    void               RegisterTextureContent(std::uint32_t, std::uint64_t);
+    void               RetainTexture(std::uint32_t);
+
+    [[nodiscard]] MeshGeometryLayout GetGeometryLayout(VkIndexType, std::uint32_t, std::uint32_t, std::uint32_t, std::uint32_t, std::uint32_t);
+    [[nodiscard]] MeshGeometryLayout GetGeometryLayout(MeshGeometry const &);
+    void                             WriteGeometryImage(MeshGeometry const &, unsigned char *);
+
+    void                        AllocateGeometry(std::vector<std::shared_ptr<Object>> const &);
+    void                        AllocateModels(std::vector<std::shared_ptr<Object>> const &);
+    void                        RetireModels(std::vector<std::shared_ptr<Object>> &&);
+    [[nodiscard]] std::uint32_t GetModelSlotCapacity();
+
+    [[nodiscard]] VertexFormat  GetVertexFormat();
+    void                        SetVertexFormat(VertexFormat);
+    [[nodiscard]] std::uint32_t GetVertexStride();
+
+    [[nodiscard]] bool                   IsMeshShadingEnabled();
+    [[nodiscard]] VkBuffer const &       GetModelUniformBuffer();
+    [[nodiscard]] void *                 GetModelUniformMappedData();
+    [[nodiscard]] VkDescriptorBufferInfo GetModelUniformDescriptor(std::uint32_t, std::uint32_t);
+    [[nodiscard]] VkBuffer const &       GetModelInstanceBuffer();
+    [[nodiscard]] void *                 GetModelInstanceMappedData();
+    [[nodiscard]] VkDeviceAddress        GetModelInstanceBufferAddress();
     [[nodiscard]] VkDescriptorImageInfo  GetAllocationImageDescriptor(std::uint32_t);
 
     template <VkImageLayout OldLayout, VkImageLayout NewLayout, VkImageAspectFlags Aspect>
@@ -0,0 +1,85 @@
+// Author: Lucas Vilas-Boas
+// Year : 2024
+// Repo : https://github.com/lucoiso/vulkan-renderer
+
+module;
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <Volk/volk.h>
+
+export module RenderCore.Runtime.MeshCache;
+
+import RenderCore.Types.Vertex;
+import RenderCore.Types.Mesh;
+import RenderCore.Types.Transform;
+import RenderCore.Types.Material;
+
+export namespace RenderCore
+{
+    constexpr std::uint32_t    g_MeshCacheVersion { 12U };
+    constexpr std::string_view g_MeshCacheExtension { ".rcmesh" };
+
+    // Pointers reference either the source model (when baking) or the mapped cache file (when loading)
+    struct CachedTexture
+    {
+        std::string          Name {};
+        std::string          Uri {};
+        std::uint32_t        Width { 0U };
+        std::uint32_t        Height { 0U };
+        VkFormat             Format { VK_FORMAT_R8G8B8A8_UNORM };
+        unsigned char const *Data { nullptr };
+        std::uint64_t        DataSize { 0U };
+        VkDeviceSize const * LevelOffsets { nullptr };
+        std::uint32_t        NumLevels { 0U };
+        std::uint64_t        ContentHash { 0U };
+    };
+
+    // Image holds the geometry heap range exactly as it is written for the session settings the cache was baked with
+    struct CachedGeometry
+    {
+        unsigned char const *Image { nullptr };
+        MeshGeometryLayout   Layout {};
+        MeshLOD const *      LODs { nullptr };
+        std::uint32_t        NumLODs { 0U };
+    };
+
+    struct CachedMesh
+    {
+        std::string                                                              Name {};
+        Transform                                                                MeshTransform {};
+        Bounds                                                                   MeshBounds {};
+        MaterialData                                                             Material {};
+        std::array<std::int32_t, static_cast<std::uint8_t>(TextureType::Count)> TextureIndices {};
+        std::uint32_t                                                            GeometryIndex { 0U };
+        std::vector<Transform>                                                   InstanceTransforms {};
+    };
+
+    class MeshCache
+    {
+        boost::interprocess::file_mapping  m_File {};
+        boost::interprocess::mapped_region m_Region {};
+        std::vector<CachedTexture>         m_Textures {};
+        std::vector<CachedGeometry>        m_Geometries {};
+        std::vector<CachedMesh>            m_Meshes {};
+
+    public:
+        [[nodiscard]] bool Open(std::string_view);
+
+        [[nodiscard]] std::vector<CachedTexture> const & GetTextures() const;
+        [[nodiscard]] std::vector<CachedGeometry> const &GetGeometries() const;
+        [[nodiscard]] std::vector<CachedMesh> const &    GetMeshes() const;
+    };
+
+    [[nodiscard]] std::string GetMeshCachePath(std::string_view);
+    bool                      WriteMeshCache(std::string_view,
+                                             std::vector<CachedTexture> const &,
+                                             std::vector<CachedGeometry> const &,
+                                             std::vector<CachedMesh> const &,
+                                             std::vector<std::string> const &);
+} // namespace RenderCore
@@ -5,8 +5,12 @@
 module;
 
 #include <memory>
+#include <span>
+#include <string>
+#include <string_view>
 #include <tiny_gltf.h>
 #include <unordered_map>
+#include <vector>
 #include <vma/vk_mem_alloc.h>
 
 export module RenderCore.Runtime.Model;
@@ -15,12 +19,38 @@ import RenderCore.Types.Vertex;
 import RenderCore.Types.Material;
 import RenderCore.Types.Mesh;
 import RenderCore.Types.Allocation;
+import RenderCore.Types.Transform;
 
 namespace RenderCore
 {
+    // Bytes of each model buffer, either owned by the parsed model or pointing into a mapped file
+    export using ModelBuffers = std::vector<std::span<unsigned char const>>;
+
+    // Strided view over an accessor: interleaved buffer views advance by byteStride instead of the packed element size
+    struct AccessorView
+    {
+        unsigned char const *Data { nullptr };
+        std::size_t          Stride { 0U };
+        std::uint32_t        Count { 0U };
+        std::uint32_t        NumComponents { 0U };
+        std::int32_t         ComponentType { 0 };
+        bool                 Normalized { false };
+
+        [[nodiscard]] bool IsValid() const
+        {
+            return Data != nullptr;
+        }
+    };
+
     void         InsertIndiceInContainer(std::vector<std::uint32_t> &, tinygltf::Accessor const &, auto const *);
-    float const *GetPrimitiveData(std::string_view const &, tinygltf::Model const &, tinygltf::Primitive const &, std::uint32_t *);
-    export void  SetVertexAttributes(std::shared_ptr<Mesh> const &, tinygltf::Model const &, tinygltf::Primitive const &);
-    export void  AllocatePrimitiveIndices(std::shared_ptr<Mesh> const &, tinygltf::Model const &, tinygltf::Primitive const &);
+    export [[nodiscard]] ModelBuffers GetModelBuffers(tinygltf::Model const &);
+    export [[nodiscard]] bool DecodeCompressedBufferViews(tinygltf::Model const &, ModelBuffers &, std::vector<std::vector<unsigned char>> &, std::string &);
+
+    AccessorView GetAccessorView(std::string_view, tinygltf::Model const &, ModelBuffers const &, tinygltf::Primitive const &);
+    AccessorView GetAccessorView(tinygltf::Model const &, ModelBuffers const &, std::int32_t);
+    export void  SetVertexAttributes(std::shared_ptr<Mesh> const &, tinygltf::Model const &, ModelBuffers const &, tinygltf::Primitive const &);
+    export void  AllocatePrimitiveIndices(std::shared_ptr<Mesh> const &, tinygltf::Model const &, ModelBuffers const &, tinygltf::Primitive const &);
     export void  SetPrimitiveTransform(std::shared_ptr<Mesh> const &, tinygltf::Node const &);
+
+    export [[nodiscard]] std::vector<Transform> GetInstanceTransforms(tinygltf::Model const &, ModelBuffers const &, tinygltf::Node const &);
 } // namespace RenderCore
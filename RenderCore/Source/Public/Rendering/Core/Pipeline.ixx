@@ -20,6 +20,8 @@ export namespace RenderCore
         VkPipeline       MainPipeline { VK_NULL_HANDLE };
         VkPipeline       VertexInputPipeline { VK_NULL_HANDLE };
         VkPipeline       PreRasterizationPipeline { VK_NULL_HANDLE };
+        VkPipeline       MeshPreRasterizationPipeline { VK_NULL_HANDLE };
+        VkPipeline       MeshPipeline { VK_NULL_HANDLE };
         VkPipeline       FragmentOutputPipeline { VK_NULL_HANDLE };
         VkPipeline       FragmentShaderPipeline { VK_NULL_HANDLE };
         VkPipelineLayout PipelineLayout { VK_NULL_HANDLE };
@@ -45,6 +47,7 @@ export namespace RenderCore
         void SetDescriptorLayoutSize();
         void SetupSceneBuffer(BufferAllocation const &);
         void SetupModelsBuffer(std::vector<std::shared_ptr<Object>> const &);
+        void UpdateModelsBuffer(std::vector<std::shared_ptr<Object>> const &);
     };
 
     void CreatePipelineDynamicResources();
@@ -53,6 +56,7 @@ export namespace RenderCore
     void ReleasePipelineResources(bool);
 
     [[nodiscard]] VkPipeline const &      GetMainPipeline();
+    [[nodiscard]] VkPipeline const &      GetMeshPipeline();
     [[nodiscard]] VkPipelineCache const & GetPipelineCache();
     [[nodiscard]] VkPipelineLayout const &GetPipelineLayout();
     [[nodiscard]] PipelineDescriptorData &GetPipelineDescriptorData();
@@ -62,9 +66,10 @@ export namespace RenderCore
         VkPipelineRasterizationStateCreateInfo         RasterizationState {};
         VkPipelineColorBlendAttachmentState            ColorBlendAttachment {};
         VkPipelineMultisampleStateCreateInfo           MultisampleState {};
-        VkVertexInputBindingDescription                VertexBinding {};
+        std::vector<VkVertexInputBindingDescription>   VertexBindings {};
         std::vector<VkVertexInputAttributeDescription> VertexAttributes {};
         std::vector<VkPipelineShaderStageCreateInfo>   ShaderStages {};
+        std::vector<VkPipelineShaderStageCreateInfo>   MeshShaderStages {};
     };
 
     void CreatePipelineLibraries(PipelineData &, PipelineLibraryCreationArguments const &, VkPipelineCreateFlags);
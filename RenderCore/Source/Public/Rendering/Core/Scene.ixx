@@ -5,8 +5,11 @@
 module;
 
 #include <cstdint>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 #include <vma/vk_mem_alloc.h>
 
@@ -20,16 +23,23 @@ import RenderCore.Types.Illumination;
 
 export namespace RenderCore
 {
+    struct ParsedScene;
+
     void CreateSceneUniformBuffer();
     void CreateImageSampler();
     void CreateDepthResources(SurfaceProperties const &);
     void AllocateEmptyTexture(VkFormat);
-    void LoadScene(std::string_view);
+    [[nodiscard]] std::vector<std::shared_ptr<Object>> LoadScene(std::string_view);
+    [[nodiscard]] std::shared_ptr<ParsedScene>          ParseScene(std::string_view, std::string &);
+    [[nodiscard]] std::vector<std::shared_ptr<Object>> BuildScene(ParsedScene &);
+    void                                               InsertObjects(std::vector<std::shared_ptr<Object>> const &);
     void UnloadObjects(std::vector<std::uint32_t> const &);
     void ReleaseSceneResources();
     void DestroyObjects();
     void TickObjects(float);
 
+    [[nodiscard]] std::unordered_map<std::uint32_t, float> GetTextureScreenCoverage();
+
     [[nodiscard]] ImageAllocation const &               GetDepthImage();
     [[nodiscard]] VkSampler const &                     GetSampler();
     [[nodiscard]] std::vector<std::shared_ptr<Object>> &GetObjects();
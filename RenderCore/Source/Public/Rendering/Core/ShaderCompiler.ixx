@@ -12,6 +12,8 @@ module;
 
 export module RenderCore.Runtime.ShaderCompiler;
 
+import RenderCore.Types.Vertex;
+
 export namespace RenderCore
 {
     enum class ShaderType
@@ -33,5 +35,5 @@ export namespace RenderCore
     [[nodiscard]] std::vector<ShaderStageData> const &GetStageData();
     void                                              ReleaseShaderResources();
 
-    void CompileDefaultShaders();
+    void CompileDefaultShaders(VertexFormat);
 } // namespace RenderCore
@@ -6,6 +6,7 @@ module;
 
 #include <Volk/volk.h>
 #include <cstdint>
+#include <functional>
 
 export module RenderCore.Runtime.Synchronization;
 
@@ -14,15 +15,28 @@ import RenderCore.Types.Camera;
 
 export namespace RenderCore
 {
+    // Value the GPU signals on a timeline semaphore once an upload batch has completed
+    struct UploadTicket
+    {
+        VkSemaphore   Semaphore { VK_NULL_HANDLE };
+        std::uint64_t Value { 0U };
+    };
+
+    [[nodiscard]] bool IsUploadComplete(UploadTicket const &);
+    void               WaitUpload(UploadTicket const &);
+
     void                      ResetSemaphores();
     void                      ResetFenceStatus();
     void                      SetFenceWaitStatus(std::uint32_t, bool);
     [[nodiscard]] bool const &GetFenceWaitStatus(std::uint32_t);
     void                      WaitAndResetFence(std::uint32_t);
+    void                      RetireWithFrames(std::function<void()> &&);
     void                      CreateSynchronizationObjects();
     void                      ReleaseSynchronizationObjects();
 
     [[nodiscard]] VkSemaphore const &GetImageAvailableSemaphore(std::uint32_t);
     [[nodiscard]] VkSemaphore const &GetRenderFinishedSemaphore(std::uint32_t);
     [[nodiscard]] VkFence const     &GetFence(std::uint32_t);
+    [[nodiscard]] VkSemaphore const &GetGraphicsTimelineSemaphore();
+    [[nodiscard]] VkSemaphore const &GetTransferTimelineSemaphore();
 } // namespace RenderCore
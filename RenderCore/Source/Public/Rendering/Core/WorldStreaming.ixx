@@ -0,0 +1,26 @@
+// Author: Lucas Vilas-Boas
+// Year : 2024
+// Repo : https://github.com/lucoiso/vulkan-renderer
+
+module;
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include <glm/ext.hpp>
+
+export module RenderCore.Runtime.WorldStreaming;
+
+export namespace RenderCore
+{
+    // A world is a manifest of spatial cells, each stored in its own model file and loaded or evicted based on the distance to the camera
+    [[nodiscard]] bool OpenWorld(std::string_view);
+    void               CloseWorld(std::vector<std::uint32_t> &);
+    void               ReleaseWorldStreamingResources();
+
+    void UpdateWorldStreaming(glm::vec3 const &, std::vector<std::uint32_t> &);
+
+    [[nodiscard]] bool          IsWorldOpen();
+    [[nodiscard]] std::uint32_t GetNumWorldCells();
+    [[nodiscard]] std::uint32_t GetNumResidentWorldCells();
+} // namespace RenderCore
@@ -5,8 +5,10 @@
 module;
 
 #include <memory>
+#include <span>
 #include <tiny_gltf.h>
 #include <unordered_map>
+#include <vector>
 #include <vma/vk_mem_alloc.h>
 
 export module RenderCore.Factories.Mesh;
@@ -21,6 +23,7 @@ namespace RenderCore
         std::uint32_t                                                      ID { 0U };
         std::string_view const &                                           Path {};
         tinygltf::Model const &                                            Model {};
+        std::vector<std::span<unsigned char const>> const &                Buffers {};
         tinygltf::Node const &                                             Node {};
         tinygltf::Mesh const &                                             Mesh {};
         tinygltf::Primitive const &                                        Primitive {};
@@ -28,4 +31,10 @@ namespace RenderCore
     };
 
     export [[nodiscard]] std::shared_ptr<Mesh> ConstructMesh(MeshConstructionInputParameters const &);
+    export [[nodiscard]] std::shared_ptr<Mesh> ConstructMeshInstance(MeshConstructionInputParameters const &, std::shared_ptr<Mesh> const &);
+    export void                                SetupMeshTextures(std::shared_ptr<Mesh> const &, MeshConstructionInputParameters const &);
+    export void                                OptimizeMeshIndices(std::shared_ptr<Mesh> const &);
+
+    export [[nodiscard]] bool IsMeshOptimizationEnabled();
+    export void               SetMeshOptimizationEnabled(bool);
 }; // namespace RenderCore
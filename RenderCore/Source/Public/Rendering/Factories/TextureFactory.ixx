@@ -5,28 +5,51 @@
 module;
 
 #include <memory>
+#include <span>
 #include <tiny_gltf.h>
+#include <unordered_map>
+#include <vector>
 #include <vma/vk_mem_alloc.h>
 
 export module RenderCore.Factories.Texture;
 
 import RenderCore.Types.Texture;
+import RenderCore.Runtime.Memory;
 
 namespace RenderCore
 {
     export struct TextureConstructionInputParameters
     {
-        std::uint32_t          ID { 0U };
-        tinygltf::Image const &Image {};
+        std::vector<std::uint32_t> const &                 IDs {};
+        tinygltf::Model const &                            Model {};
+        std::vector<std::span<unsigned char const>> const &EncodedImages {};
 
         VkCommandBuffer AllocationCmdBuffer { VK_NULL_HANDLE };
     };
 
+    export struct DecodedImage
+    {
+        std::uint32_t             Width { 0U };
+        std::uint32_t             Height { 0U };
+        VkFormat                  Format { VK_FORMAT_R8G8B8A8_UNORM };
+        VkDeviceSize              StagingOffset { 0U };
+        VkDeviceSize              Size { 0U };
+        std::vector<VkDeviceSize> LevelOffsets {};
+        std::uint64_t             ContentHash { 0U };
+    };
+
     export struct TextureConstructionOutputParameters
     {
-        VkBuffer      StagingBuffer {};
-        VmaAllocation StagingAllocation {};
+        std::unordered_map<std::uint32_t, std::shared_ptr<Texture>> Textures {};
+        std::vector<DecodedImage>                                   Images {};
+
+        StagingRegion Staging {};
     };
 
-    export [[nodiscard]] std::shared_ptr<Texture> ConstructTexture(TextureConstructionInputParameters const &, TextureConstructionOutputParameters &);
+    export [[nodiscard]] std::int32_t  GetTextureSource(tinygltf::Texture const &);
+    export [[nodiscard]] std::uint64_t GetImageContentHash(std::span<unsigned char const>);
+
+    export bool CaptureEncodedImage(tinygltf::Image *, int, std::string *, std::string *, int, int, unsigned char const *, int, void *);
+
+    export void ConstructTextures(TextureConstructionInputParameters const &, TextureConstructionOutputParameters &);
 }; // namespace RenderCore
@@ -5,6 +5,7 @@
 module;
 
 #include <cstdint>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -20,6 +21,8 @@ import RenderCore.Types.Camera;
 import RenderCore.Types.Illumination;
 import RenderCore.Types.Transform;
 import RenderCore.Types.Object;
+import RenderCore.Types.ObjectLoadBatch;
+import RenderCore.Types.Vertex;
 import RenderCore.Runtime.Memory;
 import RenderCore.Runtime.Pipeline;
 import RenderCore.Runtime.Command;
@@ -50,12 +53,20 @@ namespace RenderCore
 
         [[nodiscard]] RENDERCOREMODULE_API RendererStateFlags GetStateFlags();
 
-        RENDERCOREMODULE_API void RequestLoadObject(std::string_view);
+        RENDERCOREMODULE_API std::shared_future<std::vector<std::uint32_t>> RequestLoadObject(std::string_view);
+
+        RENDERCOREMODULE_API std::shared_ptr<ObjectLoadBatch> RequestLoadObjects(std::vector<std::string> const &);
 
         RENDERCOREMODULE_API void RequestUnloadObjects(std::vector<std::uint32_t> const &);
 
         RENDERCOREMODULE_API void RequestClearScene();
 
+        RENDERCOREMODULE_API bool RequestOpenWorld(std::string_view);
+
+        RENDERCOREMODULE_API void RequestCloseWorld();
+
+        [[nodiscard]] RENDERCOREMODULE_API std::uint32_t GetNumResidentWorldCells();
+
         RENDERCOREMODULE_API void RequestUpdateResources();
 
         [[nodiscard]] RENDERCOREMODULE_API double const &GetFrameTime();
@@ -68,6 +79,14 @@ namespace RenderCore
 
         RENDERCOREMODULE_API void SetVSync(bool);
 
+        [[nodiscard]] RENDERCOREMODULE_API VertexFormat GetVertexFormat();
+
+        RENDERCOREMODULE_API void SetVertexFormat(VertexFormat);
+
+        [[nodiscard]] RENDERCOREMODULE_API bool IsMeshOptimizationEnabled();
+
+        RENDERCOREMODULE_API void SetMeshOptimizationEnabled(bool);
+
         [[nodiscard]] RENDERCOREMODULE_API bool const &GetRenderOffscreen();
 
         RENDERCOREMODULE_API void SetRenderOffscreen(bool);
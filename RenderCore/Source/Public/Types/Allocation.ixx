@@ -22,6 +22,7 @@ namespace RenderCore
         VmaAllocation Allocation { VK_NULL_HANDLE };
         VkExtent2D    Extent {};
         VkFormat      Format {};
+        std::uint32_t MipLevels { 1U };
 
         [[nodiscard]] bool IsValid() const;
         void               DestroyResources(VmaAllocator const &);
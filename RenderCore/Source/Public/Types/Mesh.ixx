@@ -5,6 +5,7 @@
 module;
 
 #include <memory>
+#include <span>
 #include <string_view>
 #include <vector>
 #include <glm/ext.hpp>
@@ -22,16 +23,82 @@ import RenderCore.Types.Material;
 
 namespace RenderCore
 {
-    export class RENDERCOREMODULE_API Mesh : public Resource
+    // Range of MeshGeometry::Indices drawn for a level of detail, with its simplification error relative to the mesh size
+    export struct MeshLOD
     {
-        Bounds                     m_Bounds {};
-        Transform                  m_Transform {};
-        std::vector<Vertex>        m_Vertices {};
-        std::vector<std::uint32_t> m_Indices {};
-        std::uint32_t              m_NumTriangles { 0U };
+        std::uint32_t FirstIndex { 0U };
+        std::uint32_t NumIndices { 0U };
+        float         Error { 0.F };
+        std::uint32_t FirstMeshlet { 0U };
+        std::uint32_t NumMeshlets { 0U };
+    };
 
-        VkDeviceSize m_VertexOffset { 0U };
-        VkDeviceSize m_IndexOffset { 0U };
+    // Cluster consumed by the task and mesh shaders, bounds and normal cone are in mesh space
+    export struct Meshlet
+    {
+        glm::vec4     BoundingSphere {};
+        glm::vec4     ConeAxisCutoff {};
+        glm::vec4     ConeApex {};
+        std::uint32_t VertexOffset { 0U };
+        std::uint32_t TriangleOffset { 0U };
+        std::uint32_t VertexCount { 0U };
+        std::uint32_t TriangleCount { 0U };
+    };
+
+    // Placement of the vertex, index and meshlet data inside a geometry heap range, offsets are relative to the start of the range
+    export struct MeshGeometryLayout
+    {
+        VkIndexType   IndexType { VK_INDEX_TYPE_UINT32 };
+        std::uint32_t NumVertices { 0U };
+        std::uint32_t NumIndices { 0U };
+        std::uint32_t NumMeshlets { 0U };
+        std::uint32_t NumMeshletVertices { 0U };
+        std::uint32_t NumMeshletTriangles { 0U };
+        VkDeviceSize  IndexStart { 0U };
+        VkDeviceSize  MeshletStart { 0U };
+        VkDeviceSize  MeshletVertexStart { 0U };
+        VkDeviceSize  MeshletTriangleStart { 0U };
+        VkDeviceSize  Size { 0U };
+    };
+
+    // Vertex and index data of a glTF primitive, shared by every node that references the same (mesh, primitive) pair
+    export struct MeshGeometry
+    {
+        std::vector<Vertex>        Vertices {};
+        std::vector<std::uint32_t> Indices {};
+        VkIndexType                IndexType { VK_INDEX_TYPE_UINT32 };
+
+        // LOD 0 covers the source indices, the simplified levels are appended after them and reuse the same vertices
+        std::vector<MeshLOD> LODs {};
+
+        // Only built when the meshlet pipeline is in use, triangles are packed as three 8-bit local indices per element
+        std::vector<Meshlet>       Meshlets {};
+        std::vector<std::uint32_t> MeshletVertices {};
+        std::vector<std::uint32_t> MeshletTriangles {};
+
+        // Heap range image read from the mesh cache, copied to the heap as is in place of the vectors and released once it is written
+        std::span<unsigned char const> CachedImage {};
+        std::shared_ptr<void const>    CachedImageOwner {};
+        MeshGeometryLayout             CachedLayout {};
+
+        // Placement inside the geometry heap page, written once by the loader thread that reserved the range
+        VkBuffer        HeapBuffer { VK_NULL_HANDLE };
+        VkDeviceAddress HeapAddress { 0U };
+        VkDeviceSize    VertexOffset { 0U };
+        VkDeviceSize    IndexOffset { 0U };
+        VkDeviceSize    MeshletOffset { 0U };
+        VkDeviceSize    MeshletVertexOffset { 0U };
+        VkDeviceSize    MeshletTriangleOffset { 0U };
+    };
+
+    export [[nodiscard]] VkDeviceSize GetIndexTypeSize(VkIndexType);
+
+    export class RENDERCOREMODULE_API Mesh : public Resource
+    {
+        Bounds                        m_Bounds {};
+        Transform                     m_Transform {};
+        std::shared_ptr<MeshGeometry> m_Geometry { std::make_shared<MeshGeometry>() };
+        std::uint32_t                 m_NumTriangles { 0U };
 
         MaterialData                          m_MaterialData {};
         std::vector<std::shared_ptr<Texture>> m_Textures {};
@@ -49,21 +116,34 @@ namespace RenderCore
         [[nodiscard]] glm::vec3     GetCenter() const;
         [[nodiscard]] float         GetSize() const;
         [[nodiscard]] Bounds const &GetBounds() const;
+        void                        SetBounds(Bounds const &Bounds);
         void                        SetupBounds();
 
         [[nodiscard]] std::vector<Vertex> const &GetVertices() const;
         void                                     SetVertices(std::vector<Vertex> const &Vertices);
+        void                                     SetVertices(std::vector<Vertex> &&Vertices);
 
         [[nodiscard]] std::vector<std::uint32_t> const &GetIndices() const;
         void                                            SetIndices(std::vector<std::uint32_t> const &Indices);
+        void                                            SetIndices(std::vector<std::uint32_t> &&Indices);
 
         [[nodiscard]] std::uint32_t GetNumTriangles() const;
 
+        [[nodiscard]] std::uint32_t  GetNumLODs() const;
+        [[nodiscard]] MeshLOD const &GetLOD(std::uint32_t) const;
+        void                         SetLODs(std::vector<MeshLOD> const &LODs);
+        void                         SetupLODs();
+        void                         SetupMeshlets();
+
+        [[nodiscard]] std::shared_ptr<MeshGeometry> const &GetGeometry() const;
+        void                                               SetGeometry(std::shared_ptr<MeshGeometry> const &Geometry);
+
+        [[nodiscard]] VkIndexType  GetIndexType() const;
+        [[nodiscard]] VkDeviceSize GetIndexSize() const;
+
         [[nodiscard]] VkDeviceSize GetVertexOffset() const;
-        void                       SetVertexOffset(VkDeviceSize const &VertexOffset);
 
         [[nodiscard]] VkDeviceSize GetIndexOffset() const;
-        void                       SetIndexOffset(VkDeviceSize const &IndexOffset);
 
         [[nodiscard]] MaterialData const &GetMaterialData() const;
         void                              SetMaterialData(MaterialData const &MaterialData);
@@ -71,6 +151,7 @@ namespace RenderCore
         [[nodiscard]] std::vector<std::shared_ptr<Texture>> const &GetTextures() const;
         void                                                       SetTextures(std::vector<std::shared_ptr<Texture>> const &Textures);
 
-        void BindBuffers(VkCommandBuffer const &, std::uint32_t) const;
+        void BindBuffers(VkCommandBuffer const &, std::uint32_t, std::uint32_t) const;
+        void DrawMeshlets(VkCommandBuffer const &, VkPipelineLayout const &, VkDeviceAddress, std::uint32_t, std::uint32_t) const;
     };
 } // namespace RenderCore
@@ -26,9 +26,13 @@ namespace RenderCore
         Transform              m_Transform {};
         std::vector<Transform> m_InstanceTransform {};
         std::shared_ptr<Mesh>  m_Mesh { nullptr };
+        std::uint32_t          m_ModelSlot {};
         std::uint32_t          m_UniformOffset {};
+        std::uint32_t          m_InstanceOffset {};
+        std::uint32_t          m_InstanceCapacity {};
         VkDescriptorBufferInfo m_UniformBufferInfo {};
         void *                 m_MappedData { nullptr };
+        void *                 m_InstanceMappedData { nullptr };
 
     public:
         Object()           = delete;
@@ -50,6 +54,7 @@ namespace RenderCore
 
         [[nodiscard]] Transform const &GetInstanceTransform(std::uint32_t) const;
         void                           SetInstanceTransform(std::uint32_t, Transform const &);
+        void                           SetInstanceTransforms(std::vector<Transform> const &);
 
         [[nodiscard]] glm::vec3 GetPosition() const;
         void                    SetPosition(glm::vec3 const &);
@@ -69,9 +74,16 @@ namespace RenderCore
 
         void Destroy() override;
 
+        [[nodiscard]] std::uint32_t GetModelSlot() const;
+        void                        SetModelSlot(std::uint32_t);
+
         [[nodiscard]] std::uint32_t GetUniformOffset() const;
         void                        SetUniformOffset(std::uint32_t const &);
 
+        [[nodiscard]] std::uint32_t GetInstanceOffset() const;
+        [[nodiscard]] std::uint32_t GetNumDrawnInstances() const;
+        void                        SetInstanceRange(std::uint32_t, std::uint32_t);
+
         void SetupUniformDescriptor();
 
         void UpdateUniformBuffers() const;
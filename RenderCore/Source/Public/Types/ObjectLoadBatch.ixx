@@ -0,0 +1,63 @@
+// Author: Lucas Vilas-Boas
+// Year : 2024
+// Repo : https://github.com/lucoiso/vulkan-renderer
+
+module;
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "RenderCoreModule.hpp"
+
+export module RenderCore.Types.ObjectLoadBatch;
+
+namespace RenderCore
+{
+    export enum class ObjectLoadStatus : std::uint8_t
+    {
+        Pending,
+        Parsed,
+        Loaded,
+        Failed
+    };
+
+    export struct ObjectLoadResult
+    {
+        std::string                Path {};
+        ObjectLoadStatus           Status { ObjectLoadStatus::Pending };
+        std::string                Error {};
+        std::vector<std::uint32_t> ObjectIDs {};
+    };
+
+    export class RENDERCOREMODULE_API ObjectLoadBatch
+    {
+        mutable std::mutex            m_Mutex {};
+        std::vector<ObjectLoadResult> m_Results {};
+        std::atomic<std::uint32_t>    m_NumParsed { 0U };
+        std::atomic<std::uint32_t>    m_NumCompleted { 0U };
+        std::atomic<std::uint32_t>    m_NumFailed { 0U };
+
+    public:
+        ObjectLoadBatch() = delete;
+
+        explicit ObjectLoadBatch(std::vector<std::string> const &);
+
+        [[nodiscard]] std::uint32_t GetNumFiles() const;
+        [[nodiscard]] std::uint32_t GetNumParsed() const;
+        [[nodiscard]] std::uint32_t GetNumCompleted() const;
+        [[nodiscard]] std::uint32_t GetNumFailed() const;
+        [[nodiscard]] float         GetProgress() const;
+        [[nodiscard]] bool          IsComplete() const;
+
+        [[nodiscard]] std::string                   GetPath(std::uint32_t) const;
+        [[nodiscard]] std::vector<ObjectLoadResult> GetResults() const;
+
+        void SetParsed(std::uint32_t);
+        void SetLoaded(std::uint32_t, std::vector<std::uint32_t> &&);
+        void SetFailed(std::uint32_t, std::string_view);
+    };
+} // namespace RenderCore
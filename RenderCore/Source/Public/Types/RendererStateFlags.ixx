@@ -24,8 +24,7 @@ namespace RenderCore
     export enum class RendererObjectsManagementStateFlags : std::uint8_t
     {
         NONE           = 0,
-        PENDING_LOAD   = 1 << 0,
-        PENDING_UNLOAD = 1 << 1,
-        PENDING_CLEAR  = 1 << 2,
+        PENDING_UNLOAD = 1 << 0,
+        PENDING_CLEAR  = 1 << 1,
     };
 } // namespace RenderCore
@@ -5,6 +5,7 @@
 module;
 
 #include <glm/ext.hpp>
+#include <Volk/volk.h>
 
 export module RenderCore.Types.UniformBufferObject;
 
@@ -31,4 +32,22 @@ namespace RenderCore
         alignas(4) std::int32_t AlphaMode {};
         alignas(4) std::int32_t DoubleSided {};
     };
+
+    // Per-instance transform applied before the model matrix, read as an instance-rate vertex attribute or by the meshlet stages
+    export struct ModelInstanceData
+    {
+        glm::mat4 Transform { 1.F };
+    };
+
+    // Push constants read by the task and mesh stages, addresses point into the geometry heap and the instance buffer
+    export struct MeshletPushConstants
+    {
+        VkDeviceAddress Vertices {};
+        VkDeviceAddress Meshlets {};
+        VkDeviceAddress MeshletVertices {};
+        VkDeviceAddress MeshletTriangles {};
+        VkDeviceAddress Instances {};
+        glm::vec4       CameraPosition {};
+        std::uint32_t   NumMeshlets {};
+    };
 } // namespace RenderCore
@@ -4,6 +4,8 @@
 
 module;
 
+#include <cmath>
+#include <cstdint>
 #include <glm/ext.hpp>
 #include <Volk/volk.h>
 
@@ -22,6 +24,54 @@ namespace RenderCore
         glm::vec4 Tangent {};
     };
 
+    export enum class VertexFormat : std::uint8_t
+    {
+        Full,
+        Packed
+    };
+
+    // 32 bytes: half-float UVs, octahedral snorm16 normal/tangent (tangent.z carries the bitangent sign) and unorm8 color
+    export struct PackedVertex
+    {
+        glm::vec3     Position {};
+        std::uint32_t Normal {};
+        glm::uvec2    Tangent {};
+        std::uint32_t TextureCoordinate {};
+        std::uint32_t Color {};
+    };
+
+    export [[nodiscard]] inline glm::vec2 EncodeOctahedral(glm::vec3 const &Direction)
+    {
+        float const L1Norm = std::abs(Direction.x) + std::abs(Direction.y) + std::abs(Direction.z);
+        if (L1Norm <= 0.F)
+        {
+            return glm::vec2 { 0.F };
+        }
+
+        glm::vec2 Output = glm::vec2 { Direction } / L1Norm;
+        if (Direction.z < 0.F)
+        {
+            glm::vec2 const Sign { Output.x >= 0.F ? 1.F : -1.F, Output.y >= 0.F ? 1.F : -1.F };
+            Output = (1.F - glm::abs(glm::vec2 { Output.y, Output.x })) * Sign;
+        }
+
+        return Output;
+    }
+
+    export [[nodiscard]] inline PackedVertex PackVertex(Vertex const &Source)
+    {
+        return PackedVertex {
+                .Position = Source.Position,
+                .Normal = glm::packSnorm2x16(EncodeOctahedral(Source.Normal)),
+                .Tangent = glm::uvec2 {
+                        glm::packSnorm2x16(EncodeOctahedral(glm::vec3 { Source.Tangent })),
+                        glm::packSnorm2x16(glm::vec2 { Source.Tangent.w < 0.F ? -1.F : 1.F, 0.F })
+                },
+                .TextureCoordinate = glm::packHalf2x16(Source.TextureCoordinate),
+                .Color = glm::packUnorm4x8(Source.Color)
+        };
+    }
+
     export namespace VertexAttributes
     {
         constexpr VkVertexInputAttributeDescription Position {
@@ -59,4 +109,32 @@ namespace RenderCore
                 .offset = static_cast<std::uint32_t>(offsetof(Vertex, Tangent))
         };
     } // namespace VertexAttributes
+
+    export namespace PackedVertexAttributes
+    {
+        constexpr VkVertexInputAttributeDescription Position {
+                .format = VK_FORMAT_R32G32B32_SFLOAT,
+                .offset = static_cast<std::uint32_t>(offsetof(PackedVertex, Position))
+        };
+
+        constexpr VkVertexInputAttributeDescription Normal {
+                .format = VK_FORMAT_R16G16_SNORM,
+                .offset = static_cast<std::uint32_t>(offsetof(PackedVertex, Normal))
+        };
+
+        constexpr VkVertexInputAttributeDescription TextureCoordinate {
+                .format = VK_FORMAT_R16G16_SFLOAT,
+                .offset = static_cast<std::uint32_t>(offsetof(PackedVertex, TextureCoordinate))
+        };
+
+        constexpr VkVertexInputAttributeDescription Color {
+                .format = VK_FORMAT_R8G8B8A8_UNORM,
+                .offset = static_cast<std::uint32_t>(offsetof(PackedVertex, Color))
+        };
+
+        constexpr VkVertexInputAttributeDescription Tangent {
+                .format = VK_FORMAT_R16G16B16A16_SNORM,
+                .offset = static_cast<std::uint32_t>(offsetof(PackedVertex, Tangent))
+        };
+    } // namespace PackedVertexAttributes
 }     // namespace RenderCore
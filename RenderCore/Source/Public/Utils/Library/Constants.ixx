@@ -21,7 +21,6 @@ export namespace RenderCore
 
     constexpr std::array g_RequiredDeviceExtensions {
             VK_KHR_SWAPCHAIN_EXTENSION_NAME,
-            VK_EXT_MESH_SHADER_EXTENSION_NAME,
             VK_EXT_MEMORY_BUDGET_EXTENSION_NAME,
             VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME,
             VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME,
@@ -34,7 +33,7 @@ export namespace RenderCore
 
     constexpr std::array<char const *, 0U> g_OptionalInstanceExtensions {};
 
-    constexpr std::array<char const *, 0U> g_OptionalDeviceExtensions {};
+    constexpr std::array g_OptionalDeviceExtensions { VK_EXT_INDEX_TYPE_UINT8_EXTENSION_NAME, VK_EXT_MESH_SHADER_EXTENSION_NAME };
 
     constexpr VkPipelineCreateFlags g_PipelineFlags = VK_PIPELINE_CREATE_LIBRARY_BIT_KHR |
                                                       VK_PIPELINE_CREATE_RETAIN_LINK_TIME_OPTIMIZATION_INFO_BIT_EXT;
@@ -48,6 +47,11 @@ export namespace RenderCore
 
     constexpr auto g_StagingMemoryUsage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
 
+    constexpr VkDeviceSize g_TextureStagingAlignment = 16U;
+
+    // Persistently mapped ring shared by the uploads, larger payloads fall back to a dedicated allocation
+    constexpr VkDeviceSize g_StagingRingSize = 64U * 1024U * 1024U;
+
     constexpr auto g_DescriptorMemoryUsage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
 
     constexpr auto g_ModelMemoryUsage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
@@ -55,8 +59,55 @@ export namespace RenderCore
     constexpr auto g_ModelBufferUsage = VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT |
                                         VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
 
+    constexpr VkDeviceSize g_GeometryHeapInitialSize = 64U * 1024U * 1024U;
+    constexpr VkDeviceSize g_GeometryHeapAlignment   = 16U;
+
+    // Model slots reserved up front in the uniform, instance and descriptor buffers, which double whenever they run out
+    constexpr std::uint32_t g_ModelSlotInitialCapacity = 256U;
+
+    // Each LOD targets a fraction of the previous level and the chain stops once the simplifier no longer reduces it enough
+    constexpr std::uint8_t  g_MaxMeshLODs           = 4U;
+    constexpr std::uint32_t g_MeshLODMinIndices     = 1536U;
+    constexpr float         g_MeshLODReductionRatio = 0.5F;
+    constexpr float         g_MeshLODMinReduction   = 0.85F;
+    constexpr float         g_MeshLODMaxError       = 0.05F;
+
+    // Maximum simplification error, in pixels, accepted when selecting a LOD
+    constexpr float g_MeshLODPixelError = 1.F;
+
+    // Meshlet limits follow the usual sweet spot for EXT_mesh_shader implementations
+    constexpr std::uint32_t g_MaxMeshletVertices   = 64U;
+    constexpr std::uint32_t g_MaxMeshletTriangles  = 124U;
+    constexpr float         g_MeshletConeWeight    = 0.25F;
+    constexpr std::uint32_t g_MeshletsPerTaskGroup = 32U;
+
+    // Post-transform cache size assumed when reordering and analyzing index buffers
+    constexpr std::uint32_t g_VertexCacheSize = 16U;
+
+    // Allowed ACMR degradation when reordering triangles to reduce overdraw
+    constexpr float g_OverdrawThreshold = 1.05F;
+
     constexpr auto g_TextureMemoryUsage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
 
+    // Streamed textures always keep the levels up to the tail size resident, the upper ones only while the image heap stays under the ratio
+    constexpr std::uint32_t g_TextureStreamingTailSize      = 64U;
+    constexpr float         g_TextureStreamingBudgetRatio   = 0.85F;
+    constexpr std::uint32_t g_TextureStreamingMaxUpdates    = 8U;
+    constexpr std::uint32_t g_TextureStreamingFrameInterval = 30U;
+
+    // Files of a batch parsed ahead of the one being built, bounding the parsed models kept in memory
+    constexpr std::uint32_t g_LoaderParseAhead = 2U;
+
+    // World cells are streamed in within the load radius and only evicted past the unload radius, so moving along a border does not thrash
+    constexpr float         g_WorldStreamingLoadRadius       = 128.F;
+    constexpr float         g_WorldStreamingUnloadRadius     = 192.F;
+    constexpr std::uint32_t g_WorldStreamingMaxLoadsInFlight = 2U;
+    constexpr std::uint32_t g_WorldStreamingFrameInterval    = 10U;
+
+    // Streaming updates a failed cell waits before it is tried again, doubled on each consecutive failure up to the shift limit
+    constexpr std::uint32_t g_WorldStreamingRetryInterval = 30U;
+    constexpr std::uint32_t g_WorldStreamingMaxRetryShift = 4U;
+
     constexpr VkSampleCountFlagBits g_MSAASamples = VK_SAMPLE_COUNT_1_BIT;
     constexpr VkImageTiling         g_ImageTiling = VK_IMAGE_TILING_OPTIMAL;
 
@@ -34,6 +34,13 @@ export namespace RenderCore
         return Format >= VK_FORMAT_D16_UNORM_S8_UINT && Format <= VK_FORMAT_D32_SFLOAT_S8_UINT;
     }
 
+    // Alignment must be a power of two
+    template <typename T, typename AlignmentType>
+    [[nodiscard]] constexpr T AlignUp(T const Value, AlignmentType const Alignment)
+    {
+        return (Value + static_cast<T>(Alignment) - 1U) & ~(static_cast<T>(Alignment) - 1U);
+    }
+
     template <typename T>
     constexpr T LoadVulkanProcedure(std::string_view const ProcedureName)
     {
@@ -56,7 +63,10 @@ export namespace RenderCore
 
     [[nodiscard]] std::vector<std::string> GetAvailableInstanceLayerExtensionsNames(std::string_view);
 
-    [[nodiscard]] VkVertexInputBindingDescription GetBindingDescriptors(std::uint32_t);
+    [[nodiscard]] VkVertexInputBindingDescription GetBindingDescriptors(std::uint32_t, std::uint32_t, VkVertexInputRate = VK_VERTEX_INPUT_RATE_VERTEX);
+
+    // Tightly packed size of one level, zero for formats whose layout is not known here
+    [[nodiscard]] VkDeviceSize GetImageLevelSize(VkFormat, std::uint32_t, std::uint32_t);
 
     [[nodiscard]] std::vector<VkVertexInputAttributeDescription> GetAttributeDescriptions(std::uint32_t,
                                                                                           std::vector<VkVertexInputAttributeDescription> const &);
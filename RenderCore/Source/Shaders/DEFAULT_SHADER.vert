@@ -5,6 +5,7 @@ layout(location = 1) in vec3 inNormal;
 layout(location = 2) in vec2 inUV;
 layout(location = 3) in vec4 inColor;
 layout(location = 4) in vec4 inTangent;
+layout(location = 5) in mat4 inInstance;
 
 layout(std140, set = 0, binding = 0) uniform UBOCamera {
     mat4 projection_view;
@@ -47,13 +48,15 @@ layout(location = 1) out FragmentData {
 } fragData;
 
 void main() {
-    vec4 worldPos = uboModel.model * vec4(inPos, 1.0);
+    mat4 model = uboModel.model * inInstance;
+
+    vec4 worldPos = model * vec4(inPos, 1.0);
     vec4 viewPos = uboCamera.projection_view * worldPos;
     gl_Position = viewPos;
 
     fragData.model_uv = inUV;
     fragData.model_view = viewPos.xyz;
-    fragData.model_normal = normalize(mat3(uboModel.model) * inNormal);
+    fragData.model_normal = normalize(mat3(model) * inNormal);
     fragData.model_color = inColor;
     fragData.model_tangent = inTangent;
 
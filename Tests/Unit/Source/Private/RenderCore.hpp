@@ -5,10 +5,28 @@
 #pragma once
 
 #include <Utils.hpp>
+#include <algorithm>
 #include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <future>
+#include <meshoptimizer.h>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <glm/ext.hpp>
+#include <Volk/volk.h>
 
 import RenderCore.UserInterface.Window;
 import RenderCore.Renderer;
+import RenderCore.Types.ObjectLoadBatch;
+import RenderCore.Types.Mesh;
+import RenderCore.Types.Vertex;
 
 // FIXME: Emitting validation errors
 
@@ -73,3 +91,506 @@ TEST_CASE("Scene Management", "[RenderCore]")
         REQUIRE(LoadedObjects[0]->GetName() == ObjectName);
     }
 }
+
+TEST_CASE("Asynchronous Loading", "[RenderCore]")
+{
+    ScopedTestWindow Window;
+
+    std::string const ObjectPath { "Models/Box/glTF/Box.gltf" };
+
+    auto const LoadResult = RenderCore::Renderer::RequestLoadObject(ObjectPath);
+    Window.PollLoop([&LoadResult]
+    {
+        return LoadResult.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+    });
+
+    std::vector<std::uint32_t> const &LoadedIDs = LoadResult.get();
+    REQUIRE_FALSE(std::empty(LoadedIDs));
+    REQUIRE(RenderCore::Renderer::GetNumObjects() == std::size(LoadedIDs));
+    REQUIRE(RenderCore::Renderer::GetObjectByID(LoadedIDs.front())->GetPath() == ObjectPath);
+}
+
+TEST_CASE("Batch Loading", "[RenderCore]")
+{
+    ScopedTestWindow Window;
+
+    std::vector<std::string> const ObjectPaths { "Models/Box/glTF/Box.gltf", "Models/Missing/Missing.gltf", "Models/Box/glTF/Box.gltf" };
+
+    auto const Batch = RenderCore::Renderer::RequestLoadObjects(ObjectPaths);
+    Window.PollLoop([&Batch]
+    {
+        return !Batch->IsComplete();
+    });
+
+    REQUIRE(Batch->GetNumFiles() == std::size(ObjectPaths));
+    REQUIRE(Batch->GetNumFailed() == 1U);
+    REQUIRE(Batch->GetProgress() == 1.F);
+
+    std::vector<RenderCore::ObjectLoadResult> const Results = Batch->GetResults();
+    REQUIRE(Results.at(0U).Status == RenderCore::ObjectLoadStatus::Loaded);
+    REQUIRE(Results.at(1U).Status == RenderCore::ObjectLoadStatus::Failed);
+    REQUIRE_FALSE(std::empty(Results.at(1U).Error));
+    REQUIRE(Results.at(2U).Status == RenderCore::ObjectLoadStatus::Loaded);
+
+    // Files are built in the order they were requested, so a later file always gets the later object IDs
+    REQUIRE(Results.at(0U).ObjectIDs.back() < Results.at(2U).ObjectIDs.front());
+    REQUIRE(RenderCore::Renderer::GetNumObjects() == std::size(Results.at(0U).ObjectIDs) + std::size(Results.at(2U).ObjectIDs));
+}
+
+TEST_CASE("Index Type Selection", "[RenderCore]")
+{
+    auto const GetIndexType = [](std::vector<std::uint32_t> const &Indices)
+    {
+        RenderCore::Mesh Mesh { 0U, "Models/IndexTypeSelection" };
+        Mesh.SetIndices(Indices);
+
+        return Mesh.GetIndexType();
+    };
+
+    // Without an initialized device the 8-bit index type is never enabled, so small meshes fall back to 16-bit indices
+    REQUIRE(GetIndexType({}) == VK_INDEX_TYPE_UINT16);
+    REQUIRE(GetIndexType({ 0U, 1U, 254U }) == VK_INDEX_TYPE_UINT16);
+    REQUIRE(GetIndexType({ 0U, 65534U }) == VK_INDEX_TYPE_UINT16);
+
+    // 65535 is the 16-bit primitive restart index, so it can only be addressed with 32-bit indices
+    REQUIRE(GetIndexType({ 0U, 65535U }) == VK_INDEX_TYPE_UINT32);
+    REQUIRE(GetIndexType({ 100000U }) == VK_INDEX_TYPE_UINT32);
+}
+
+TEST_CASE("Vertex Packing", "[RenderCore]")
+{
+    constexpr float Tolerance { 1.F / 512.F };
+
+    auto const DecodeOctahedral = [](glm::vec2 const &Encoded)
+    {
+        glm::vec3 Output { Encoded, 1.F - std::abs(Encoded.x) - std::abs(Encoded.y) };
+        if (Output.z < 0.F)
+        {
+            glm::vec2 const Sign { Output.x >= 0.F ? 1.F : -1.F, Output.y >= 0.F ? 1.F : -1.F };
+            Output.x = (1.F - std::abs(Encoded.y)) * Sign.x;
+            Output.y = (1.F - std::abs(Encoded.x)) * Sign.y;
+        }
+
+        return glm::normalize(Output);
+    };
+
+    SECTION("Octahedral Encoding")
+    {
+        REQUIRE(RenderCore::EncodeOctahedral(glm::vec3 { 0.F, 0.F, 1.F }) == glm::vec2 { 0.F, 0.F });
+        REQUIRE(RenderCore::EncodeOctahedral(glm::vec3 { 1.F, 0.F, 0.F }) == glm::vec2 { 1.F, 0.F });
+        REQUIRE(RenderCore::EncodeOctahedral(glm::vec3 { 0.F, -1.F, 0.F }) == glm::vec2 { 0.F, -1.F });
+        REQUIRE(RenderCore::EncodeOctahedral(glm::vec3 { 0.F, 0.F, -1.F }) == glm::vec2 { 1.F, 1.F });
+
+        // Degenerate normals are encoded as +Z instead of producing NaNs
+        REQUIRE(RenderCore::EncodeOctahedral(glm::vec3 { 0.F }) == glm::vec2 { 0.F, 0.F });
+
+        for (glm::vec3 const &DirectionIter : { glm::vec3 { 1.F, 2.F, 3.F }, glm::vec3 { -0.5F, 0.25F, -1.F }, glm::vec3 { 0.3F, -0.7F, -0.2F } })
+        {
+            glm::vec3 const Direction = glm::normalize(DirectionIter);
+            REQUIRE(glm::all(glm::epsilonEqual(DecodeOctahedral(RenderCore::EncodeOctahedral(Direction)), Direction, Tolerance)));
+        }
+    }
+
+    SECTION("Packed Layout")
+    {
+        STATIC_REQUIRE(sizeof(RenderCore::PackedVertex) == 32U);
+
+        RenderCore::Vertex const Source {
+                .Position = glm::vec3 { 1.F, -2.F, 3.5F },
+                .Normal = glm::normalize(glm::vec3 { 0.F, 1.F, -1.F }),
+                .TextureCoordinate = glm::vec2 { 0.25F, 2.5F },
+                .Color = glm::vec4 { 1.F, 0.5F, 0.F, 1.F },
+                .Tangent = glm::vec4 { 1.F, 0.F, 0.F, -1.F }
+        };
+
+        RenderCore::PackedVertex const Packed = RenderCore::PackVertex(Source);
+
+        REQUIRE(Packed.Position == Source.Position);
+        REQUIRE(glm::all(glm::epsilonEqual(DecodeOctahedral(glm::unpackSnorm2x16(Packed.Normal)), Source.Normal, Tolerance)));
+        REQUIRE(glm::all(glm::epsilonEqual(DecodeOctahedral(glm::unpackSnorm2x16(Packed.Tangent.x)), glm::vec3 { Source.Tangent }, Tolerance)));
+        REQUIRE(glm::unpackSnorm2x16(Packed.Tangent.y) == glm::vec2 { -1.F, 0.F });
+        REQUIRE(glm::unpackHalf2x16(Packed.TextureCoordinate) == Source.TextureCoordinate);
+        REQUIRE(glm::all(glm::epsilonEqual(glm::unpackUnorm4x8(Packed.Color), Source.Color, 1.F / 255.F)));
+    }
+}
+
+TEST_CASE("Mesh Cache", "[RenderCore]")
+{
+    std::filesystem::path const ModelPath  = std::filesystem::temp_directory_path() / "RenderCoreUnit_MeshCache.gltf";
+    std::filesystem::path const BufferPath = std::filesystem::temp_directory_path() / "RenderCoreUnit_MeshCache.bin";
+    std::filesystem::path const CachePath  = ModelPath.string() + ".rcmesh";
+
+    std::vector<glm::vec3> const     Positions { glm::vec3 { 0.F, 0.F, 0.F }, glm::vec3 { 1.F, 0.F, 0.F }, glm::vec3 { 0.F, 1.F, 0.F } };
+    std::vector<std::uint16_t> const Indices { 0U, 1U, 2U, 0U };
+
+    auto const WriteBuffer = [&]
+    {
+        std::ofstream Stream(BufferPath, std::ios::binary | std::ios::trunc);
+        Stream.write(reinterpret_cast<char const *>(std::data(Positions)), static_cast<std::streamsize>(std::size(Positions) * sizeof(glm::vec3)));
+        Stream.write(reinterpret_cast<char const *>(std::data(Indices)), static_cast<std::streamsize>(std::size(Indices) * sizeof(std::uint16_t)));
+    };
+
+    WriteBuffer();
+
+    std::ofstream(ModelPath, std::ios::trunc) << std::format(R"({{
+        "asset": {{ "version": "2.0" }},
+        "buffers": [ {{ "uri": "{}", "byteLength": 44 }} ],
+        "bufferViews": [ {{ "buffer": 0, "byteOffset": 0, "byteLength": 36 }}, {{ "buffer": 0, "byteOffset": 36, "byteLength": 6 }} ],
+        "accessors": [
+            {{ "bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3", "min": [ 0, 0, 0 ], "max": [ 1, 1, 0 ] }},
+            {{ "bufferView": 1, "componentType": 5123, "count": 3, "type": "SCALAR" }}
+        ],
+        "materials": [ {{}} ],
+        "meshes": [ {{ "name": "Triangle", "primitives": [ {{ "attributes": {{ "POSITION": 0 }}, "indices": 1, "material": 0 }} ] }} ],
+        "nodes": [ {{ "mesh": 0 }} ],
+        "scenes": [ {{ "nodes": [ 0 ] }} ],
+        "scene": 0
+    }})",
+                                                             BufferPath.filename().string());
+
+    std::filesystem::remove(CachePath);
+
+    ScopedTestWindow Window;
+
+    auto const LoadModel = [&ModelPath, &Window]
+    {
+        RenderCore::Renderer::RequestClearScene();
+        Window.PollLoop([]
+        {
+            return RenderCore::Renderer::GetNumObjects() > 0U;
+        });
+
+        auto const LoadResult = RenderCore::Renderer::RequestLoadObject(ModelPath.string());
+        Window.PollLoop([&LoadResult]
+        {
+            return LoadResult.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+        });
+
+        std::vector<std::uint32_t> const &LoadedIDs = LoadResult.get();
+        REQUIRE(std::size(LoadedIDs) == 1U);
+
+        return RenderCore::Renderer::GetObjectByID(LoadedIDs.front())->GetMesh();
+    };
+
+    // A load that misses the cache bakes it again, replacing the file through a rename
+    auto const FirstMesh      = LoadModel();
+    auto const FirstCacheTime = std::filesystem::last_write_time(CachePath);
+    REQUIRE(std::filesystem::exists(CachePath));
+
+    SECTION("Round Trip")
+    {
+        auto const CachedMesh = LoadModel();
+        REQUIRE(std::filesystem::last_write_time(CachePath) == FirstCacheTime);
+        REQUIRE(CachedMesh->GetNumTriangles() == FirstMesh->GetNumTriangles());
+        REQUIRE(CachedMesh->GetIndexType() == FirstMesh->GetIndexType());
+        REQUIRE(CachedMesh->GetNumLODs() == FirstMesh->GetNumLODs());
+        REQUIRE(CachedMesh->GetBounds().Min == FirstMesh->GetBounds().Min);
+        REQUIRE(CachedMesh->GetBounds().Max == FirstMesh->GetBounds().Max);
+    }
+
+    SECTION("Truncated File")
+    {
+        std::uintmax_t const CacheSize = std::filesystem::file_size(CachePath);
+        std::filesystem::resize_file(CachePath, CacheSize / 2U);
+
+        REQUIRE(LoadModel()->GetNumTriangles() == FirstMesh->GetNumTriangles());
+        REQUIRE(std::filesystem::file_size(CachePath) == CacheSize);
+    }
+
+    SECTION("Modified Source")
+    {
+        std::ofstream(ModelPath, std::ios::app) << " ";
+
+        REQUIRE(LoadModel()->GetNumTriangles() == FirstMesh->GetNumTriangles());
+        REQUIRE(std::filesystem::last_write_time(CachePath) != FirstCacheTime);
+    }
+
+    SECTION("Modified Buffer")
+    {
+        std::filesystem::last_write_time(BufferPath, std::filesystem::last_write_time(BufferPath) + std::chrono::hours { 1 });
+
+        REQUIRE(LoadModel()->GetNumTriangles() == FirstMesh->GetNumTriangles());
+        REQUIRE(std::filesystem::last_write_time(CachePath) != FirstCacheTime);
+    }
+
+    std::filesystem::remove(CachePath);
+    std::filesystem::remove(ModelPath);
+    std::filesystem::remove(BufferPath);
+}
+
+TEST_CASE("GLB Header Validation", "[RenderCore]")
+{
+    std::filesystem::path const FilePath = std::filesystem::temp_directory_path() / "RenderCoreUnit_Header.glb";
+
+    // Header, JSON chunk padded to 4 bytes with spaces and a 4 bytes BIN chunk
+    std::string const          JSON { R"({"asset":{"version":"2.0"}} )" };
+    constexpr std::uint32_t    BinaryLength { 4U };
+    std::vector<unsigned char> Valid(12U + 8U + std::size(JSON) + 8U + BinaryLength, 0U);
+    std::uint32_t const        ValidLength = static_cast<std::uint32_t>(std::size(Valid));
+    std::uint32_t const        JSONLength  = static_cast<std::uint32_t>(std::size(JSON));
+
+    auto const SetWord = [](std::vector<unsigned char> &Data, std::size_t const Offset, std::uint32_t const Value)
+    {
+        std::memcpy(std::data(Data) + Offset, &Value, sizeof(Value));
+    };
+
+    SetWord(Valid, 0U, 0x46546C67U);
+    SetWord(Valid, 4U, 2U);
+    SetWord(Valid, 8U, ValidLength);
+    SetWord(Valid, 12U, JSONLength);
+    SetWord(Valid, 16U, 0x4E4F534AU);
+    std::memcpy(std::data(Valid) + 20U, std::data(JSON), JSONLength);
+    SetWord(Valid, 20U + JSONLength, BinaryLength);
+    SetWord(Valid, 24U + JSONLength, 0x004E4942U);
+
+    ScopedTestWindow Window;
+
+    // Files without any mesh are still loaded, so only a rejected header makes the load fail
+    auto const LoadFile = [&FilePath, &Window](std::vector<unsigned char> const &Data, std::string &Error)
+    {
+        std::ofstream(FilePath, std::ios::binary | std::ios::trunc).write(reinterpret_cast<char const *>(std::data(Data)),
+                                                                          static_cast<std::streamsize>(std::size(Data)));
+
+        auto const Batch = RenderCore::Renderer::RequestLoadObjects({ FilePath.string() });
+        Window.PollLoop([&Batch]
+        {
+            return !Batch->IsComplete();
+        });
+
+        RenderCore::ObjectLoadResult const Result = Batch->GetResults().front();
+        Error                                     = Result.Error;
+
+        return Result.Status == RenderCore::ObjectLoadStatus::Loaded;
+    };
+
+    std::string Error {};
+
+    SECTION("Valid")
+    {
+        REQUIRE(LoadFile(Valid, Error));
+        REQUIRE(std::empty(Error));
+    }
+
+    SECTION("Wrong Magic")
+    {
+        std::vector<unsigned char> Data = Valid;
+        SetWord(Data, 0U, 0x12345678U);
+
+        REQUIRE_FALSE(LoadFile(Data, Error));
+        REQUIRE_FALSE(std::empty(Error));
+    }
+
+    SECTION("Wrong Version")
+    {
+        std::vector<unsigned char> Data = Valid;
+        SetWord(Data, 4U, 1U);
+
+        REQUIRE_FALSE(LoadFile(Data, Error));
+        REQUIRE_FALSE(std::empty(Error));
+    }
+
+    SECTION("Length Past End Of File")
+    {
+        std::vector<unsigned char> Data = Valid;
+        SetWord(Data, 8U, ValidLength + 1U);
+
+        REQUIRE_FALSE(LoadFile(Data, Error));
+        REQUIRE_FALSE(std::empty(Error));
+    }
+
+    SECTION("JSON Chunk Past Length")
+    {
+        std::vector<unsigned char> Data = Valid;
+        SetWord(Data, 12U, ValidLength);
+
+        REQUIRE_FALSE(LoadFile(Data, Error));
+        REQUIRE_FALSE(std::empty(Error));
+    }
+
+    SECTION("File Too Small")
+    {
+        std::vector<unsigned char> const Data(std::begin(Valid), std::begin(Valid) + 16U);
+
+        REQUIRE_FALSE(LoadFile(Data, Error));
+        REQUIRE_FALSE(std::empty(Error));
+    }
+
+    std::filesystem::remove(FilePath);
+}
+
+TEST_CASE("Meshopt Decoding", "[RenderCore]")
+{
+    std::filesystem::path const ModelPath  = std::filesystem::temp_directory_path() / "RenderCoreUnit_Meshopt.gltf";
+    std::filesystem::path const BufferPath = std::filesystem::temp_directory_path() / "RenderCoreUnit_Meshopt.bin";
+
+    std::vector<glm::vec3> Positions(16U);
+    for (std::size_t PositionIter = 0U; PositionIter < std::size(Positions); ++PositionIter)
+    {
+        Positions.at(PositionIter) = glm::vec3 { static_cast<float>(PositionIter), static_cast<float>(PositionIter % 4U), -1.F };
+    }
+
+    std::vector<unsigned char> Encoded(meshopt_encodeVertexBufferBound(std::size(Positions), sizeof(glm::vec3)));
+    Encoded.resize(meshopt_encodeVertexBuffer(std::data(Encoded), std::size(Encoded), std::data(Positions), std::size(Positions), sizeof(glm::vec3)));
+    REQUIRE_FALSE(std::empty(Encoded));
+
+    // The external buffer holds the compressed positions followed by plain 16-bit indices, the positions decode into a fallback buffer
+    std::vector<std::uint16_t> Indices(15U);
+    std::iota(std::begin(Indices), std::end(Indices), std::uint16_t { 0U });
+
+    std::size_t const IndexOffset = (std::size(Encoded) + 3U) & ~std::size_t { 3U };
+    {
+        std::vector<unsigned char> Buffer(IndexOffset + std::size(Indices) * sizeof(std::uint16_t), 0U);
+        std::memcpy(std::data(Buffer), std::data(Encoded), std::size(Encoded));
+        std::memcpy(std::data(Buffer) + IndexOffset, std::data(Indices), std::size(Indices) * sizeof(std::uint16_t));
+
+        std::ofstream(BufferPath, std::ios::binary | std::ios::trunc).write(reinterpret_cast<char const *>(std::data(Buffer)),
+                                                                            static_cast<std::streamsize>(std::size(Buffer)));
+    }
+
+    ScopedTestWindow Window;
+
+    auto const LoadModel = [&](std::size_t const Stride, std::string_view const Mode, std::size_t const SourceLength, std::string &Error)
+    {
+        std::ofstream(ModelPath, std::ios::trunc) << std::format(R"({{
+            "asset": {{ "version": "2.0" }},
+            "extensionsUsed": [ "EXT_meshopt_compression" ],
+            "extensionsRequired": [ "EXT_meshopt_compression" ],
+            "buffers": [
+                {{ "uri": "{}", "byteLength": {} }},
+                {{ "byteLength": {}, "extensions": {{ "EXT_meshopt_compression": {{ "fallback": true }} }} }}
+            ],
+            "bufferViews": [
+                {{ "buffer": 1, "byteLength": {}, "byteStride": 12,
+                   "extensions": {{ "EXT_meshopt_compression": {{ "buffer": 0, "byteOffset": 0, "byteLength": {}, "byteStride": {}, "count": {}, "mode": "{}" }} }} }},
+                {{ "buffer": 0, "byteOffset": {}, "byteLength": {} }}
+            ],
+            "accessors": [
+                {{ "bufferView": 0, "componentType": 5126, "count": {}, "type": "VEC3", "min": [ 0, 0, -1 ], "max": [ 15, 3, -1 ] }},
+                {{ "bufferView": 1, "componentType": 5123, "count": {}, "type": "SCALAR" }}
+            ],
+            "materials": [ {{}} ],
+            "meshes": [ {{ "primitives": [ {{ "attributes": {{ "POSITION": 0 }}, "indices": 1, "material": 0 }} ] }} ],
+            "nodes": [ {{ "mesh": 0 }} ],
+            "scenes": [ {{ "nodes": [ 0 ] }} ],
+            "scene": 0
+        }})",
+                                                                 BufferPath.filename().string(),
+                                                                 std::filesystem::file_size(BufferPath),
+                                                                 std::size(Positions) * sizeof(glm::vec3),
+                                                                 std::size(Positions) * sizeof(glm::vec3),
+                                                                 SourceLength,
+                                                                 Stride,
+                                                                 std::size(Positions),
+                                                                 Mode,
+                                                                 IndexOffset,
+                                                                 std::size(Indices) * sizeof(std::uint16_t),
+                                                                 std::size(Positions),
+                                                                 std::size(Indices));
+
+        // A cache left by another section would skip the decoding being tested
+        std::filesystem::remove(ModelPath.string() + ".rcmesh");
+
+        auto const Batch = RenderCore::Renderer::RequestLoadObjects({ ModelPath.string() });
+        Window.PollLoop([&Batch]
+        {
+            return !Batch->IsComplete();
+        });
+
+        RenderCore::ObjectLoadResult const Result = Batch->GetResults().front();
+        Error                                     = Result.Error;
+
+        return Result;
+    };
+
+    std::string Error {};
+
+    SECTION("Attributes")
+    {
+        RenderCore::ObjectLoadResult const Result = LoadModel(sizeof(glm::vec3), "ATTRIBUTES", std::size(Encoded), Error);
+        REQUIRE(Result.Status == RenderCore::ObjectLoadStatus::Loaded);
+        REQUIRE(std::size(Result.ObjectIDs) == 1U);
+
+        // Bounds are gathered from the decoded positions while they are converted
+        auto const &MeshBounds = RenderCore::Renderer::GetObjectByID(Result.ObjectIDs.front())->GetMesh()->GetBounds();
+        REQUIRE(MeshBounds.Min == glm::vec3 { 0.F, 0.F, -1.F });
+        REQUIRE(MeshBounds.Max.x == 15.F);
+        REQUIRE(MeshBounds.Max.y == 3.F);
+    }
+
+    SECTION("Invalid Stride")
+    {
+        REQUIRE(LoadModel(6U, "ATTRIBUTES", std::size(Encoded), Error).Status == RenderCore::ObjectLoadStatus::Failed);
+        REQUIRE_FALSE(std::empty(Error));
+    }
+
+    SECTION("Invalid Mode")
+    {
+        REQUIRE(LoadModel(sizeof(glm::vec3), "FOO", std::size(Encoded), Error).Status == RenderCore::ObjectLoadStatus::Failed);
+        REQUIRE_FALSE(std::empty(Error));
+    }
+
+    SECTION("Source Past Buffer")
+    {
+        REQUIRE(LoadModel(sizeof(glm::vec3), "ATTRIBUTES", std::size(Encoded) + 1U, Error).Status == RenderCore::ObjectLoadStatus::Failed);
+        REQUIRE_FALSE(std::empty(Error));
+    }
+
+    std::filesystem::remove(ModelPath.string() + ".rcmesh");
+    std::filesystem::remove(ModelPath);
+    std::filesystem::remove(BufferPath);
+}
+
+TEST_CASE("World Manifest", "[RenderCore]")
+{
+    std::filesystem::path const ManifestPath = std::filesystem::temp_directory_path() / "RenderCoreUnit_World.json";
+
+    auto const OpenManifest = [&ManifestPath](std::string_view const Manifest)
+    {
+        std::ofstream(ManifestPath, std::ios::trunc) << Manifest;
+        return RenderCore::Renderer::RequestOpenWorld(ManifestPath.string());
+    };
+
+    SECTION("Valid And Invalid Cells")
+    {
+        // Only the first cell is well formed, the others are skipped without failing the whole manifest
+        REQUIRE(OpenManifest(R"({
+            "loadRadius": 64,
+            "cells": [
+                { "file": "Cells/0_0.glb", "min": [0, 0, 0], "max": [64, 16, 64] },
+                { "file": 42, "min": [0, 0, 0], "max": [64, 16, 64] },
+                { "file": "Cells/0_1.glb", "min": [0, 0], "max": [64, 16, 64] },
+                { "file": "Cells/1_0.glb", "min": [0, "0", 0], "max": [64, 16, 64] },
+                { "file": "Cells/1_1.glb", "min": [0, 0, 0] },
+                "Cells/2_2.glb"
+            ]
+        })"));
+
+        // Cells are only loaded by the renderer once it streams around the camera
+        REQUIRE(RenderCore::Renderer::GetNumResidentWorldCells() == 0U);
+
+        // Worlds must be closed before another one is opened
+        REQUIRE_FALSE(OpenManifest(R"({ "cells": [ { "file": "Cells/0_0.glb", "min": [0, 0, 0], "max": [64, 16, 64] } ] })"));
+
+        RenderCore::Renderer::RequestCloseWorld();
+
+        REQUIRE(OpenManifest(R"({ "cells": [ { "file": "Cells/0_0.glb", "min": [0, 0, 0], "max": [64, 16, 64] } ] })"));
+        RenderCore::Renderer::RequestCloseWorld();
+    }
+
+    SECTION("Invalid Manifest")
+    {
+        REQUIRE_FALSE(OpenManifest(R"({ "cells": [ )"));
+        REQUIRE_FALSE(OpenManifest(R"({ "cells": {} })"));
+        REQUIRE_FALSE(OpenManifest(R"([])"));
+
+        // Manifests whose cells are all malformed have nothing to stream
+        REQUIRE_FALSE(OpenManifest(R"({ "cells": [] })"));
+        REQUIRE_FALSE(OpenManifest(R"({ "cells": [ { "file": 42, "min": [0, 0, 0], "max": [64, 16, 64] } ] })"));
+
+        // None of the rejected manifests left a world open
+        REQUIRE(OpenManifest(R"({ "cells": [ { "file": "Cells/0_0.glb", "min": [0, 0, 0], "max": [64, 16, 64] } ] })"));
+        RenderCore::Renderer::RequestCloseWorld();
+    }
+
+    std::filesystem::remove(ManifestPath);
+}
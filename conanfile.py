@@ -24,6 +24,15 @@ class VulkanRendererRecipe(ConanFile):
         # https://conan.io/center/recipes/tinygltf
         self.requires("tinygltf/2.8.19")
 
+        # https://conan.io/center/recipes/nlohmann_json
+        self.requires("nlohmann_json/3.11.3")
+
+        # https://conan.io/center/recipes/meshoptimizer
+        self.requires("meshoptimizer/0.20")
+
+        # https://conan.io/center/recipes/ktx
+        self.requires("ktx/4.3.2")
+
         # https://conan.io/center/recipes/benchmark
         self.requires("benchmark/1.8.3")
 